@@ -0,0 +1,343 @@
+#include "Krylov.h"
+
+#include "err.h"
+#include "my_lapack.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace my_lapack {
+
+    LinearOperator denseOperator( int n, const double *a, int lda )
+    {
+        LAHPC_CHECK_POSITIVE( n );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, n ) );
+
+        return [n, a, lda]( const double *x, double *y ) {
+            my_dgemv( CblasColMajor, CblasNoTrans, n, n, 1., a, lda, x, 1, 0., y, 1 );
+        };
+    }
+
+    LinearOperator sparseOperator( const SparseMat &A )
+    {
+        LAHPC_CHECK_PREDICATE( A.dimX() == A.dimY() );
+
+        return [&A]( const double *x, double *y ) { A.spmv( CblasNoTrans, 1., x, 0., y ); };
+    }
+
+    BlockJacobi::BlockJacobi( int n, const double *a, int lda, int blockSize, Factorization factorization )
+        : n( n )
+        , blockSize( blockSize )
+        , factorization( factorization )
+        , info_( 0 )
+    {
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, n ) );
+        allocate();
+
+        for ( int b = 0; b * blockSize < n; ++b ) {
+            int           size = std::min( blockSize, n - b * blockSize );
+            const double *diag = a + static_cast<std::size_t>( b ) * blockSize * lda + b * blockSize;
+            my_dlacpy( size, size, diag, lda, block( b ), size );
+        }
+        factorize();
+    }
+
+    BlockJacobi::BlockJacobi( const SparseMat &A, int blockSize, Factorization factorization )
+        : n( A.dimX() )
+        , blockSize( blockSize )
+        , factorization( factorization )
+        , info_( 0 )
+    {
+        LAHPC_CHECK_PREDICATE( A.dimX() == A.dimY() );
+        allocate();
+
+        // Only the entries whose row and column fall in the same block are kept
+        const int *ptr = A.ptr(), *indices = A.indices();
+        for ( int i = 0; i < n; ++i ) {
+            for ( int k = ptr[i]; k < ptr[i + 1]; ++k ) {
+                int row = ( A.format() == SparseMat::CSR ) ? i : indices[k];
+                int col = ( A.format() == SparseMat::CSR ) ? indices[k] : i;
+                int b   = row / blockSize;
+                if ( col / blockSize != b ) { continue; }
+
+                int size = std::min( blockSize, n - b * blockSize );
+                block( b )[( col - b * blockSize ) * size + row - b * blockSize] += A.values()[k];
+            }
+        }
+        factorize();
+    }
+
+    void BlockJacobi::allocate()
+    {
+        LAHPC_CHECK_POSITIVE_STRICT( n );
+        LAHPC_CHECK_POSITIVE_STRICT( blockSize );
+
+        blockSize = std::min( blockSize, n );
+        nbFull    = n / blockSize;
+        blocks.assign( static_cast<std::size_t>( nbFull ) * blockSize * blockSize +
+                           static_cast<std::size_t>( tailSize() ) * tailSize(),
+                       0. );
+        if ( factorization == LU ) { ipiv.resize( n ); }
+    }
+
+    // The full blocks share their size, so that the batched kernels factorize them all in one call
+    void BlockJacobi::factorize()
+    {
+        int tail = tailSize();
+
+        if ( factorization == LU ) {
+            std::vector<double *> A( nbFull );
+            std::vector<int *>    piv( nbFull );
+            std::vector<int>      info( nbFull );
+            for ( int b = 0; b < nbFull; ++b ) {
+                A[b]   = block( b );
+                piv[b] = ipiv.data() + b * blockSize;
+            }
+            my_dgetrf_batch( CblasColMajor, blockSize, A.data(), blockSize, piv.data(), info.data(), nbFull );
+            for ( int b = 0; b < nbFull && info_ == 0; ++b ) {
+                info_ = info[b];
+            }
+            if ( tail > 0 ) {
+                int tailInfo =
+                    my_dgetrf_piv( CblasColMajor, tail, tail, block( nbFull ), tail, ipiv.data() + nbFull * blockSize );
+                if ( info_ == 0 ) { info_ = tailInfo; }
+            }
+        }
+        else {
+            for ( int b = 0; b * blockSize < n; ++b ) {
+                int size = std::min( blockSize, n - b * blockSize );
+                int info = my_dpotrf( CblasColMajor, size, block( b ), size );
+                if ( info_ == 0 ) { info_ = info; }
+            }
+        }
+    }
+
+    void BlockJacobi::apply( const double *r, double *z ) const
+    {
+        if ( z != r ) { std::copy( r, r + n, z ); }
+        int tail = tailSize();
+
+        if ( factorization == LU ) {
+            std::vector<const double *> A( nbFull );
+            std::vector<const int *>    piv( nbFull );
+            std::vector<double *>       B( nbFull );
+            for ( int b = 0; b < nbFull; ++b ) {
+                A[b]   = block( b );
+                piv[b] = ipiv.data() + b * blockSize;
+                B[b]   = z + b * blockSize;
+            }
+            my_dgetrs_batch(
+                CblasColMajor, blockSize, 1, A.data(), blockSize, piv.data(), B.data(), blockSize, nbFull );
+            if ( tail > 0 ) {
+                my_dgetrs( CblasColMajor,
+                           tail,
+                           1,
+                           block( nbFull ),
+                           tail,
+                           ipiv.data() + nbFull * blockSize,
+                           z + nbFull * blockSize,
+                           tail );
+            }
+        }
+        else {
+            for ( int b = 0; b * blockSize < n; ++b ) {
+                int size = std::min( blockSize, n - b * blockSize );
+                my_dpotrs( CblasColMajor, size, 1, block( b ), size, z + b * blockSize, size );
+            }
+        }
+    }
+
+    static inline double norm2( int n, const double *x ) { return std::sqrt( my_ddot( n, x, 1, x, 1 ) ); }
+
+    // || b - A * x || / || b ||, w being a work vector
+    static double relativeResidual(
+        int n, const LinearOperator &A, const double *b, const double *x, double *w, double bnorm )
+    {
+        A( x, w );
+        my_daxpby( n, 1., b, 1, -1., w, 1 );
+        return norm2( n, w ) / bnorm;
+    }
+
+    KrylovResult conjugateGradient(
+        int n, const LinearOperator &A, const double *b, double *x, const BlockJacobi *M, double tol, int maxIter )
+    {
+        LAHPC_CHECK_POSITIVE_STRICT( n );
+        LAHPC_CHECK_POSITIVE( maxIter );
+        LAHPC_CHECK_PREDICATE( M == nullptr || M->dim() == n );
+
+        KrylovResult result = { true, 0, 0., {} };
+        double       bnorm  = norm2( n, b );
+        if ( bnorm == 0. ) {
+            std::fill( x, x + n, 0. );
+            return result;
+        }
+
+        std::vector<double> r( n ), p( n ), q( n ), z( M ? n : 0 );
+        result.residual = relativeResidual( n, A, b, x, r.data(), bnorm );
+        result.history.push_back( result.residual );
+
+        // The recurrence on r drifts away from b - A * x, so convergence is confirmed on the true residual, from
+        // which the iteration restarts as long as it keeps improving
+        while ( result.residual > tol && result.iterations < maxIter ) {
+            // Without preconditioner z is r, and the updates of r and of its norm fuse in my_daxpy_dot
+            double rr, rz;
+            if ( M ) {
+                M->apply( r.data(), z.data() );
+                my_ddot2( n, r.data(), 1, z.data(), 1, &rz, &rr );
+            }
+            else {
+                rr = rz = my_ddot( n, r.data(), 1, r.data(), 1 );
+            }
+            std::copy( M ? z.begin() : r.begin(), M ? z.end() : r.end(), p.begin() );
+
+            bool breakdown = false;
+            while ( result.iterations < maxIter && std::sqrt( rr ) > tol * bnorm ) {
+                A( p.data(), q.data() );
+                double pq = my_ddot( n, p.data(), 1, q.data(), 1 );
+                if ( !( pq > 0. ) ) {
+                    breakdown = true;
+                    break;
+                }
+
+                double alpha = rz / pq;
+                my_daxpy( n, alpha, p.data(), 1, x, 1 );
+                double rzNew;
+                if ( M ) {
+                    my_daxpy( n, -alpha, q.data(), 1, r.data(), 1 );
+                    M->apply( r.data(), z.data() );
+                    my_ddot2( n, r.data(), 1, z.data(), 1, &rzNew, &rr );
+                }
+                else {
+                    rr = rzNew = my_daxpy_dot( n, -alpha, q.data(), 1, r.data(), 1, r.data(), 1 );
+                }
+                my_daxpby( n, 1., M ? z.data() : r.data(), 1, rzNew / rz, p.data(), 1 );
+                rz = rzNew;
+
+                ++result.iterations;
+                result.history.push_back( std::sqrt( rr ) / bnorm );
+            }
+
+            double previous = result.residual;
+            result.residual = relativeResidual( n, A, b, x, r.data(), bnorm );
+            if ( breakdown || result.residual >= previous ) { break; }
+        }
+
+        result.converged = result.residual <= tol;
+        return result;
+    }
+
+    KrylovResult gmres( int                   n,
+                        const LinearOperator &A,
+                        const double *        b,
+                        double *              x,
+                        const BlockJacobi *   M,
+                        double                tol,
+                        int                   maxIter,
+                        int                   restart )
+    {
+        LAHPC_CHECK_POSITIVE_STRICT( n );
+        LAHPC_CHECK_POSITIVE( maxIter );
+        LAHPC_CHECK_POSITIVE_STRICT( restart );
+        LAHPC_CHECK_PREDICATE( M == nullptr || M->dim() == n );
+
+        KrylovResult result = { false, 0, 0., {} };
+        double       bnorm  = norm2( n, b );
+        if ( bnorm == 0. ) {
+            std::fill( x, x + n, 0. );
+            result.converged = true;
+            return result;
+        }
+
+        // Arnoldi basis V, Hessenberg matrix H reduced to triangular by the Givens rotations ( cs, sn ), and g the
+        // rotated right-hand side whose last entry is the residual norm
+        int                 m   = std::min( restart, n );
+        int                 ldh = m + 1;
+        std::vector<double> V( static_cast<std::size_t>( n ) * ( m + 1 ) ), H( static_cast<std::size_t>( ldh ) * m );
+        std::vector<double> cs( m ), sn( m ), g( m + 1 ), c( m ), w( n ), u( n );
+
+        // Each cycle starts from the true residual, which is the one convergence is checked on
+        while ( true ) {
+            double *v0 = V.data();
+            A( x, w.data() );
+            std::copy( b, b + n, v0 );
+            my_daxpy( n, -1., w.data(), 1, v0, 1 );
+            double beta     = norm2( n, v0 );
+            result.residual = beta / bnorm;
+            if ( result.history.empty() ) { result.history.push_back( result.residual ); }
+            if ( beta <= tol * bnorm ) {
+                result.converged = true;
+                break;
+            }
+            if ( result.iterations >= maxIter ) { break; }
+
+            my_dscal( n, 1. / beta, v0, 1 );
+            std::fill( g.begin(), g.end(), 0. );
+            g[0] = beta;
+
+            int k = 0;
+            while ( k < m && result.iterations < maxIter ) {
+                int     j  = k;
+                double *h  = H.data() + static_cast<std::size_t>( j ) * ldh;
+                double *vj = V.data() + static_cast<std::size_t>( j ) * n;
+
+                if ( M ) {
+                    M->apply( vj, u.data() );
+                    A( u.data(), w.data() );
+                }
+                else {
+                    A( vj, w.data() );
+                }
+
+                // Classical Gram-Schmidt applied twice, as two matrix-vector products with V each time
+                my_dgemv( CblasColMajor, CblasTrans, n, j + 1, 1., V.data(), n, w.data(), 1, 0., h, 1 );
+                my_dgemv( CblasColMajor, CblasNoTrans, n, j + 1, -1., V.data(), n, h, 1, 1., w.data(), 1 );
+                my_dgemv( CblasColMajor, CblasTrans, n, j + 1, 1., V.data(), n, w.data(), 1, 0., c.data(), 1 );
+                my_dgemv( CblasColMajor, CblasNoTrans, n, j + 1, -1., V.data(), n, c.data(), 1, 1., w.data(), 1 );
+                for ( int i = 0; i <= j; ++i ) {
+                    h[i] += c[i];
+                }
+                double hnorm = norm2( n, w.data() );
+                h[j + 1]     = hnorm;
+
+                for ( int i = 0; i < j; ++i ) {
+                    double tmp = cs[i] * h[i] + sn[i] * h[i + 1];
+                    h[i + 1]   = -sn[i] * h[i] + cs[i] * h[i + 1];
+                    h[i]       = tmp;
+                }
+                double r = std::hypot( h[j], h[j + 1] );
+                cs[j]    = ( r == 0. ) ? 1. : h[j] / r;
+                sn[j]    = ( r == 0. ) ? 0. : h[j + 1] / r;
+                h[j]     = r;
+                h[j + 1] = 0.;
+                g[j + 1] = -sn[j] * g[j];
+                g[j]     = cs[j] * g[j];
+
+                ++k;
+                ++result.iterations;
+                double res = std::abs( g[j + 1] );
+                result.history.push_back( res / bnorm );
+                if ( hnorm == 0. || res <= tol * bnorm ) { break; }
+
+                double *vNext = V.data() + static_cast<std::size_t>( j + 1 ) * n;
+                std::copy( w.begin(), w.end(), vNext );
+                my_dscal( n, 1. / hnorm, vNext, 1 );
+            }
+
+            // x = x + M^-1 * V * y, y solving the leading k x k triangle of H against g
+            for ( int i = k - 1; i >= 0; --i ) {
+                double s = g[i];
+                for ( int l = i + 1; l < k; ++l ) {
+                    s -= H[static_cast<std::size_t>( l ) * ldh + i] * c[l];
+                }
+                double diag = H[static_cast<std::size_t>( i ) * ldh + i];
+                c[i]        = ( diag != 0. ) ? s / diag : 0.;
+            }
+            my_dgemv( CblasColMajor, CblasNoTrans, n, k, 1., V.data(), n, c.data(), 1, 0., u.data(), 1 );
+            if ( M ) { M->apply( u.data(), u.data() ); }
+            my_daxpy( n, 1., u.data(), 1, x, 1 );
+        }
+
+        return result;
+    }
+
+} // namespace my_lapack
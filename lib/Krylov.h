@@ -0,0 +1,83 @@
+#pragma once
+
+#include "SparseMat.h"
+
+#include <functional>
+#include <vector>
+
+namespace my_lapack {
+
+    // y = A * x for the n-by-n matrix of a system, which the iterative solvers only access through this product
+    typedef std::function<void( const double *x, double *y )> LinearOperator;
+
+    // The matrix is referenced, not copied, and must outlive the operator
+    LinearOperator denseOperator( int n, const double *a, int lda );
+    LinearOperator sparseOperator( const SparseMat &A );
+
+    // Block-Jacobi preconditioner: the diagonal blocks of A are factorized once, and applying the preconditioner
+    // solves with each of them independently. The last block is smaller when blockSize does not divide n.
+    class BlockJacobi {
+      public:
+        enum Factorization { LU, Cholesky };
+
+        BlockJacobi( int n, const double *a, int lda, int blockSize, Factorization factorization = LU );
+        BlockJacobi( const SparseMat &A, int blockSize, Factorization factorization = LU );
+
+        // z = M^-1 * r, z and r may be the same vector
+        void apply( const double *r, double *z ) const;
+
+        // 0, or the info of the factorization of the first singular, or not positive definite, block
+        inline int info() const { return info_; }
+        inline int dim() const { return n; }
+
+      private:
+        int                 n;
+        int                 blockSize;
+        int                 nbFull;
+        Factorization       factorization;
+        std::vector<double> blocks;
+        std::vector<int>    ipiv;
+        int                 info_;
+
+        inline int tailSize() const { return n - nbFull * blockSize; }
+        // Block b is stored with a leading dimension equal to its size, the tail block after the full ones
+        inline const double *block( int b ) const
+        {
+            return blocks.data() + static_cast<std::size_t>( b ) * blockSize * blockSize;
+        }
+        inline double *block( int b ) { return blocks.data() + static_cast<std::size_t>( b ) * blockSize * blockSize; }
+
+        void allocate();
+        void factorize();
+    };
+
+    struct KrylovResult {
+        bool                converged;
+        int                 iterations;
+        // True relative residual || b - A * x || / || b || of the returned x
+        double              residual;
+        // Relative residual estimated at each iteration, starting with the one of the initial guess
+        std::vector<double> history;
+    };
+
+    // Preconditioned conjugate gradient for a symmetric positive definite A, x holding the initial guess. Stops
+    // once || b - A * x || <= tol * || b ||, or if A turns out not to be positive definite.
+    KrylovResult conjugateGradient( int                   n,
+                                    const LinearOperator &A,
+                                    const double *        b,
+                                    double *              x,
+                                    const BlockJacobi *   M       = nullptr,
+                                    double                tol     = 1e-10,
+                                    int                   maxIter = 1000 );
+
+    // Right preconditioned GMRES restarted every restart iterations, maxIter counting all of them
+    KrylovResult gmres( int                   n,
+                        const LinearOperator &A,
+                        const double *        b,
+                        double *              x,
+                        const BlockJacobi *   M       = nullptr,
+                        double                tol     = 1e-10,
+                        int                   maxIter = 1000,
+                        int                   restart = 30 );
+
+} // namespace my_lapack
@@ -0,0 +1,209 @@
+#include "LUFactorization.h"
+
+#include "err.h"
+#include "my_lapack.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace my_lapack {
+
+    LUFactorization::LUFactorization( int n, const double *a, int lda )
+        : n( n )
+        , info_( 0 )
+        , rank( 0 )
+        , solvedSinceUpdate( 0 )
+    {
+        factorize( a, lda );
+    }
+
+    LUFactorization::LUFactorization( const Mat &A )
+        : n( A.dimX() )
+        , info_( 0 )
+        , rank( 0 )
+        , solvedSinceUpdate( 0 )
+    {
+        LAHPC_CHECK_PREDICATE( A.dimX() == A.dimY() );
+        factorize( A.get(), A.ld() );
+    }
+
+    void LUFactorization::factorize( const double *a, int lda )
+    {
+        LAHPC_CHECK_POSITIVE( n );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, n ) );
+
+        this->a.resize( static_cast<std::size_t>( n ) * static_cast<std::size_t>( n ) );
+        for ( int j = 0; j < n; ++j ) {
+            const double *col = a + static_cast<std::size_t>( j ) * lda;
+            std::copy( col, col + n, this->a.begin() + static_cast<std::size_t>( j ) * n );
+        }
+        refactorize();
+    }
+
+    void LUFactorization::refactorize()
+    {
+        if ( rank > 0 ) {
+            my_dgemm( CblasColMajor, CblasNoTrans, CblasTrans, n, n, rank, 1.0, u.data(), n, v.data(), n, 1.0, a.data(), n );
+        }
+        rank = 0;
+        u.clear();
+        v.clear();
+        z.clear();
+        capacitance.clear();
+        capacitancePiv.clear();
+        solvedSinceUpdate = 0;
+
+        lu = a;
+        ipiv.resize( n );
+        if ( n == 0 ) { return; }
+        info_ = my_dgetrf_piv( CblasColMajor, n, n, lu.data(), n, ipiv.data() );
+    }
+
+    // Flop counts of both ways of taking a rank k update into account. The right-hand sides that will be solved
+    // until the next update are estimated by those solved since the previous one.
+    bool LUFactorization::refactorIsCheaper( int k ) const
+    {
+        double N    = n;
+        double K    = rank + k;
+        double nrhs = std::max( 1.0, static_cast<double>( solvedSinceUpdate ) );
+
+        double woodbury = 2. * N * N * k + 2. * N * K * K + 2. / 3. * K * K * K + nrhs * ( 4. * N * K + 2. * K * K );
+        double refactor = 2. * N * N * K + 2. / 3. * N * N * N;
+
+        return refactor <= woodbury;
+    }
+
+    bool LUFactorization::update( int k, const double *U, int ldu, const double *V, int ldv )
+    {
+        LAHPC_CHECK_POSITIVE( k );
+        LAHPC_CHECK_PREDICATE( ldu >= std::max( 1, n ) );
+        LAHPC_CHECK_PREDICATE( ldv >= std::max( 1, n ) );
+
+        if ( k == 0 || n == 0 ) { return false; }
+
+        bool refactor = isSingular() || refactorIsCheaper( k );
+
+        std::size_t offset = static_cast<std::size_t>( rank ) * n;
+        u.resize( offset + static_cast<std::size_t>( k ) * n );
+        v.resize( offset + static_cast<std::size_t>( k ) * n );
+        for ( int j = 0; j < k; ++j ) {
+            std::copy( U + static_cast<std::size_t>( j ) * ldu,
+                       U + static_cast<std::size_t>( j ) * ldu + n,
+                       u.begin() + offset + static_cast<std::size_t>( j ) * n );
+            std::copy( V + static_cast<std::size_t>( j ) * ldv,
+                       V + static_cast<std::size_t>( j ) * ldv + n,
+                       v.begin() + offset + static_cast<std::size_t>( j ) * n );
+        }
+        rank += k;
+
+        if ( refactor ) {
+            refactorize();
+            return true;
+        }
+
+        // z( :, rank-k:rank ) = a^-1 * U
+        z.resize( u.size() );
+        std::copy( u.begin() + offset, u.end(), z.begin() + offset );
+        my_dgetrs( CblasColMajor, n, k, lu.data(), n, ipiv.data(), z.data() + offset, n );
+
+        // Capacitance matrix I + v^t * z, a singular one meaning that the update is better folded into A
+        capacitance.assign( static_cast<std::size_t>( rank ) * rank, 0. );
+        capacitancePiv.resize( rank );
+        for ( int i = 0; i < rank; ++i ) {
+            capacitance[static_cast<std::size_t>( i ) * rank + i] = 1.;
+        }
+        my_dgemm( CblasColMajor,
+                  CblasTrans,
+                  CblasNoTrans,
+                  rank,
+                  rank,
+                  n,
+                  1.0,
+                  v.data(),
+                  n,
+                  z.data(),
+                  n,
+                  1.0,
+                  capacitance.data(),
+                  rank );
+        if ( my_dgetrf_piv( CblasColMajor, rank, rank, capacitance.data(), rank, capacitancePiv.data() ) != 0 ) {
+            refactorize();
+            return true;
+        }
+
+        solvedSinceUpdate = 0;
+        return false;
+    }
+
+    void LUFactorization::currentColumn( int j, double *col ) const
+    {
+        std::copy( a.begin() + static_cast<std::size_t>( j ) * n, a.begin() + static_cast<std::size_t>( j + 1 ) * n, col );
+        if ( rank > 0 ) { my_dgemv( CblasColMajor, CblasNoTrans, n, rank, 1.0, u.data(), n, v.data() + j, n, 1.0, col, 1 ); }
+    }
+
+    bool LUFactorization::updateColumns( int k, const int *cols, const double *C, int ldc )
+    {
+        LAHPC_CHECK_POSITIVE( k );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, n ) );
+
+        // A( :, cols ) = C is A + ( C - A( :, cols ) ) * E^t, E gathering the unit vectors e( cols[ j ] )
+        std::vector<double> U( static_cast<std::size_t>( k ) * n ), V( static_cast<std::size_t>( k ) * n, 0. );
+        for ( int j = 0; j < k; ++j ) {
+            LAHPC_CHECK_PREDICATE( cols[j] >= 0 && cols[j] < n );
+            double *uj = U.data() + static_cast<std::size_t>( j ) * n;
+            currentColumn( cols[j], uj );
+            for ( int i = 0; i < n; ++i ) {
+                uj[i] = C[static_cast<std::size_t>( j ) * ldc + i] - uj[i];
+            }
+            V[static_cast<std::size_t>( j ) * n + cols[j]] = 1.;
+        }
+
+        return update( k, U.data(), n, V.data(), n );
+    }
+
+    bool LUFactorization::updateRows( int k, const int *rows, const double *R, int ldr )
+    {
+        LAHPC_CHECK_POSITIVE( k );
+        LAHPC_CHECK_PREDICATE( ldr >= std::max( 1, k ) );
+
+        // A( rows, : ) = R is A + E * ( R - A( rows, : ) ), E gathering the unit vectors e( rows[ i ] )
+        std::vector<double> U( static_cast<std::size_t>( k ) * n, 0. ), V( static_cast<std::size_t>( k ) * n );
+        for ( int i = 0; i < k; ++i ) {
+            LAHPC_CHECK_PREDICATE( rows[i] >= 0 && rows[i] < n );
+            double *vi = V.data() + static_cast<std::size_t>( i ) * n;
+            for ( int j = 0; j < n; ++j ) {
+                vi[j] = R[static_cast<std::size_t>( j ) * ldr + i] - a[static_cast<std::size_t>( j ) * n + rows[i]];
+            }
+            if ( rank > 0 ) {
+                my_dgemv( CblasColMajor, CblasNoTrans, n, rank, -1.0, v.data(), n, u.data() + rows[i], n, 1.0, vi, 1 );
+            }
+            U[static_cast<std::size_t>( i ) * n + rows[i]] = 1.;
+        }
+
+        return update( k, U.data(), n, V.data(), n );
+    }
+
+    void LUFactorization::solve( int nrhs, double *b, int ldb ) const
+    {
+        if ( isSingular() ) { throw std::runtime_error( "LUFactorization: the matrix is singular" ); }
+        if ( n == 0 ) { return; }
+
+        my_dgetrs( CblasColMajor, n, nrhs, lu.data(), n, ipiv.data(), b, ldb );
+
+        // ( a + u * v^t )^-1 * b = x - z * capacitance^-1 * ( v^t * x ), x = a^-1 * b
+        if ( rank > 0 && nrhs > 0 ) {
+            std::vector<double> w( static_cast<std::size_t>( rank ) * nrhs );
+            my_dgemm( CblasColMajor, CblasTrans, CblasNoTrans, rank, nrhs, n, 1.0, v.data(), n, b, ldb, 0.0, w.data(), rank );
+            my_dgetrs( CblasColMajor, rank, nrhs, capacitance.data(), rank, capacitancePiv.data(), w.data(), rank );
+            my_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, n, nrhs, rank, -1.0, z.data(), n, w.data(), rank, 1.0, b, ldb );
+        }
+        solvedSinceUpdate += nrhs;
+    }
+
+    void LUFactorization::solve( Mat &B ) const
+    {
+        LAHPC_CHECK_PREDICATE( B.dimX() == n );
+        solve( B.dimY(), B.get(), B.ld() );
+    }
+
+} // namespace my_lapack
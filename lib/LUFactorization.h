@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Mat.h"
+
+#include <atomic>
+#include <vector>
+
+namespace my_lapack {
+
+    // LU factorization with partial pivoting of a square matrix, computed once and kept with its pivots so that
+    // any number of right-hand sides batches can be solved without refactorizing.
+    //
+    // Low-rank modifications A + U * V^t of the matrix are kept as a Sherman-Morrison-Woodbury correction of the
+    // factors, which the solves apply on their own. They are folded into a new factorization only when the cost
+    // model finds it cheaper, which is why a copy of the factorized matrix is kept along with its factors.
+    //
+    // Solves may run concurrently: the count of solved right-hand sides they feed to the cost model is atomic, which
+    // also makes the factorization non-copyable. Updates must not run along with anything else.
+    class LUFactorization {
+      public:
+        LUFactorization( int n, const double *a, int lda );
+        LUFactorization( const Mat &A );
+
+        // Overwrites the n-by-nrhs matrix B with the solution of A * X = B
+        void solve( int nrhs, double *b, int ldb ) const;
+        void solve( Mat &B ) const;
+
+        // A = A + U * V^t, U and V being n-by-k. Returns true if A has been refactorized.
+        bool update( int k, const double *U, int ldu, const double *V, int ldv );
+        // Replaces the columns cols[ 0 ], ..., cols[ k-1 ] of A by the n-by-k matrix C
+        bool updateColumns( int k, const int *cols, const double *C, int ldc );
+        // Replaces the rows rows[ 0 ], ..., rows[ k-1 ] of A by the k-by-n matrix R
+        bool updateRows( int k, const int *rows, const double *R, int ldr );
+
+        inline int           dim() const { return n; }
+        inline const double *factors() const { return lu.data(); }
+        inline const int *   pivots() const { return ipiv.data(); }
+        inline int           info() const { return info_; }
+        inline bool          isSingular() const { return info_ != 0; }
+        // Rank of the pending correction, 0 when the factors are those of A itself
+        inline int correctionRank() const { return rank; }
+
+      private:
+        int                 n;
+        std::vector<double> a;
+        std::vector<double> lu;
+        std::vector<int>    ipiv;
+        int                 info_;
+
+        // A = a + u * v^t, z = a^-1 * u, and capacitance = LU factors of I + v^t * z
+        int                       rank;
+        std::vector<double>       u, v, z;
+        std::vector<double>       capacitance;
+        std::vector<int>          capacitancePiv;
+        mutable std::atomic<long> solvedSinceUpdate;
+
+        void factorize( const double *a, int lda );
+        void refactorize();
+        bool refactorIsCheaper( int k ) const;
+        void currentColumn( int j, double *col ) const;
+    };
+
+} // namespace my_lapack
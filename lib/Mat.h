@@ -16,19 +16,20 @@ namespace my_lapack {
         Mat &operator=( const Mat &other );
         bool operator==( const Mat &other );
 
-        inline double &at( int i, int j ) const { return storage[j * m + i]; };
-        inline double &at( int i ) const { return storage[i]; };
-        inline double *get() { return storage; }
-        double *       col( int j );
-        inline int     dimX() { return m; }
-        inline int     dimY() { return n; }
-        inline int     numRow() { return m; }
-        inline int     numCol() { return n; }
-        inline int     ld() { return m; }
-        void           print( int precision = 6 );
-        bool           equals( const Mat &m, double epsilon = std::numeric_limits<double>::epsilon() );
-        bool           containsOnly( const double d );
-        void           fill( double d );
+        inline double &      at( int i, int j ) const { return storage[j * m + i]; };
+        inline double &      at( int i ) const { return storage[i]; };
+        inline double *      get() { return storage; }
+        inline const double *get() const { return storage; }
+        double *             col( int j );
+        inline int           dimX() const { return m; }
+        inline int           dimY() const { return n; }
+        inline int           numRow() const { return m; }
+        inline int           numCol() const { return n; }
+        inline int           ld() const { return m; }
+        void                 print( int precision = 6 );
+        bool                 equals( const Mat &m, double epsilon = std::numeric_limits<double>::epsilon() );
+        bool                 containsOnly( const double d );
+        void                 fill( double d );
 
       private:
         double *storage;
@@ -0,0 +1,75 @@
+#include "RFPMat.h"
+
+#include "err.h"
+
+namespace my_lapack {
+
+    RFPMat::RFPMat()
+        : n( 0 )
+        , uplo_( CblasLower )
+    {
+    }
+
+    RFPMat::RFPMat( int n, CBLAS_UPLO uplo )
+        : n( n )
+        , uplo_( uplo )
+    {
+        LAHPC_CHECK_POSITIVE( n );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+
+        data_.assign( static_cast<std::size_t>( n ) * ( n + 1 ) / 2, 0. );
+    }
+
+    RFPMat RFPMat::fromDense( int n, const double *a, int lda, CBLAS_UPLO uplo )
+    {
+        RFPMat A( n, uplo );
+        my_dtrttf( CblasColMajor, uplo, n, a, lda, A.data() );
+        return A;
+    }
+
+    Mat RFPMat::toDense( bool triangular ) const
+    {
+        Mat D = MatZero( n, n );
+        if ( n == 0 ) { return D; }
+
+        my_dtfttr( CblasColMajor, uplo_, n, data(), D.get(), D.ld() );
+        if ( !triangular ) {
+            for ( int j = 0; j < n; ++j ) {
+                for ( int i = j + 1; i < n; ++i ) {
+                    if ( uplo_ == CblasLower ) { D.at( j, i ) = D.at( i, j ); }
+                    else {
+                        D.at( i, j ) = D.at( j, i );
+                    }
+                }
+            }
+        }
+        return D;
+    }
+
+    int RFPMat::cholesky() { return my_dpftrf( CblasColMajor, uplo_, n, data() ); }
+
+    void RFPMat::solve( int nrhs, double *b, int ldb ) const
+    {
+        my_dpftrs( CblasColMajor, uplo_, n, nrhs, data(), b, ldb );
+    }
+
+    void RFPMat::triangularSolve( CBLAS_SIDE      side,
+                                  CBLAS_TRANSPOSE trans,
+                                  CBLAS_DIAG      diag,
+                                  int             m,
+                                  int             n,
+                                  double          alpha,
+                                  double *        b,
+                                  int             ldb ) const
+    {
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ? m : n ) == this->n );
+
+        my_dtfsm( CblasColMajor, side, uplo_, trans, diag, m, n, alpha, data(), b, ldb );
+    }
+
+    void RFPMat::rankUpdate( CBLAS_TRANSPOSE trans, int k, double alpha, const double *c, int ldc, double beta )
+    {
+        my_dsfrk( CblasColMajor, uplo_, trans, n, k, alpha, c, ldc, beta, data() );
+    }
+
+} // namespace my_lapack
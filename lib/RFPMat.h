@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Mat.h"
+#include "my_lapack.h"
+
+#include <vector>
+
+namespace my_lapack {
+
+    // Symmetric or triangular n-by-n matrix of which only the uplo triangle is kept, in the rectangular full packed
+    // storage described in my_lapack.h: n * ( n + 1 ) / 2 doubles instead of n * n, still processed by level-3
+    // kernels on its three dense blocks
+    class RFPMat {
+      public:
+        RFPMat();
+        // Zero matrix
+        explicit RFPMat( int n, CBLAS_UPLO uplo = CblasLower );
+
+        // The uplo triangle of the dense n-by-n matrix a
+        static RFPMat fromDense( int n, const double *a, int lda, CBLAS_UPLO uplo = CblasLower );
+        // Symmetric dense copy, or only the stored triangle, the other one being zero, when triangular is set
+        Mat toDense( bool triangular = false ) const;
+
+        // Cholesky factorization in place, see my_dpftrf, returning its info
+        int cholesky();
+        // B = A^-1 * B for the n-by-nrhs B, once factorized by cholesky()
+        void solve( int nrhs, double *b, int ldb ) const;
+        // B = alpha * op( A )^-1 * B, or alpha * B * op( A )^-1 for CblasRight, A being triangular
+        void triangularSolve( CBLAS_SIDE      side,
+                              CBLAS_TRANSPOSE trans,
+                              CBLAS_DIAG      diag,
+                              int             m,
+                              int             n,
+                              double          alpha,
+                              double *        b,
+                              int             ldb ) const;
+        // A = alpha * op( C ) * op( C )^t + beta * A, op( C ) being n-by-k as for my_dsyrk
+        void rankUpdate( CBLAS_TRANSPOSE trans, int k, double alpha, const double *c, int ldc, double beta );
+
+        inline int           dim() const { return n; }
+        inline CBLAS_UPLO    uplo() const { return uplo_; }
+        inline const double *data() const { return data_.data(); }
+        inline double *      data() { return data_.data(); }
+
+      private:
+        int                 n;
+        CBLAS_UPLO          uplo_;
+        std::vector<double> data_;
+    };
+
+} // namespace my_lapack
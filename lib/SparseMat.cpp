@@ -0,0 +1,212 @@
+#include "SparseMat.h"
+
+#include "err.h"
+#include "my_lapack.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace my_lapack {
+
+    SparseMat::SparseMat()
+        : m( 0 )
+        , n( 0 )
+        , format_( CSR )
+        , ptr_( 1, 0 )
+    {
+    }
+
+    SparseMat::SparseMat( int m, int n, int nnz, const int *rows, const int *cols, const double *values, Format format )
+        : m( m )
+        , n( n )
+        , format_( format )
+    {
+        LAHPC_CHECK_POSITIVE( m );
+        LAHPC_CHECK_POSITIVE( n );
+        LAHPC_CHECK_POSITIVE( nnz );
+
+        // Counting sort on the major index, the row for CSR and the column for CSC
+        const int *major = ( format == CSR ) ? rows : cols;
+        const int *minor = ( format == CSR ) ? cols : rows;
+        int        nMaj  = storedRows();
+        ptr_.assign( nMaj + 1, 0 );
+        for ( int k = 0; k < nnz; ++k ) {
+            LAHPC_CHECK_PREDICATE( rows[k] >= 0 && rows[k] < m && cols[k] >= 0 && cols[k] < n );
+            ++ptr_[major[k] + 1];
+        }
+        for ( int i = 0; i < nMaj; ++i ) {
+            ptr_[i + 1] += ptr_[i];
+        }
+
+        std::vector<int> next( ptr_.begin(), ptr_.end() - 1 );
+        indices_.resize( nnz );
+        values_.resize( nnz );
+        for ( int k = 0; k < nnz; ++k ) {
+            int pos       = next[major[k]]++;
+            indices_[pos] = minor[k];
+            values_[pos]  = values[k];
+        }
+
+        // Each row is sorted, then compacted in place with its duplicates summed
+        std::vector<std::pair<int, double>> entries;
+        int                                 out = 0;
+        for ( int i = 0; i < nMaj; ++i ) {
+            int begin = ptr_[i], end = ptr_[i + 1];
+            entries.clear();
+            for ( int k = begin; k < end; ++k ) {
+                entries.emplace_back( indices_[k], values_[k] );
+            }
+            std::sort( entries.begin(),
+                       entries.end(),
+                       []( const std::pair<int, double> &a, const std::pair<int, double> &b ) { return a.first < b.first; } );
+
+            ptr_[i] = out;
+            for ( const std::pair<int, double> &e : entries ) {
+                if ( out > ptr_[i] && indices_[out - 1] == e.first ) { values_[out - 1] += e.second; }
+                else {
+                    indices_[out] = e.first;
+                    values_[out]  = e.second;
+                    ++out;
+                }
+            }
+        }
+        ptr_[nMaj] = out;
+        indices_.resize( out );
+        values_.resize( out );
+    }
+
+    SparseMat SparseMat::fromDense( int m, int n, const double *a, int lda, Format format )
+    {
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, m ) );
+
+        std::vector<int>    rows, cols;
+        std::vector<double> values;
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < m; ++i ) {
+                double v = a[static_cast<std::size_t>( j ) * lda + i];
+                if ( v != 0. ) {
+                    rows.push_back( i );
+                    cols.push_back( j );
+                    values.push_back( v );
+                }
+            }
+        }
+        return SparseMat( m, n, static_cast<int>( values.size() ), rows.data(), cols.data(), values.data(), format );
+    }
+
+    SparseMat SparseMat::readMatrixMarket( const std::string &path, Format format )
+    {
+        std::ifstream in( path );
+        if ( !in ) { throw std::runtime_error( "Cannot open " + path ); }
+
+        std::string line, banner, object, layout, field, symmetry;
+        std::getline( in, line );
+        std::istringstream header( line );
+        header >> banner >> object >> layout >> field >> symmetry;
+        for ( std::string *word : { &object, &layout, &field, &symmetry } ) {
+            std::transform( word->begin(), word->end(), word->begin(), []( unsigned char c ) { return std::tolower( c ); } );
+        }
+        if ( banner != "%%MatrixMarket" || object != "matrix" || layout != "coordinate" ) {
+            throw std::runtime_error( path + ": not a coordinate Matrix Market matrix" );
+        }
+        bool pattern = ( field == "pattern" );
+        if ( !pattern && field != "real" && field != "integer" ) {
+            throw std::runtime_error( path + ": unsupported Matrix Market field " + field );
+        }
+        bool symmetric = ( symmetry == "symmetric" ), skew = ( symmetry == "skew-symmetric" );
+        if ( !symmetric && !skew && symmetry != "general" ) {
+            throw std::runtime_error( path + ": unsupported Matrix Market symmetry " + symmetry );
+        }
+
+        // Comment lines start with %, the first other line holds the dimensions
+        while ( std::getline( in, line ) && ( line.empty() || line[0] == '%' ) ) {}
+        std::istringstream sizes( line );
+        int                m, n, entries;
+        if ( !( sizes >> m >> n >> entries ) ) { throw std::runtime_error( path + ": missing Matrix Market sizes" ); }
+
+        // Entries are 1-based, the other triangle of the symmetric matrices being implicit
+        std::vector<int>    rows, cols;
+        std::vector<double> values;
+        rows.reserve( ( symmetric || skew ) ? 2 * entries : entries );
+        cols.reserve( rows.capacity() );
+        values.reserve( rows.capacity() );
+        for ( int e = 0; e < entries; ++e ) {
+            int    i, j;
+            double v = 1.;
+            in >> i >> j;
+            if ( !pattern ) { in >> v; }
+            if ( !in ) { throw std::runtime_error( path + ": truncated Matrix Market entries" ); }
+            if ( i < 1 || i > m || j < 1 || j > n ) {
+                throw std::runtime_error( path + ": Matrix Market entry out of the matrix" );
+            }
+
+            rows.push_back( i - 1 );
+            cols.push_back( j - 1 );
+            values.push_back( v );
+            if ( ( symmetric || skew ) && i != j ) {
+                rows.push_back( j - 1 );
+                cols.push_back( i - 1 );
+                values.push_back( skew ? -v : v );
+            }
+        }
+
+        return SparseMat( m, n, static_cast<int>( values.size() ), rows.data(), cols.data(), values.data(), format );
+    }
+
+    SparseMat SparseMat::converted( Format format ) const
+    {
+        if ( format == format_ ) { return *this; }
+
+        std::vector<int> majors( values_.size() );
+        for ( int i = 0; i < storedRows(); ++i ) {
+            std::fill( majors.begin() + ptr_[i], majors.begin() + ptr_[i + 1], i );
+        }
+        const int *rows = ( format_ == CSR ) ? majors.data() : indices_.data();
+        const int *cols = ( format_ == CSR ) ? indices_.data() : majors.data();
+        return SparseMat( m, n, nnz(), rows, cols, values_.data(), format );
+    }
+
+    Mat SparseMat::toDense() const
+    {
+        Mat D = MatZero( m, n );
+        for ( int i = 0; i < storedRows(); ++i ) {
+            for ( int k = ptr_[i]; k < ptr_[i + 1]; ++k ) {
+                if ( format_ == CSR ) { D.at( i, indices_[k] ) = values_[k]; }
+                else {
+                    D.at( indices_[k], i ) = values_[k];
+                }
+            }
+        }
+        return D;
+    }
+
+    void SparseMat::spmv( CBLAS_TRANSPOSE trans, double alpha, const double *x, double beta, double *y ) const
+    {
+        // On the CSC storage, A is the transpose of the stored CSR matrix
+        if ( format_ == CSC ) { trans = ( trans == CblasNoTrans ) ? CblasTrans : CblasNoTrans; }
+        int rows = storedRows(), cols = ( format_ == CSR ) ? n : m;
+        my_dcsrmv( trans, rows, cols, alpha, ptr_.data(), indices_.data(), values_.data(), x, 1, beta, y, 1 );
+    }
+
+    void SparseMat::spmm( CBLAS_TRANSPOSE trans,
+                          int             nrhs,
+                          double          alpha,
+                          const double *  b,
+                          int             ldb,
+                          double          beta,
+                          double *        c,
+                          int             ldc ) const
+    {
+        // op( A ) is opRows x opCols whatever the storage, only the transposition of the stored matrix changing
+        int opRows = ( trans == CblasNoTrans ) ? m : n;
+        int opCols = ( trans == CblasNoTrans ) ? n : m;
+        if ( format_ == CSC ) { trans = ( trans == CblasNoTrans ) ? CblasTrans : CblasNoTrans; }
+        my_dcsrmm(
+            trans, opRows, nrhs, opCols, alpha, ptr_.data(), indices_.data(), values_.data(), b, ldb, beta, c, ldc );
+    }
+
+} // namespace my_lapack
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Mat.h"
+#include "my_lapack.h"
+
+#include <string>
+#include <vector>
+
+namespace my_lapack {
+
+    // Sparse matrix in compressed row (CSR) or compressed column (CSC) storage, with 0-based indices sorted within
+    // each row or column. The CSC storage of A is the CSR storage of A^t, which is how the products run on it.
+    class SparseMat {
+      public:
+        enum Format { CSR, CSC };
+
+        SparseMat();
+        // From the coordinate list ( rows[ k ], cols[ k ], values[ k ] ), k < nnz, duplicate entries being summed
+        SparseMat( int m, int n, int nnz, const int *rows, const int *cols, const double *values, Format format = CSR );
+
+        // Nonzero entries of the dense m-by-n matrix a
+        static SparseMat fromDense( int m, int n, const double *a, int lda, Format format = CSR );
+        // Reads a coordinate Matrix Market file: real, integer or pattern, general, symmetric or skew-symmetric
+        static SparseMat readMatrixMarket( const std::string &path, Format format = CSR );
+
+        SparseMat converted( Format format ) const;
+        Mat       toDense() const;
+
+        // y = alpha * op( A ) * x + beta * y
+        void spmv( CBLAS_TRANSPOSE trans, double alpha, const double *x, double beta, double *y ) const;
+        // C = alpha * op( A ) * B + beta * C, B and C being dense column-major with nrhs columns, as for my_dgemm
+        void spmm( CBLAS_TRANSPOSE trans,
+                   int             nrhs,
+                   double          alpha,
+                   const double *  b,
+                   int             ldb,
+                   double          beta,
+                   double *        c,
+                   int             ldc ) const;
+
+        inline int    dimX() const { return m; }
+        inline int    dimY() const { return n; }
+        inline int    nnz() const { return static_cast<int>( values_.size() ); }
+        inline Format format() const { return format_; }
+        // dimX() + 1 offsets for CSR, dimY() + 1 for CSC
+        inline const int *   ptr() const { return ptr_.data(); }
+        inline const int *   indices() const { return indices_.data(); }
+        inline const double *values() const { return values_.data(); }
+
+      private:
+        int                 m, n;
+        Format              format_;
+        std::vector<int>    ptr_;
+        std::vector<int>    indices_;
+        std::vector<double> values_;
+
+        // Rows of the CSR storage: dimX() for CSR, dimY() for CSC
+        inline int storedRows() const { return format_ == CSR ? m : n; }
+    };
+
+} // namespace my_lapack
@@ -47,9 +47,9 @@ void Summa::init( int *argc, char ***argv )
     this->argc = *argc;
     this->argv = new char *[*argc];
     for ( int i = 0; i < *argc; ++i ) {
-        auto len      = std::strlen( *argv[i] );
-        this->argv[i] = new char[len];
-        std::strcpy( this->argv[i], *argv[i] );
+        auto len      = std::strlen( ( *argv )[i] );
+        this->argv[i] = new char[len + 1];
+        std::strcpy( this->argv[i], ( *argv )[i] );
     }
 
     isInitialized = true;
@@ -59,7 +59,10 @@ void Summa::init( int *argc, char ***argv )
 void Summa::reset( int M, int N, int K )
 {
     if ( isInitialized ) {
-        MPI_Init( &argc, &argv );
+        // reset() may be called once per operation, MPI must only be initialized once
+        int mpiInitialized;
+        MPI_Initialized( &mpiInitialized );
+        if ( !mpiInitialized ) { MPI_Init( &argc, &argv ); }
 
         int worldSize, worldRank;
         MPI_Comm_size( MPI_COMM_WORLD, &worldSize );
@@ -3,6 +3,13 @@
 
 #include "cblas.h"
 
+#if defined _my_lapack_mpi || defined _my_lapack_all
+#include <mpi.h>
+#endif
+
+// Block size of the blocked kernels, which also sets the layout of the my_dtrtri_diag workspace
+#define _LAHPC_BLOCK_SIZE 34
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -15,6 +22,17 @@ namespace my_lapack {
     void my_daxpy_seq( const int N, const double alpha, const double *X, const int incX, double *Y, const int incY );
     void my_daxpy_openmp( const int N, const double alpha, const double *X, const int incX, double *Y, const int incY );
 
+    // Fused kernels, each reading its vectors once: Y = alpha * X + beta * Y, Y = Y + alpha * X returning Y^t * Z (Z
+    // may be Y), and the dual dot products xy = X^t * Y and xx = X^t * X
+    void my_daxpby_seq( int N, double alpha, const double *X, int incX, double beta, double *Y, int incY );
+    void my_daxpby_openmp( int N, double alpha, const double *X, int incX, double beta, double *Y, int incY );
+    double my_daxpy_dot_seq(
+        int N, double alpha, const double *X, int incX, double *Y, int incY, const double *Z, int incZ );
+    double my_daxpy_dot_openmp(
+        int N, double alpha, const double *X, int incX, double *Y, int incY, const double *Z, int incZ );
+    void my_ddot2_seq( int N, const double *X, int incX, const double *Y, int incY, double *xy, double *xx );
+    void my_ddot2_openmp( int N, const double *X, int incX, const double *Y, int incY, double *xy, double *xx );
+
     void my_dgemv_seq( CBLAS_ORDER     layout,
                        CBLAS_TRANSPOSE TransA,
                        int             M,
@@ -40,6 +58,64 @@ namespace my_lapack {
                           double *        Y,
                           const int       incY );
 
+    // y = alpha * op( A ) * x + beta * y, returning ||y||^2 computed while y is still in cache
+    double my_dgemv_norm_seq( CBLAS_ORDER     layout,
+                              CBLAS_TRANSPOSE TransA,
+                              int             M,
+                              int             N,
+                              double          alpha,
+                              const double *  A,
+                              int             lda,
+                              const double *  X,
+                              int             incX,
+                              double          beta,
+                              double *        Y,
+                              const int       incY );
+    double my_dgemv_norm_openmp( CBLAS_ORDER     layout,
+                                 CBLAS_TRANSPOSE TransA,
+                                 int             M,
+                                 int             N,
+                                 double          alpha,
+                                 const double *  A,
+                                 int             lda,
+                                 const double *  X,
+                                 int             incX,
+                                 double          beta,
+                                 double *        Y,
+                                 const int       incY );
+
+    // Dual GEMV in one pass over the M x N matrix A: W = alpha * A * X + beta * W and Z = alpha * A^t * Y + beta * Z
+    void my_dgemv2_seq( CBLAS_ORDER   layout,
+                        int           M,
+                        int           N,
+                        double        alpha,
+                        const double *A,
+                        int           lda,
+                        const double *X,
+                        int           incX,
+                        const double *Y,
+                        int           incY,
+                        double        beta,
+                        double *      W,
+                        int           incW,
+                        double *      Z,
+                        int           incZ );
+    void my_dgemv2_openmp( CBLAS_ORDER   layout,
+                           int           M,
+                           int           N,
+                           double        alpha,
+                           const double *A,
+                           int           lda,
+                           const double *X,
+                           int           incX,
+                           const double *Y,
+                           int           incY,
+                           double        beta,
+                           double *      W,
+                           int           incW,
+                           double *      Z,
+                           int           incZ );
+
     void my_dgemm_scal_seq( CBLAS_ORDER     layout,
                             CBLAS_TRANSPOSE TransA,
                             CBLAS_TRANSPOSE TransB,
@@ -90,6 +166,30 @@ namespace my_lapack {
                          double *      A,
                          int           lda );
 
+    // X = scale * X, then A = A + alpha * X * Y^t, in the same pass over A: the step of the unblocked LU panels
+    void my_dscal_dger_seq( CBLAS_ORDER   layout,
+                            int           M,
+                            int           N,
+                            double        scale,
+                            double *      X,
+                            int           incX,
+                            double        alpha,
+                            const double *Y,
+                            int           incY,
+                            double *      A,
+                            int           lda );
+    void my_dscal_dger_openmp( CBLAS_ORDER   layout,
+                               int           M,
+                               int           N,
+                               double        scale,
+                               double *      X,
+                               int           incX,
+                               double        alpha,
+                               const double *Y,
+                               int           incY,
+                               double *      A,
+                               int           lda );
+
     void my_dgemm_seq( CBLAS_ORDER     Order,
                        CBLAS_TRANSPOSE TransA,
                        CBLAS_TRANSPOSE TransB,
@@ -134,6 +234,47 @@ namespace my_lapack {
                           double * c,
                           int ldc );
 
+    // Occupancy mask of the M x N matrix A cut in _LAHPC_BLOCK_SIZE square tiles: mask[ ti + tj * MT ], MT being
+    // the number of tile rows, is 1 if tile ( ti, tj ) holds a nonzero and 0 otherwise
+    void my_dtile_mask_seq( int M, int N, const double *A, int lda, unsigned char *mask );
+    void my_dtile_mask_openmp( int M, int N, const double *A, int lda, unsigned char *mask );
+
+    // my_dgemm skipping the tile products where a tile of op( A ) or of op( B ) is zero. maskA and maskB are the
+    // my_dtile_mask of A and B as stored, before transposition, and are computed when null. C is zeroed, not
+    // scaled, when beta is 0.
+    void my_dgemm_masked_seq( CBLAS_ORDER          Order,
+                              CBLAS_TRANSPOSE      TransA,
+                              CBLAS_TRANSPOSE      TransB,
+                              int                  M,
+                              int                  N,
+                              int                  K,
+                              double               alpha,
+                              const double *       A,
+                              int                  lda,
+                              const unsigned char *maskA,
+                              const double *       B,
+                              int                  ldb,
+                              const unsigned char *maskB,
+                              double               beta,
+                              double *             C,
+                              int                  ldc );
+    void my_dgemm_masked_openmp( CBLAS_ORDER          Order,
+                                 CBLAS_TRANSPOSE      TransA,
+                                 CBLAS_TRANSPOSE      TransB,
+                                 int                  M,
+                                 int                  N,
+                                 int                  K,
+                                 double               alpha,
+                                 const double *       A,
+                                 int                  lda,
+                                 const unsigned char *maskA,
+                                 const double *       B,
+                                 int                  ldb,
+                                 const unsigned char *maskB,
+                                 double               beta,
+                                 double *             C,
+                                 int                  ldc );
+
     void my_dgetf2_seq( CBLAS_ORDER order, int M, int N, double *A, int lda );
     void my_dgetf2_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda );
 
@@ -162,8 +303,385 @@ namespace my_lapack {
                           double *        B,
                           int             ldb );
 
+    // Inverse of a triangular matrix in place. Returns 0, or j + 1 if A( j, j ) is exactly zero, A being then left
+    // untouched.
+    int my_dtrtri_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, double *A, int lda );
+    int my_dtrtri_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, double *A, int lda );
+
+    // Inverses of the diagonal blocks of a triangular matrix, stored side by side in the _LAHPC_BLOCK_SIZE-by-N invA.
+    // Computed once per matrix, they let my_dtrsm_inv solve the diagonal blocks with GEMMs, which pays off for many
+    // right-hand sides. Returns the info of my_dtrtri.
+    int my_dtrtri_diag_seq(
+        CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, const double *A, int lda, double *invA );
+    int my_dtrtri_diag_openmp(
+        CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, const double *A, int lda, double *invA );
+
+    // my_dtrsm with the inverses computed by my_dtrtri_diag for the same uplo and diag
+    void my_dtrsm_inv_seq( CBLAS_ORDER     layout,
+                           CBLAS_SIDE      Side,
+                           CBLAS_UPLO      Uplo,
+                           CBLAS_TRANSPOSE transA,
+                           CBLAS_DIAG      Diag,
+                           int             M,
+                           int             N,
+                           double          alpha,
+                           const double *  A,
+                           int             lda,
+                           const double *  invA,
+                           double *        B,
+                           int             ldb );
+    void my_dtrsm_inv_openmp( CBLAS_ORDER     layout,
+                              CBLAS_SIDE      Side,
+                              CBLAS_UPLO      Uplo,
+                              CBLAS_TRANSPOSE transA,
+                              CBLAS_DIAG      Diag,
+                              int             M,
+                              int             N,
+                              double          alpha,
+                              const double *  A,
+                              int             lda,
+                              const double *  invA,
+                              double *        B,
+                              int             ldb );
+
     void my_dgetrf_seq( CBLAS_ORDER order, int M, int N, double *A, int lda );
     void my_dgetrf_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda );
+    // A is only read on rank 0, the factors are gathered back on it. Summa must have been reset on the grid.
+    void my_dgetrf_mpi( CBLAS_ORDER order, int M, int N, double *A, int lda );
+    // Same with partial pivoting over the Summa grid, as my_dgetrf_piv_seq. ipiv is filled on every rank.
+    int my_dgetrf_piv_mpi( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv );
+
+#if defined _my_lapack_mpi || defined _my_lapack_all
+    // LU factorization with partial pivoting of the M x N matrix distributed 2-D block-cyclically by nb x nb blocks
+    // over the process grid of comm_row and comm_col: block ( I, J ) is stored on the process ( I % r, J % c ), the
+    // local blocks being packed in A of leading dimension lda. ipiv, of min( M, N ) global 0-based row indices, is
+    // filled on every process; when null the matrix is factorized without pivoting. Returns 0, or i + 1 if U( i, i )
+    // is exactly zero.
+    int pdgetrf( int M, int N, int nb, double *A, int lda, int *ipiv, MPI_Comm comm_row, MPI_Comm comm_col );
+#endif
+
+    // LU factorization with partial pivoting P * A = L * U. ipiv holds 0-based row indices, as used by my_dlaswp.
+    // Returns 0, or i + 1 if U( i, i ) is exactly zero (the factorization is completed but U is singular).
+    int my_dgetf2_piv_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv );
+    int my_dgetf2_piv_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv );
+    int my_dgetrf_piv_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv );
+    int my_dgetrf_piv_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv );
+
+    // Solves A * X = B for NRHS right-hand sides at once, using the factors computed by my_dgetrf_piv
+    void my_dgetrs_seq( CBLAS_ORDER   order,
+                        int           N,
+                        int           NRHS,
+                        const double *A,
+                        int           lda,
+                        const int *   ipiv,
+                        double *      B,
+                        int           ldb );
+    void my_dgetrs_openmp( CBLAS_ORDER   order,
+                           int           N,
+                           int           NRHS,
+                           const double *A,
+                           int           lda,
+                           const int *   ipiv,
+                           double *      B,
+                           int           ldb );
+
+    // Factorizes A in place and overwrites B with the solution. Returns the info of my_dgetrf_piv, B is left
+    // untouched if it is not 0.
+    int my_dgesv_seq( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, int *ipiv, double *B, int ldb );
+    int my_dgesv_openmp( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, int *ipiv, double *B, int ldb );
+
+    // Band storage of an N x N matrix with KL subdiagonals and KU superdiagonals, as in LAPACK: A( i, j ) is
+    // AB[ KL + KU + i - j + j * ldab ], ldab >= 2 * KL + KU + 1. The first KL rows of AB receive the fill-in of U,
+    // whose band widens to KL + KU superdiagonals through the interchanges, and are zeroed by the factorization.
+    //
+    // Banded LU factorization with partial pivoting, ipiv holding 0-based rows. L is kept as the multipliers of each
+    // column without the interchanges of the later columns, so that the factors are meant for my_dgbtrs. Returns 0,
+    // or i + 1 if U( i, i ) is exactly zero.
+    int my_dgbtrf_seq( CBLAS_ORDER order, int N, int KL, int KU, double *AB, int ldab, int *ipiv );
+    int my_dgbtrf_openmp( CBLAS_ORDER order, int N, int KL, int KU, double *AB, int ldab, int *ipiv );
+
+    // Solves A * X = B using the factors computed by my_dgbtrf
+    void my_dgbtrs_seq( CBLAS_ORDER   order,
+                        int           N,
+                        int           KL,
+                        int           KU,
+                        int           NRHS,
+                        const double *AB,
+                        int           ldab,
+                        const int *   ipiv,
+                        double *      B,
+                        int           ldb );
+    void my_dgbtrs_openmp( CBLAS_ORDER   order,
+                           int           N,
+                           int           KL,
+                           int           KU,
+                           int           NRHS,
+                           const double *AB,
+                           int           ldab,
+                           const int *   ipiv,
+                           double *      B,
+                           int           ldb );
+
+    // Factorizes batchCount independent N x N matrices A[ b ] with partial pivoting, info[ b ] being the info of
+    // my_dgetrf_piv for each of them. Matrices up to 64 x 64 use dedicated size class kernels.
+    void my_dgetrf_batch_seq( CBLAS_ORDER order, int N, double **A, int lda, int **ipiv, int *info, int batchCount );
+    void my_dgetrf_batch_openmp( CBLAS_ORDER order, int N, double **A, int lda, int **ipiv, int *info, int batchCount );
+
+    // Solves A[ b ] * X[ b ] = B[ b ] for each matrix of the batch, using the factors computed by my_dgetrf_batch
+    void my_dgetrs_batch_seq( CBLAS_ORDER          order,
+                              int                  N,
+                              int                  NRHS,
+                              const double *const *A,
+                              int                  lda,
+                              const int *const *   ipiv,
+                              double **            B,
+                              int                  ldb,
+                              int                  batchCount );
+    void my_dgetrs_batch_openmp( CBLAS_ORDER          order,
+                                 int                  N,
+                                 int                  NRHS,
+                                 const double *const *A,
+                                 int                  lda,
+                                 const int *const *   ipiv,
+                                 double **            B,
+                                 int                  ldb,
+                                 int                  batchCount );
+
+    void my_dsyrk_seq( CBLAS_ORDER     order,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       int             N,
+                       int             K,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       double          beta,
+                       double *        C,
+                       int             ldc );
+    void my_dsyrk_openmp( CBLAS_ORDER     order,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          int             N,
+                          int             K,
+                          double          alpha,
+                          const double *  A,
+                          int             lda,
+                          double          beta,
+                          double *        C,
+                          int             ldc );
+
+    // Cholesky factorization A = L * L^t of a symmetric positive definite matrix, only its lower triangle is
+    // referenced and overwritten by L. Returns 0, or j + 1 if the leading minor of order j + 1 is not positive.
+    int my_dpotf2_seq( CBLAS_ORDER order, int N, double *A, int lda );
+    int my_dpotrf_seq( CBLAS_ORDER order, int N, double *A, int lda );
+    int my_dpotrf_openmp( CBLAS_ORDER order, int N, double *A, int lda );
+
+    // Solves A * X = B using the factor computed by my_dpotrf
+    void my_dpotrs_seq( CBLAS_ORDER order, int N, int NRHS, const double *A, int lda, double *B, int ldb );
+    void my_dpotrs_openmp( CBLAS_ORDER order, int N, int NRHS, const double *A, int lda, double *B, int ldb );
+
+    int my_dposv_seq( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, double *B, int ldb );
+    int my_dposv_openmp( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, double *B, int ldb );
+
+    // Rectangular full packed ( RFP ) storage of the uplo triangle of an N-by-N matrix, LAPACK's with TRANSR = 'N':
+    // N * ( N + 1 ) / 2 doubles forming a column-major ld-by-( N + 1 ) / 2 rectangle, ld being N for odd N and
+    // N + 1 for even N. The matrix is split into blocks of order n1 and n2, n1 being the larger one for Lower and
+    // the smaller one for Upper. The triangle of the first diagonal block is stored as a lower triangle and the
+    // one of the second as an upper triangle sharing its columns, the off-diagonal block below them:
+    // - Lower: A11 lower, A22^t upper, A21 ( n2-by-n1 ) below;
+    // - Upper: A11^t lower, A22 upper, A12 ( n1-by-n2 ) below.
+    // Every operation on it therefore runs as a few dense level-3 kernels on these three blocks.
+
+    // Copies the uplo triangle of A into ARF, and back
+    void my_dtrttf_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *A, int lda, double *ARF );
+    void my_dtrttf_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *A, int lda, double *ARF );
+    void my_dtfttr_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *ARF, double *A, int lda );
+    void my_dtfttr_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *ARF, double *A, int lda );
+
+    // Cholesky factorization of a symmetric positive definite matrix in RFP storage, A = L * L^t for Lower and
+    // A = U^t * U for Upper, the factor overwriting ARF. Returns 0, or j + 1 as my_dpotrf.
+    int my_dpftrf_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, double *ARF );
+    int my_dpftrf_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, double *ARF );
+
+    // Solves A * X = B using the factor computed by my_dpftrf
+    void my_dpftrs_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, int NRHS, const double *ARF, double *B, int ldb );
+    void my_dpftrs_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, int NRHS, const double *ARF, double *B, int ldb );
+
+    // my_dtrsm with the triangular matrix, of order M for CblasLeft and N for CblasRight, in RFP storage
+    void my_dtfsm_seq( CBLAS_ORDER     order,
+                       CBLAS_SIDE      side,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       CBLAS_DIAG      diag,
+                       int             M,
+                       int             N,
+                       double          alpha,
+                       const double *  ARF,
+                       double *        B,
+                       int             ldb );
+    void my_dtfsm_openmp( CBLAS_ORDER     order,
+                          CBLAS_SIDE      side,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          CBLAS_DIAG      diag,
+                          int             M,
+                          int             N,
+                          double          alpha,
+                          const double *  ARF,
+                          double *        B,
+                          int             ldb );
+
+    // my_dsyrk with C in RFP storage
+    void my_dsfrk_seq( CBLAS_ORDER     order,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       int             N,
+                       int             K,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       double          beta,
+                       double *        CRF );
+    void my_dsfrk_openmp( CBLAS_ORDER     order,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          int             N,
+                          int             K,
+                          double          alpha,
+                          const double *  A,
+                          int             lda,
+                          double          beta,
+                          double *        CRF );
+
+    // Householder QR factorization A = Q * R. R overwrites the upper triangle of A, and the reflectors
+    // H( j ) = I - tau( j ) * v * v^t are stored below the diagonal with an implicit unit diagonal.
+    // Q = H( 0 ) * ... * H( K-1 ), K = min( M, N ).
+    void my_dgeqr2_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau );
+    void my_dgeqrf_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau );
+    void my_dgeqrf_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau );
+
+    // Upper triangular T of the block reflector H( 0 ) * ... * H( K-1 ) = I - V * T * V^t, as stored by my_dgeqrf
+    void my_dlarft_seq( CBLAS_ORDER order, int M, int K, const double *V, int ldv, const double *tau, double *T, int ldt );
+
+    // Applies the block reflector I - V * T * V^t, or its transpose, to C from the left or from the right
+    void my_dlarfb_seq( CBLAS_ORDER     order,
+                        CBLAS_SIDE      side,
+                        CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        int             K,
+                        const double *  V,
+                        int             ldv,
+                        const double *  T,
+                        int             ldt,
+                        double *        C,
+                        int             ldc );
+    void my_dlarfb_openmp( CBLAS_ORDER     order,
+                           CBLAS_SIDE      side,
+                           CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           int             K,
+                           const double *  V,
+                           int             ldv,
+                           const double *  T,
+                           int             ldt,
+                           double *        C,
+                           int             ldc );
+
+    // Overwrites C with op( Q ) * C or C * op( Q ), Q being defined by the first K reflectors computed by my_dgeqrf
+    void my_dormqr_seq( CBLAS_ORDER     order,
+                        CBLAS_SIDE      side,
+                        CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        int             K,
+                        const double *  A,
+                        int             lda,
+                        const double *  tau,
+                        double *        C,
+                        int             ldc );
+    void my_dormqr_openmp( CBLAS_ORDER     order,
+                           CBLAS_SIDE      side,
+                           CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           int             K,
+                           const double *  A,
+                           int             lda,
+                           const double *  tau,
+                           double *        C,
+                           int             ldc );
+
+    // Least squares solution of the overdetermined system A * X = B ( M >= N ) through the QR factorization of A.
+    // X overwrites the first N rows of B. Returns 0, or j + 1 if R( j, j ) is zero (A is not of full rank).
+    int my_dgels_seq( CBLAS_ORDER order, int M, int N, int NRHS, double *A, int lda, double *B, int ldb );
+    int my_dgels_openmp( CBLAS_ORDER order, int M, int N, int NRHS, double *A, int lda, double *B, int ldb );
+
+    // Single precision kernels of the mixed precision solver
+    void my_sgemm_seq( CBLAS_ORDER     Order,
+                       CBLAS_TRANSPOSE TransA,
+                       CBLAS_TRANSPOSE TransB,
+                       int             M,
+                       int             N,
+                       int             K,
+                       float           alpha,
+                       const float *   A,
+                       int             lda,
+                       const float *   B,
+                       int             ldb,
+                       float           beta,
+                       float *         C,
+                       int             ldc );
+    void my_sgemm_openmp( CBLAS_ORDER     Order,
+                          CBLAS_TRANSPOSE TransA,
+                          CBLAS_TRANSPOSE TransB,
+                          int             M,
+                          int             N,
+                          int             K,
+                          float           alpha,
+                          const float *   A,
+                          int             lda,
+                          const float *   B,
+                          int             ldb,
+                          float           beta,
+                          float *         C,
+                          int             ldc );
+
+    int my_sgetf2_piv_seq( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv );
+    int my_sgetrf_piv_seq( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv );
+    int my_sgetrf_piv_openmp( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv );
+
+    void my_sgetrs_seq( CBLAS_ORDER order, int N, int NRHS, const float *A, int lda, const int *ipiv, float *B, int ldb );
+    void my_sgetrs_openmp(
+        CBLAS_ORDER order, int N, int NRHS, const float *A, int lda, const int *ipiv, float *B, int ldb );
+
+    // Solves A * X = B with a single precision LU factorization refined to double precision accuracy, B being kept.
+    // A is left untouched, unless the refinement fails: iter is then negative (-1 overflow in the conversion to
+    // single precision, -2 singular single precision factors, -3 refinement stalled) and the system is solved by
+    // my_dgesv, whose info is returned. Otherwise iter is the number of refinement steps.
+    int my_dsgesv_seq( CBLAS_ORDER   order,
+                       int           N,
+                       int           NRHS,
+                       double *      A,
+                       int           lda,
+                       int *         ipiv,
+                       const double *B,
+                       int           ldb,
+                       double *      X,
+                       int           ldx,
+                       int *         iter );
+    int my_dsgesv_openmp( CBLAS_ORDER   order,
+                          int           N,
+                          int           NRHS,
+                          double *      A,
+                          int           lda,
+                          int *         ipiv,
+                          const double *B,
+                          int           ldb,
+                          double *      X,
+                          int           ldx,
+                          int *         iter );
 
     int my_idamax_seq( int N, double *dx, int incX );
     int my_idamax_openmp( int N, double *dx, int incX );
@@ -174,37 +692,184 @@ namespace my_lapack {
     void my_dlaswp_seq( int N, double *A, int lda, int k1, int k2, int *ipv, int incX );
     void my_dlaswp_openmp( int N, double *A, int lda, int k1, int k2, int *ipv, int incX );
 
-    void my_dlacpy( int M, int N, const double *a, int lda, double *b, int ldb );
+    // B = A, for the M x N matrices A and B
+    void my_dlacpy_seq( int M, int N, const double *a, int lda, double *b, int ldb );
+    void my_dlacpy_openmp( int M, int N, const double *a, int lda, double *b, int ldb );
+
+    // B = A^t, for the M x N matrix A and the N x M matrix B
+    void my_dlacpy_trans_seq( int M, int N, const double *a, int lda, double *b, int ldb );
+    void my_dlacpy_trans_openmp( int M, int N, const double *a, int lda, double *b, int ldb );
+
+
+    // Sparse products with the M x N matrix A in CSR storage: the nonzeros of the row i are val[ k ], in the columns
+    // colInd[ k ], for rowPtr[ i ] <= k < rowPtr[ i + 1 ], all indices being 0-based.
+    // y = alpha * op( A ) * x + beta * y
+    void my_dcsrmv_seq( CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        double          alpha,
+                        const int *     rowPtr,
+                        const int *     colInd,
+                        const double *  val,
+                        const double *  X,
+                        int             incX,
+                        double          beta,
+                        double *        Y,
+                        int             incY );
+    void my_dcsrmv_openmp( CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           double          alpha,
+                           const int *     rowPtr,
+                           const int *     colInd,
+                           const double *  val,
+                           const double *  X,
+                           int             incX,
+                           double          beta,
+                           double *        Y,
+                           int             incY );
 
+    // C = alpha * op( A ) * B + beta * C with the dense column-major B and C, dimensions as for my_dgemm: op( A ) is
+    // M x K, so that A has M rows when not transposed and K rows when transposed
+    void my_dcsrmm_seq( CBLAS_TRANSPOSE transA,
+                        int             M,
+                        int             N,
+                        int             K,
+                        double          alpha,
+                        const int *     rowPtr,
+                        const int *     colInd,
+                        const double *  val,
+                        const double *  B,
+                        int             ldb,
+                        double          beta,
+                        double *        C,
+                        int             ldc );
+    void my_dcsrmm_openmp( CBLAS_TRANSPOSE transA,
+                           int             M,
+                           int             N,
+                           int             K,
+                           double          alpha,
+                           const int *     rowPtr,
+                           const int *     colInd,
+                           const double *  val,
+                           const double *  B,
+                           int             ldb,
+                           double          beta,
+                           double *        C,
+                           int             ldc );
 
 // Macro definitions to respect our previous naming
-#ifdef _my_lapack_seq
+#if defined _my_lapack_seq || defined _my_lapack_mpi // The MPI library runs sequential kernels on each process
     #define my_ddot my_ddot_seq
     #define my_daxpy my_daxpy_seq
     #define my_dgemv my_dgemv_seq
+    #define my_daxpby my_daxpby_seq
+    #define my_daxpy_dot my_daxpy_dot_seq
+    #define my_ddot2 my_ddot2_seq
+    #define my_dgemv_norm my_dgemv_norm_seq
+    #define my_dgemv2 my_dgemv2_seq
     #define my_dgemm_scal my_dgemm_scal_seq
     #define my_dger my_dger_seq
+    #define my_dscal_dger my_dscal_dger_seq
     #define my_dgemm my_dgemm_seq
+    #define my_dtile_mask my_dtile_mask_seq
+    #define my_dgemm_masked my_dgemm_masked_seq
     #define my_dgetf2 my_dgetf2_seq
     #define my_dgetrf my_dgetrf_seq
+    #define my_dgetf2_piv my_dgetf2_piv_seq
+    #define my_dgetrf_piv my_dgetrf_piv_seq
+    #define my_dgetrs my_dgetrs_seq
+    #define my_dgesv my_dgesv_seq
+    #define my_dgbtrf my_dgbtrf_seq
+    #define my_dgbtrs my_dgbtrs_seq
+    #define my_dgetrf_batch my_dgetrf_batch_seq
+    #define my_dgetrs_batch my_dgetrs_batch_seq
+    #define my_dsyrk my_dsyrk_seq
+    #define my_dpotf2 my_dpotf2_seq
+    #define my_dpotrf my_dpotrf_seq
+    #define my_dpotrs my_dpotrs_seq
+    #define my_dposv my_dposv_seq
+    #define my_dtrttf my_dtrttf_seq
+    #define my_dtfttr my_dtfttr_seq
+    #define my_dpftrf my_dpftrf_seq
+    #define my_dpftrs my_dpftrs_seq
+    #define my_dtfsm my_dtfsm_seq
+    #define my_dsfrk my_dsfrk_seq
+    #define my_dgeqrf my_dgeqrf_seq
+    #define my_dlarfb my_dlarfb_seq
+    #define my_dormqr my_dormqr_seq
+    #define my_dgels my_dgels_seq
+    #define my_sgemm my_sgemm_seq
+    #define my_sgetrf_piv my_sgetrf_piv_seq
+    #define my_sgetrs my_sgetrs_seq
+    #define my_dsgesv my_dsgesv_seq
     #define my_dtrsm my_dtrsm_seq
+    #define my_dtrtri my_dtrtri_seq
+    #define my_dtrtri_diag my_dtrtri_diag_seq
+    #define my_dtrsm_inv my_dtrsm_inv_seq
     #define my_idamax my_idamax_seq
     #define my_dscal my_dscal_seq
     #define my_dlaswp my_dlaswp_seq
+    #define my_dlacpy my_dlacpy_seq
+    #define my_dlacpy_trans my_dlacpy_trans_seq
+    #define my_dcsrmv my_dcsrmv_seq
+    #define my_dcsrmm my_dcsrmm_seq
 #else
     #if defined _my_lapack_omp || defined _my_lapack_all
         #define my_ddot my_ddot_openmp
         #define my_daxpy my_daxpy_openmp
         #define my_dgemv my_dgemv_openmp
+        #define my_daxpby my_daxpby_openmp
+        #define my_daxpy_dot my_daxpy_dot_openmp
+        #define my_ddot2 my_ddot2_openmp
+        #define my_dgemv_norm my_dgemv_norm_openmp
+        #define my_dgemv2 my_dgemv2_openmp
         #define my_dgemm_scal my_dgemm_scal_openmp
         #define my_dger my_dger_openmp
+        #define my_dscal_dger my_dscal_dger_openmp
         #define my_dgemm my_dgemm_openmp
+        #define my_dtile_mask my_dtile_mask_openmp
+        #define my_dgemm_masked my_dgemm_masked_openmp
         #define my_dgetf2 my_dgetf2_openmp
         #define my_dgetrf my_dgetrf_openmp
+        #define my_dgetf2_piv my_dgetf2_piv_openmp
+        #define my_dgetrf_piv my_dgetrf_piv_openmp
+        #define my_dgetrs my_dgetrs_openmp
+        #define my_dgesv my_dgesv_openmp
+        #define my_dgbtrf my_dgbtrf_openmp
+        #define my_dgbtrs my_dgbtrs_openmp
+        #define my_dgetrf_batch my_dgetrf_batch_openmp
+        #define my_dgetrs_batch my_dgetrs_batch_openmp
+        #define my_dsyrk my_dsyrk_openmp
+        #define my_dpotf2 my_dpotf2_seq // The panels are too small to share between threads
+        #define my_dpotrf my_dpotrf_openmp
+        #define my_dpotrs my_dpotrs_openmp
+        #define my_dposv my_dposv_openmp
+        #define my_dtrttf my_dtrttf_openmp
+        #define my_dtfttr my_dtfttr_openmp
+        #define my_dpftrf my_dpftrf_openmp
+        #define my_dpftrs my_dpftrs_openmp
+        #define my_dtfsm my_dtfsm_openmp
+        #define my_dsfrk my_dsfrk_openmp
+        #define my_dgeqrf my_dgeqrf_openmp
+        #define my_dlarfb my_dlarfb_openmp
+        #define my_dormqr my_dormqr_openmp
+        #define my_dgels my_dgels_openmp
+        #define my_sgemm my_sgemm_openmp
+        #define my_sgetrf_piv my_sgetrf_piv_openmp
+        #define my_sgetrs my_sgetrs_openmp
+        #define my_dsgesv my_dsgesv_openmp
         #define my_dtrsm my_dtrsm_openmp
+        #define my_dtrtri my_dtrtri_openmp
+        #define my_dtrtri_diag my_dtrtri_diag_openmp
+        #define my_dtrsm_inv my_dtrsm_inv_openmp
         #define my_idamax my_idamax_openmp
         #define my_dscal my_dscal_openmp
         #define my_dlaswp my_dlaswp_openmp
+        #define my_dlacpy my_dlacpy_openmp
+        #define my_dlacpy_trans my_dlacpy_trans_openmp
+        #define my_dcsrmv my_dcsrmv_openmp
+        #define my_dcsrmm my_dcsrmm_openmp
 
         #define my_dgemm_bloc_openmp my_dgemm_openmp // Default version is bloc bersion
     #endif
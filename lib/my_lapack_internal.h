@@ -0,0 +1,898 @@
+#pragma once
+
+// Internal to the my_lapack libraries, not installed with my_lapack.h: the drivers shared by the sequential and the
+// OpenMP implementations. They are templates on a kernels class, SeqKernels or OmpKernels, whose static members
+// forward to the my_*_seq or my_*_openmp functions, so that each implementation only chooses its kernels.
+
+#include "err.h"
+#include "my_lapack.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+static const int BLOCK_SIZE = _LAHPC_BLOCK_SIZE;
+
+#define AT_RM( i, j, width ) ( ( i ) * ( width ) + ( j ) )
+#define AT( i, j, heigth ) ( ( i ) + ( j ) * ( heigth ) )
+#define min_macro( a, b ) ( ( a ) < ( b ) ? ( a ) : ( b ) )
+
+namespace my_lapack {
+
+    struct SeqKernels {
+        template <typename... Args> static void gemm( Args... args ) { my_dgemm_seq( args... ); }
+        template <typename... Args> static void gemv( Args... args ) { my_dgemv_seq( args... ); }
+        template <typename... Args> static int gesv( Args... args ) { return my_dgesv_seq( args... ); }
+        template <typename... Args> static int sgetrf( Args... args ) { return my_sgetrf_piv_seq( args... ); }
+        template <typename... Args> static void sgetrs( Args... args ) { my_sgetrs_seq( args... ); }
+        template <typename... Args> static void laswp( Args... args ) { my_dlaswp_seq( args... ); }
+        template <typename... Args> static void trsm( Args... args ) { my_dtrsm_seq( args... ); }
+        template <typename... Args> static void syrk( Args... args ) { my_dsyrk_seq( args... ); }
+        template <typename... Args> static int potrf( Args... args ) { return my_dpotrf_seq( args... ); }
+        template <typename... Args> static void lacpyTrans( Args... args ) { my_dlacpy_trans_seq( args... ); }
+    };
+
+    struct OmpKernels {
+        template <typename... Args> static void gemm( Args... args ) { my_dgemm_openmp( args... ); }
+        template <typename... Args> static void gemv( Args... args ) { my_dgemv_openmp( args... ); }
+        template <typename... Args> static int gesv( Args... args ) { return my_dgesv_openmp( args... ); }
+        template <typename... Args> static int sgetrf( Args... args ) { return my_sgetrf_piv_openmp( args... ); }
+        template <typename... Args> static void sgetrs( Args... args ) { my_sgetrs_openmp( args... ); }
+        template <typename... Args> static void laswp( Args... args ) { my_dlaswp_openmp( args... ); }
+        template <typename... Args> static void trsm( Args... args ) { my_dtrsm_openmp( args... ); }
+        template <typename... Args> static void syrk( Args... args ) { my_dsyrk_openmp( args... ); }
+        template <typename... Args> static int potrf( Args... args ) { return my_dpotrf_openmp( args... ); }
+        template <typename... Args> static void lacpyTrans( Args... args ) { my_dlacpy_trans_openmp( args... ); }
+    };
+
+    // Applies the block reflector H = I - V * T * V^t, or H^t, to C from the left or the right. V and T are first
+    // copied with the unit diagonal and the zero triangles made explicit, so that the whole update is three GEMMs.
+    template <class Kernels>
+    void dlarfb( CBLAS_ORDER     order,
+                 CBLAS_SIDE      side,
+                 CBLAS_TRANSPOSE trans,
+                 int             M,
+                 int             N,
+                 int             K,
+                 const double *  V,
+                 int             ldv,
+                 const double *  T,
+                 int             ldt,
+                 double *        C,
+                 int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( K <= ( side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( ldv >= std::max( 1, side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( ldt >= std::max( 1, K ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 || K == 0 ) { return; }
+
+        // The copies are O( nv * K ), negligible next to the GEMMs, and stay sequential
+        int                 nv = ( side == CblasLeft ) ? M : N;
+        std::vector<double> Vf( nv * K, 0. );
+        std::vector<double> Tf( K * K, 0. );
+        for ( int j = 0; j < K; ++j ) {
+            Vf[AT( j, j, nv )] = 1.;
+            std::copy( V + AT( j + 1, j, ldv ), V + AT( nv, j, ldv ), Vf.begin() + AT( j + 1, j, nv ) );
+            std::copy( T + AT( 0, j, ldt ), T + AT( j + 1, j, ldt ), Tf.begin() + AT( 0, j, K ) );
+        }
+
+        if ( side == CblasLeft ) {
+            // C = C - V * op( T )^t * ( V^t * C ), with op( T )^t = T^t for H^t
+            std::vector<double> W( K * N ), W2( K * N );
+            Kernels::gemm( order, CblasTrans, CblasNoTrans, K, N, M, 1.0, Vf.data(), M, C, ldc, 0.0, W.data(), K );
+            Kernels::gemm( order, trans, CblasNoTrans, K, N, K, 1.0, Tf.data(), K, W.data(), K, 0.0, W2.data(), K );
+            Kernels::gemm( order, CblasNoTrans, CblasNoTrans, M, N, K, -1.0, Vf.data(), M, W2.data(), K, 1.0, C, ldc );
+        }
+        else {
+            // C = C - ( C * V ) * op( T ) * V^t
+            std::vector<double> W( M * K ), W2( M * K );
+            Kernels::gemm( order, CblasNoTrans, CblasNoTrans, M, K, N, 1.0, C, ldc, Vf.data(), N, 0.0, W.data(), M );
+            Kernels::gemm( order, CblasNoTrans, trans, M, K, K, 1.0, W.data(), M, Tf.data(), K, 0.0, W2.data(), M );
+            Kernels::gemm( order, CblasNoTrans, CblasTrans, M, N, K, -1.0, W2.data(), M, Vf.data(), N, 1.0, C, ldc );
+        }
+    }
+
+    // Rounds a double matrix to single precision, returns false if one of its entries overflows
+    inline bool dlag2s( int M, int N, const double *A, int lda, float *SA, int ldsa )
+    {
+        const double rmax = std::numeric_limits<float>::max();
+        for ( int j = 0; j < N; ++j ) {
+            for ( int i = 0; i < M; ++i ) {
+                double a = A[AT( i, j, lda )];
+                if ( a < -rmax || a > rmax ) { return false; }
+                SA[AT( i, j, ldsa )] = static_cast<float>( a );
+            }
+        }
+        return true;
+    }
+
+    // Mixed precision solve of A * X = B: LU factorization in single precision, then iterative refinement of X with
+    // residuals computed in double precision, falling back to dgesv when it does not converge. The O( N^2 ) copies
+    // and norms around the kernels are sequential, they are small next to the factorization.
+    template <class Kernels>
+    int dsgesv( CBLAS_ORDER   order,
+                int           N,
+                int           NRHS,
+                double *      A,
+                int           lda,
+                int *         ipiv,
+                const double *B,
+                int           ldb,
+                double *      X,
+                int           ldx,
+                int *         iter )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldx >= std::max( 1, N ) );
+
+        *iter = 0;
+        if ( N == 0 || NRHS == 0 ) { return 0; }
+
+        const int    itermax = 30;
+        const double eps     = std::numeric_limits<double>::epsilon() / 2.;
+
+        double anrm = 0.;
+        for ( int i = 0; i < N; ++i ) {
+            double s = 0.;
+            for ( int j = 0; j < N; ++j ) {
+                s += std::fabs( A[AT( i, j, lda )] );
+            }
+            anrm = std::max( anrm, s );
+        }
+        // A column has converged once its residual is below its backward error in double precision
+        const double cte = anrm * eps * std::sqrt( (double)N );
+
+        std::vector<float>  SA( N * N ), SX( N * NRHS );
+        std::vector<double> R( N * NRHS );
+        double              rprev = std::numeric_limits<double>::max();
+
+        if ( !dlag2s( N, N, A, lda, SA.data(), N ) ) {
+            *iter = -1;
+        }
+        else if ( Kernels::sgetrf( order, N, N, SA.data(), N, ipiv ) != 0 ) {
+            *iter = -2;
+        }
+        else if ( !dlag2s( N, NRHS, B, ldb, SX.data(), N ) ) {
+            *iter = -1;
+        }
+        else {
+            Kernels::sgetrs( order, N, NRHS, SA.data(), N, ipiv, SX.data(), N );
+            for ( int j = 0; j < NRHS; ++j ) {
+                for ( int i = 0; i < N; ++i ) {
+                    X[AT( i, j, ldx )] = SX[AT( i, j, N )];
+                }
+            }
+
+            for ( int it = 0; it <= itermax; ++it ) {
+                // R = B - A * X in double precision
+                for ( int j = 0; j < NRHS; ++j ) {
+                    std::copy( B + AT( 0, j, ldb ), B + AT( N, j, ldb ), R.begin() + AT( 0, j, N ) );
+                    Kernels::gemv( order,
+                                   CblasNoTrans,
+                                   N,
+                                   N,
+                                   -1.0,
+                                   A,
+                                   lda,
+                                   X + AT( 0, j, ldx ),
+                                   1,
+                                   1.0,
+                                   R.data() + AT( 0, j, N ),
+                                   1 );
+                }
+
+                bool   converged = true;
+                double rmax      = 0.;
+                for ( int j = 0; j < NRHS; ++j ) {
+                    double xnrm = 0., rnrm = 0.;
+                    for ( int i = 0; i < N; ++i ) {
+                        xnrm = std::max( xnrm, std::fabs( X[AT( i, j, ldx )] ) );
+                        rnrm = std::max( rnrm, std::fabs( R[AT( i, j, N )] ) );
+                    }
+                    converged = converged && ( rnrm <= xnrm * cte );
+                    rmax      = std::max( rmax, rnrm );
+                }
+                if ( converged ) {
+                    *iter = it;
+                    return 0;
+                }
+
+                // Refinement stalls when the residual no longer halves, A is too ill-conditioned for single precision
+                if ( it == itermax || rmax > 0.5 * rprev || !dlag2s( N, NRHS, R.data(), N, SX.data(), N ) ) {
+                    *iter = -3;
+                    break;
+                }
+                rprev = rmax;
+
+                // X = X + A^-1 * R, the correction being solved with the single precision factors
+                Kernels::sgetrs( order, N, NRHS, SA.data(), N, ipiv, SX.data(), N );
+                for ( int j = 0; j < NRHS; ++j ) {
+                    for ( int i = 0; i < N; ++i ) {
+                        X[AT( i, j, ldx )] += SX[AT( i, j, N )];
+                    }
+                }
+            }
+        }
+
+        // Fall back to the double precision factorization
+        for ( int j = 0; j < NRHS; ++j ) {
+            std::copy( B + AT( 0, j, ldb ), B + AT( N, j, ldb ), X + AT( 0, j, ldx ) );
+        }
+        return Kernels::gesv( order, N, NRHS, A, lda, ipiv, X, ldx );
+    }
+
+    // Solve of a diagonal block of order at most BLOCK_SIZE, by substitution or, when invA holds the inverses computed
+    // by my_dtrtri_diag, by a GEMM with the inverse of the block starting at k. work holds the copy of the block of B.
+    // The blocks are too small to share between threads, it is sequential and defined in my_lapack_seq.cpp, which the
+    // OpenMP library compiles too.
+    void dtrsmDiagonal( CBLAS_SIDE      side,
+                        CBLAS_UPLO      uplo,
+                        CBLAS_TRANSPOSE transA,
+                        CBLAS_DIAG      diag,
+                        int             M,
+                        int             N,
+                        double          alpha,
+                        const double *  A,
+                        int             lda,
+                        const double *  invA,
+                        int             k,
+                        double *        B,
+                        int             ldb,
+                        double *        work );
+
+    // Blocked triangular solve of my_dtrsm and my_dtrsm_inv, the GEMM updates being done by Kernels::gemm
+    template <class Kernels>
+    void dtrsmBlocked( CBLAS_SIDE      side,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE transA,
+                       CBLAS_DIAG      diag,
+                       int             M,
+                       int             N,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       const double *  invA,
+                       double *        B,
+                       int             ldb )
+    {
+        if ( M == 0 || N == 0 ) return;
+
+        const int nb = BLOCK_SIZE;
+        int       T  = ( side == CblasLeft ) ? M : N; // Order of the triangular matrix
+
+        if ( alpha == 0. ) {
+            for ( int j = 0; j < N; ++j ) {
+                std::fill( B + AT( 0, j, ldb ), B + AT( M, j, ldb ), 0. );
+            }
+            return;
+        }
+
+        std::vector<double> work;
+        if ( invA != nullptr ) { work.resize( static_cast<size_t>( nb ) * ( side == CblasLeft ? N : M ) ); }
+
+        // A single diagonal block takes alpha on its own
+        if ( T <= nb ) {
+            dtrsmDiagonal( side, uplo, transA, diag, M, N, alpha, A, lda, invA, 0, B, ldb, work.data() );
+            return;
+        }
+
+        if ( alpha != 1. ) {
+            for ( int j = 0; j < N; ++j ) {
+                for ( int i = 0; i < M; ++i ) {
+                    B[AT( i, j, ldb )] *= alpha;
+                }
+            }
+        }
+
+        // op( A ) is lower triangular: the blocks are solved first to last, otherwise last to first. The diagonal
+        // block is solved by the unblocked kernel, or by a GEMM with its inverse, and its contribution removed from
+        // the rest of B with one GEMM.
+        bool bLower   = ( uplo == CblasLower ) == ( transA == CblasNoTrans );
+        bool bForward = ( side == CblasLeft ) == bLower;
+        int  nbBlocks = ( T + nb - 1 ) / nb;
+
+        for ( int b = 0; b < nbBlocks; ++b ) {
+            int k  = ( bForward ? b : nbBlocks - 1 - b ) * nb;
+            int kb = std::min( nb, T - k );
+
+            if ( side == CblasLeft ) {
+                dtrsmDiagonal(
+                    side, uplo, transA, diag, kb, N, 1., A + AT( k, k, lda ), lda, invA, k, B + k, ldb, work.data() );
+                if ( bForward && k + kb < M ) {
+                    // B( k+kb:M, : ) -= op( A )( k+kb:M, k:k+kb ) * B( k:k+kb, : )
+                    Kernels::gemm( CblasColMajor,
+                                   transA,
+                                   CblasNoTrans,
+                                   M - k - kb,
+                                   N,
+                                   kb,
+                                   -1.,
+                                   uplo == CblasLower ? A + AT( k + kb, k, lda ) : A + AT( k, k + kb, lda ),
+                                   lda,
+                                   B + k,
+                                   ldb,
+                                   1.,
+                                   B + k + kb,
+                                   ldb );
+                }
+                else if ( !bForward && k > 0 ) {
+                    // B( 0:k, : ) -= op( A )( 0:k, k:k+kb ) * B( k:k+kb, : )
+                    Kernels::gemm( CblasColMajor,
+                                   transA,
+                                   CblasNoTrans,
+                                   k,
+                                   N,
+                                   kb,
+                                   -1.,
+                                   uplo == CblasUpper ? A + AT( 0, k, lda ) : A + AT( k, 0, lda ),
+                                   lda,
+                                   B + k,
+                                   ldb,
+                                   1.,
+                                   B,
+                                   ldb );
+                }
+            }
+            else {
+                dtrsmDiagonal( side,
+                               uplo,
+                               transA,
+                               diag,
+                               M,
+                               kb,
+                               1.,
+                               A + AT( k, k, lda ),
+                               lda,
+                               invA,
+                               k,
+                               B + AT( 0, k, ldb ),
+                               ldb,
+                               work.data() );
+                if ( bForward && k + kb < N ) {
+                    // B( :, k+kb:N ) -= B( :, k:k+kb ) * op( A )( k:k+kb, k+kb:N )
+                    Kernels::gemm( CblasColMajor,
+                                   CblasNoTrans,
+                                   transA,
+                                   M,
+                                   N - k - kb,
+                                   kb,
+                                   -1.,
+                                   B + AT( 0, k, ldb ),
+                                   ldb,
+                                   uplo == CblasUpper ? A + AT( k, k + kb, lda ) : A + AT( k + kb, k, lda ),
+                                   lda,
+                                   1.,
+                                   B + AT( 0, k + kb, ldb ),
+                                   ldb );
+                }
+                else if ( !bForward && k > 0 ) {
+                    // B( :, 0:k ) -= B( :, k:k+kb ) * op( A )( k:k+kb, 0:k )
+                    Kernels::gemm( CblasColMajor,
+                                   CblasNoTrans,
+                                   transA,
+                                   M,
+                                   k,
+                                   kb,
+                                   -1.,
+                                   B + AT( 0, k, ldb ),
+                                   ldb,
+                                   uplo == CblasLower ? A + AT( k, 0, lda ) : A + AT( 0, k, lda ),
+                                   lda,
+                                   1.,
+                                   B,
+                                   ldb );
+                }
+            }
+        }
+    }
+
+    // Columns factorized at once by dgbtrf. Bands with fewer subdiagonals are factorized column by column, their
+    // in-band updates being too small for the blocked ones to pay off.
+    static const int DGBTRF_BLOCK = 32;
+
+    // In band storage, the matrix is column-major with a leading dimension of ldab - 1, shifted by kv = KL + KU
+    // rows, and only valid on the diagonals it holds
+    inline double *bandAt( double *AB, int ldab, int kv, int i, int j )
+    {
+        return AB + kv + i + static_cast<size_t>( j ) * ( ldab - 1 );
+    }
+    inline const double *bandAt( const double *AB, int ldab, int kv, int i, int j )
+    {
+        return AB + kv + i + static_cast<size_t>( j ) * ( ldab - 1 );
+    }
+
+    // Copies the rows [ r0, r1 ) and columns [ c0, c1 ) of a band matrix into the dense W, or back when toBand is
+    // set. W is zero outside of the band, and only the band is written back.
+    inline void
+    bandWindow( bool toBand, int KL, int kv, double *AB, int ldab, int r0, int r1, int c0, int c1, double *W )
+    {
+        int ldw = r1 - r0;
+        for ( int c = c0; c < c1; ++c ) {
+            int     lo = std::max( r0, c - kv ), hi = std::min( r1, c + KL + 1 );
+            double *w  = W + static_cast<size_t>( c - c0 ) * ldw;
+            if ( lo >= hi ) {
+                if ( !toBand ) { std::fill( w, w + ldw, 0. ); }
+                continue;
+            }
+
+            double *band = bandAt( AB, ldab, kv, lo, c );
+            if ( toBand ) { std::copy( w + lo - r0, w + hi - r0, band ); }
+            else {
+                std::fill( w, w + lo - r0, 0. );
+                std::copy( band, band + hi - lo, w + lo - r0 );
+                std::fill( w + hi - r0, w + ldw, 0. );
+            }
+        }
+    }
+
+    // Unblocked banded LU, the rank-1 update of each column being restricted to the band. Its updates are too small
+    // to share between threads, it is sequential.
+    inline int dgbtf2( int N, int KL, int KU, double *AB, int ldab, int *ipiv )
+    {
+        int kv = KL + KU, info = 0;
+        int ju = 0; // Last column reached by the rows of U factorized so far
+
+        for ( int j = 0; j < N; ++j ) {
+            int     km  = std::min( KL, N - 1 - j );
+            double *col = bandAt( AB, ldab, kv, j, j );
+            int     p   = my_idamax_seq( km + 1, col, 1 );
+            ipiv[j]     = j + p;
+
+            // A zero column has nothing to eliminate
+            if ( col[p] == 0. ) {
+                if ( info == 0 ) { info = j + 1; }
+                continue;
+            }
+
+            ju = std::max( ju, std::min( N - 1, j + KU + p ) );
+            if ( p != 0 ) {
+                for ( int c = j; c <= ju; ++c ) {
+                    std::swap( *bandAt( AB, ldab, kv, j, c ), *bandAt( AB, ldab, kv, j + p, c ) );
+                }
+            }
+
+            if ( km > 0 && ju > j ) {
+                my_dscal_dger_seq( CblasColMajor,
+                                   km,
+                                   ju - j,
+                                   1. / col[0],
+                                   col + 1,
+                                   1,
+                                   -1.,
+                                   bandAt( AB, ldab, kv, j, j + 1 ),
+                                   ldab - 1,
+                                   bandAt( AB, ldab, kv, j + 1, j + 1 ),
+                                   ldab - 1 );
+            }
+            else if ( km > 0 ) {
+                my_dscal_seq( km, 1. / col[0], col + 1, 1 );
+            }
+        }
+
+        return info;
+    }
+
+    // Banded LU of my_dgbtrf. Each panel of DGBTRF_BLOCK columns is copied, with all the rows and columns it can
+    // reach, into a dense window where it is factorized by my_dgetf2_piv and applied to the rest of the window by
+    // Kernels::laswp, Kernels::trsm and Kernels::gemm. The window copies are O( KL * ( KL + KU ) ) per panel, about
+    // DGBTRF_BLOCK times less than its updates, and stay sequential.
+    template <class Kernels>
+    int dgbtrf( CBLAS_ORDER order, int N, int KL, int KU, double *AB, int ldab, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( KL );
+        LAHPC_CHECK_POSITIVE( KU );
+        LAHPC_CHECK_PREDICATE( ldab >= 2 * KL + KU + 1 );
+
+        if ( N == 0 ) { return 0; }
+
+        int kv = KL + KU;
+        for ( int j = 0; j < N; ++j ) {
+            std::fill( AB + static_cast<size_t>( j ) * ldab, AB + static_cast<size_t>( j ) * ldab + KL, 0. );
+        }
+
+        if ( KL < DGBTRF_BLOCK ) { return dgbtf2( N, KL, KU, AB, ldab, ipiv ); }
+
+        const int           nb   = DGBTRF_BLOCK;
+        int                 info = 0;
+        std::vector<double> W;
+        for ( int j0 = 0; j0 < N; j0 += nb ) {
+            int jb = std::min( nb, N - j0 );
+            int r1 = std::min( N, j0 + jb + KL ), c1 = std::min( N, j0 + jb + kv );
+            int wm = r1 - j0, wn = c1 - j0;
+            W.resize( static_cast<size_t>( wm ) * wn );
+            bandWindow( false, KL, kv, AB, ldab, j0, r1, j0, c1, W.data() );
+
+            int iinfo = my_dgetf2_piv_seq( CblasColMajor, wm, jb, W.data(), wm, ipiv + j0 );
+            if ( info == 0 && iinfo > 0 ) { info = iinfo + j0; }
+
+            if ( wn > jb ) {
+                double *W12 = W.data() + static_cast<size_t>( jb ) * wm;
+                Kernels::laswp( wn - jb, W12, wm, 0, jb - 1, ipiv + j0, 1 );
+                Kernels::trsm( CblasColMajor,
+                               CblasLeft,
+                               CblasLower,
+                               CblasNoTrans,
+                               CblasUnit,
+                               jb,
+                               wn - jb,
+                               1.,
+                               W.data(),
+                               wm,
+                               W12,
+                               wm );
+                if ( wm > jb ) {
+                    Kernels::gemm( CblasColMajor,
+                                   CblasNoTrans,
+                                   CblasNoTrans,
+                                   wm - jb,
+                                   wn - jb,
+                                   jb,
+                                   -1.,
+                                   W.data() + jb,
+                                   wm,
+                                   W12,
+                                   wm,
+                                   1.,
+                                   W12 + jb,
+                                   wm );
+                }
+            }
+
+            // The multipliers of a column are kept without the interchanges of the later columns of the panel,
+            // which also brings them back inside the band
+            for ( int jj = jb - 1; jj > 0; --jj ) {
+                int p = ipiv[j0 + jj];
+                if ( p != jj ) {
+                    for ( int c = 0; c < jj; ++c ) {
+                        std::swap( W[static_cast<size_t>( c ) * wm + jj], W[static_cast<size_t>( c ) * wm + p] );
+                    }
+                }
+            }
+
+            bandWindow( true, KL, kv, AB, ldab, j0, r1, j0, c1, W.data() );
+            for ( int jj = 0; jj < jb; ++jj ) {
+                ipiv[j0 + jj] += j0;
+            }
+        }
+
+        return info;
+    }
+
+    // Number of BLOCK_SIZE tiles along a dimension n
+    inline int tileCount( int n ) { return ( n + BLOCK_SIZE - 1 ) / BLOCK_SIZE; }
+
+    // Whether both tiles of op( A ) and op( B ) of the kth product of C tile ( m, n ) in my_dgemm_masked are nonzero
+    inline bool tileProductNonzero( bool                 bTransA,
+                                    bool                 bTransB,
+                                    int                  m,
+                                    int                  n,
+                                    int                  k,
+                                    int                  MT,
+                                    int                  NT,
+                                    int                  KT,
+                                    const unsigned char *maskA,
+                                    const unsigned char *maskB )
+    {
+        bool a = bTransA ? maskA[k + m * KT] : maskA[m + k * MT];
+        bool b = bTransB ? maskB[n + k * NT] : maskB[k + n * KT];
+        return a && b;
+    }
+
+    // Blocks of a matrix in RFP storage, see my_lapack.h: the lower triangle T1 of order n1, the upper triangle T2
+    // of order n2 and the off-diagonal block S start at these offsets of a rectangle of leading dimension ld
+    struct RfpBlocks {
+        int    n1, n2, ld;
+        size_t t1, t2, s;
+    };
+
+    // Rows of the off-diagonal block copied at once by pftrf
+    static const int RFP_PANEL = 128;
+
+    inline RfpBlocks rfpLayout( CBLAS_UPLO uplo, int N )
+    {
+        RfpBlocks b;
+        bool      odd = ( N % 2 == 1 );
+        b.n1          = ( uplo == CblasLower ) ? N - N / 2 : N / 2;
+        b.n2          = N - b.n1;
+        b.ld          = odd ? N : N + 1;
+        if ( uplo == CblasLower ) {
+            b.t1 = odd ? 0 : 1;
+            b.t2 = odd ? N : 0;
+            b.s  = b.t1 + b.n1;
+        }
+        else {
+            b.t1 = odd ? b.n2 : b.n1 + 1;
+            b.t2 = b.n1;
+            b.s  = 0;
+        }
+        return b;
+    }
+
+    // dst( j, i ) = src( i, j ) on the lower triangle of src when lower is set, on its upper triangle otherwise, for
+    // the columns of BLOCK_SIZE tiles [ t0, t1 ) of src. The triangle is walked by tiles so that the strided side of
+    // the copy stays in cache, and the OpenMP version can give whole columns of tiles to its threads.
+    inline void transposeTriangle( bool lower, int N, const double *src, int lds, double *dst, int ldd, int t0, int t1 )
+    {
+        for ( int t = t0; t < t1; ++t ) {
+            int j0 = t * BLOCK_SIZE, jEnd = std::min( N, j0 + BLOCK_SIZE );
+            for ( int i0 = lower ? j0 : 0; i0 < ( lower ? N : jEnd ); i0 += BLOCK_SIZE ) {
+                for ( int j = j0; j < jEnd; ++j ) {
+                    int lo = lower ? std::max( i0, j ) : i0;
+                    int hi = lower ? std::min( N, i0 + BLOCK_SIZE ) : std::min( i0 + BLOCK_SIZE, j + 1 );
+                    for ( int i = lo; i < hi; ++i ) {
+                        dst[AT( j, i, ldd )] = src[AT( i, j, lds )];
+                    }
+                }
+            }
+        }
+    }
+
+    // Cholesky factorization A = U^t * U of an upper triangle, the transpose of my_dpotrf, for the T2 block of the
+    // RFP storage. The diagonal blocks are factorized row by row by the sequential kernels, the updates of the rows
+    // they reach by Kernels.
+    template <class Kernels>
+    int dpotrfUpper( int N, double *A, int lda )
+    {
+        const int           nb = BLOCK_SIZE;
+        std::vector<double> W;
+
+        for ( int j = 0; j < N; j += nb ) {
+            int jb = std::min( N - j, nb );
+
+            for ( int k = j; k < j + jb; ++k ) {
+                double akk = A[AT( k, k, lda )] - my_ddot_seq( k - j, A + AT( j, k, lda ), 1, A + AT( j, k, lda ), 1 );
+                if ( akk <= 0. || std::isnan( akk ) ) {
+                    A[AT( k, k, lda )] = akk;
+                    return k + 1;
+                }
+                akk                = std::sqrt( akk );
+                A[AT( k, k, lda )] = akk;
+
+                int nr = j + jb - k - 1;
+                if ( nr > 0 ) {
+                    // A( k, k+1:j+jb ) -= A( j:k, k )^t * A( j:k, k+1:j+jb )
+                    my_dgemv_seq( CblasColMajor,
+                                  CblasTrans,
+                                  k - j,
+                                  nr,
+                                  -1.,
+                                  A + AT( j, k + 1, lda ),
+                                  lda,
+                                  A + AT( j, k, lda ),
+                                  1,
+                                  1.,
+                                  A + AT( k, k + 1, lda ),
+                                  lda );
+                    my_dscal_seq( nr, 1. / akk, A + AT( k, k + 1, lda ), lda );
+                }
+            }
+
+            if ( j + jb < N ) {
+                // The block row is updated transposed, as the block column of my_dpotrf: U12^t = A12^t * U11^-1,
+                // then A22 -= U12^t * U12, the slower transposed products being avoided
+                int nr = N - j - jb;
+                W.resize( static_cast<size_t>( nr ) * jb );
+                Kernels::lacpyTrans( jb, nr, A + AT( j, j + jb, lda ), lda, W.data(), nr );
+                Kernels::trsm( CblasColMajor,
+                               CblasRight,
+                               CblasUpper,
+                               CblasNoTrans,
+                               CblasNonUnit,
+                               nr,
+                               jb,
+                               1.,
+                               A + AT( j, j, lda ),
+                               lda,
+                               W.data(),
+                               nr );
+                Kernels::syrk( CblasColMajor,
+                               CblasUpper,
+                               CblasNoTrans,
+                               nr,
+                               jb,
+                               -1.,
+                               W.data(),
+                               nr,
+                               1.,
+                               A + AT( j + jb, j + jb, lda ),
+                               lda );
+                Kernels::lacpyTrans( nr, jb, W.data(), nr, A + AT( j, j + jb, lda ), lda );
+            }
+        }
+
+        return 0;
+    }
+
+    // Cholesky factorization of my_dpftrf on the blocks of the RFP storage
+    template <class Kernels>
+    int pftrf( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, double *ARF )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_POSITIVE( N );
+
+        if ( N == 0 ) { return 0; }
+
+        RfpBlocks b  = rfpLayout( uplo, N );
+        double *  T1 = ARF + b.t1, *T2 = ARF + b.t2, *S = ARF + b.s;
+
+        // A11 = L11 * L11^t, the factor of A11^t = U11^t * U11 for Upper being the same
+        int info = Kernels::potrf( order, b.n1, T1, b.ld );
+        if ( info > 0 ) { return info; }
+        if ( b.n1 == 0 || b.n2 == 0 ) { return dpotrfUpper<Kernels>( b.n2, T2, b.ld ); }
+
+        // The transposed products of the off-diagonal block run on transposed copies of RFP_PANEL of its rows at a
+        // time instead, the right-side TRSM and the transposed SYRK being slower than their counterparts
+        std::vector<double> W( static_cast<size_t>( RFP_PANEL ) * std::max( b.n1, b.n2 ) );
+        if ( uplo == CblasLower ) {
+            // L21 = A21 * L11^-t, row by row, as L21^t = L11^-1 * A21^t, then A22^t -= L21 * L21^t
+            for ( int r = 0; r < b.n2; r += RFP_PANEL ) {
+                int rb = std::min( RFP_PANEL, b.n2 - r );
+                Kernels::lacpyTrans( rb, b.n1, S + r, b.ld, W.data(), b.n1 );
+                Kernels::trsm(
+                    order, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, b.n1, rb, 1., T1, b.ld, W.data(), b.n1 );
+                Kernels::lacpyTrans( b.n1, rb, W.data(), b.n1, S + r, b.ld );
+            }
+            Kernels::syrk( order, CblasUpper, CblasNoTrans, b.n2, b.n1, -1., S, b.ld, 1., T2, b.ld );
+        }
+        else {
+            // U12 = U11^-t * A12, then A22 -= U12^t * U12 as the sum of the products of its blocks of rows
+            Kernels::trsm(
+                order, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, b.n1, b.n2, 1., T1, b.ld, S, b.ld );
+            for ( int r = 0; r < b.n1; r += RFP_PANEL ) {
+                int rb = std::min( RFP_PANEL, b.n1 - r );
+                Kernels::lacpyTrans( rb, b.n2, S + r, b.ld, W.data(), b.n2 );
+                Kernels::syrk( order, CblasUpper, CblasNoTrans, b.n2, rb, -1., W.data(), b.n2, 1., T2, b.ld );
+            }
+        }
+
+        // The trailing factor is L22^t for Lower, U22 for Upper
+        info = dpotrfUpper<Kernels>( b.n2, T2, b.ld );
+        return info > 0 ? info + b.n1 : 0;
+    }
+
+    // Triangular solve of my_dtfsm: two TRSM on the diagonal blocks of the RFP storage and a GEMM with the
+    // off-diagonal one
+    template <class Kernels>
+    void tfsm( CBLAS_ORDER     order,
+               CBLAS_SIDE      side,
+               CBLAS_UPLO      uplo,
+               CBLAS_TRANSPOSE trans,
+               CBLAS_DIAG      diag,
+               int             M,
+               int             N,
+               double          alpha,
+               const double *  ARF,
+               double *        B,
+               int             ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return; }
+
+        bool          bLeft = ( side == CblasLeft );
+        RfpBlocks     b     = rfpLayout( uplo, bLeft ? M : N );
+        const double *T1 = ARF + b.t1, *T2 = ARF + b.t2, *S = ARF + b.s;
+
+        // op( A ) is the 2-by-2 block triangular matrix of diagonal blocks op( T1 ), T1 being stored lower, and
+        // op( T2 ), T2 being stored upper, with op( S ) below them when op( A ) is lower triangular and above them
+        // otherwise. B1 and B2 are the matching row blocks of B, or column blocks for CblasRight.
+        bool            bLower  = ( uplo == CblasLower ) == ( trans == CblasNoTrans );
+        bool            bFirst1 = ( bLeft == bLower );
+        CBLAS_TRANSPOSE trans1  = bLower ? CblasNoTrans : CblasTrans;
+        CBLAS_TRANSPOSE trans2  = bLower ? CblasTrans : CblasNoTrans;
+        int             m1 = bLeft ? b.n1 : M, n1 = bLeft ? N : b.n1;
+        int             m2 = bLeft ? b.n2 : M, n2 = bLeft ? N : b.n2;
+        double *        B1 = B, *B2 = bLeft ? B + b.n1 : B + AT( 0, b.n1, ldb );
+
+        // The block solved first also scales the other one, through the update by its solution
+        double *X = bFirst1 ? B1 : B2, *Y = bFirst1 ? B2 : B1;
+        int     mY = bFirst1 ? m2 : m1, nY = bFirst1 ? n2 : n1, kXY = bFirst1 ? b.n1 : b.n2;
+        if ( bFirst1 ) { Kernels::trsm( order, side, CblasLower, trans1, diag, m1, n1, alpha, T1, b.ld, B1, ldb ); }
+        else {
+            Kernels::trsm( order, side, CblasUpper, trans2, diag, m2, n2, alpha, T2, b.ld, B2, ldb );
+        }
+
+        double alphaY = alpha;
+        if ( kXY > 0 && mY > 0 && nY > 0 ) {
+            // Y = alpha * Y - op( S ) * X, or - X * op( S )
+            if ( bLeft ) {
+                Kernels::gemm( order, trans, CblasNoTrans, mY, nY, kXY, -1., S, b.ld, X, ldb, alpha, Y, ldb );
+            }
+            else {
+                Kernels::gemm( order, CblasNoTrans, trans, mY, nY, kXY, -1., X, ldb, S, b.ld, alpha, Y, ldb );
+            }
+            alphaY = 1.;
+        }
+
+        if ( bFirst1 ) { Kernels::trsm( order, side, CblasUpper, trans2, diag, m2, n2, alphaY, T2, b.ld, B2, ldb ); }
+        else {
+            Kernels::trsm( order, side, CblasLower, trans1, diag, m1, n1, alphaY, T1, b.ld, B1, ldb );
+        }
+    }
+
+    // Solve of my_dpftrs with the factor of pftrf: L * L^t * X = B, or U^t * U * X = B
+    template <class Kernels>
+    void pftrs( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, int NRHS, const double *ARF, double *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+
+        CBLAS_TRANSPOSE first = ( uplo == CblasLower ) ? CblasNoTrans : CblasTrans;
+        CBLAS_TRANSPOSE last  = ( uplo == CblasLower ) ? CblasTrans : CblasNoTrans;
+        tfsm<Kernels>( order, CblasLeft, uplo, first, CblasNonUnit, N, NRHS, 1., ARF, B, ldb );
+        tfsm<Kernels>( order, CblasLeft, uplo, last, CblasNonUnit, N, NRHS, 1., ARF, B, ldb );
+    }
+
+    // Rank-k update of my_dsfrk. op( A ) is split into the row blocks A1 and A2 of n1 and n2 rows, column blocks of A
+    // when transposed. C11 and C22 are updated in place by SYRK whatever uplo, and C21 = S for Lower, or C12 = S for
+    // Upper, by GEMM.
+    template <class Kernels>
+    void sfrk( CBLAS_ORDER     order,
+               CBLAS_UPLO      uplo,
+               CBLAS_TRANSPOSE trans,
+               int             N,
+               int             K,
+               double          alpha,
+               const double *  A,
+               int             lda,
+               double          beta,
+               double *        CRF )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, trans == CblasNoTrans ? N : K ) );
+
+        if ( N == 0 ) { return; }
+
+        RfpBlocks     b      = rfpLayout( uplo, N );
+        bool          bTrans = ( trans == CblasTrans );
+        const double *A1 = A, *A2 = bTrans ? A + AT( 0, b.n1, lda ) : A + b.n1;
+        Kernels::syrk( order, CblasLower, trans, b.n1, K, alpha, A1, lda, beta, CRF + b.t1, b.ld );
+        Kernels::syrk( order, CblasUpper, trans, b.n2, K, alpha, A2, lda, beta, CRF + b.t2, b.ld );
+
+        bool          bLower = ( uplo == CblasLower );
+        const double *P = bLower ? A2 : A1, *Q = bLower ? A1 : A2;
+        int           mS = bLower ? b.n2 : b.n1, nS = bLower ? b.n1 : b.n2;
+        if ( mS > 0 && nS > 0 ) {
+            Kernels::gemm( order,
+                           trans,
+                           bTrans ? CblasNoTrans : CblasTrans,
+                           mS,
+                           nS,
+                           K,
+                           alpha,
+                           P,
+                           lda,
+                           Q,
+                           lda,
+                           beta,
+                           CRF + b.s,
+                           b.ld );
+        }
+    }
+
+} // namespace my_lapack
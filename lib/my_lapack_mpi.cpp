@@ -4,35 +4,64 @@
 #include "util.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <mpi.h>
 #include <vector>
 
 /* Access matrix elements provided storage is COLUMN MAJOR */
-#define A( i, j ) ( a[j * lda + i] )
-#define B( i, j ) ( b[j * ldb + i] )
-#define C( i, j ) ( c[j * ldc + i] )
+#define A( i, j ) ( a[( j ) * lda + ( i )] )
+#define B( i, j ) ( b[( j ) * ldb + ( i )] )
+#define C( i, j ) ( c[( j ) * ldc + ( i )] )
+
+/* Size of the blocks of the 2-D block-cyclic distribution, the one of the blocked kernels */
+static const int BLOCK_SIZE = _LAHPC_BLOCK_SIZE;
 
 namespace my_lapack
 {
 
-    void my_dlacpy(int M, int N, const double* a, int lda, double* b, int ldb)
+    void init_lapack_mpi(int* argc, char*** argv) { Summa::getInstance().init(argc, argv); }
+
+    /* One step of SUMMA: C += alpha * A_panel * B_panel.
+       The m-by-k panel of A lives on the process column icurcol and is broadcast along the process rows,
+       the k-by-n panel of B lives on the process row icurrow and is broadcast along the process columns. */
+    static void summa_step(int           m,
+                           int           n,
+                           int           k,
+                           double        alpha,
+                           const double* a,
+                           int           lda,
+                           const double* b,
+                           int           ldb,
+                           double* c,
+                           int           ldc,
+                           int           icurrow,
+                           int           icurcol,
+                           MPI_Comm      comm_row,
+                           MPI_Comm      comm_col,
+                           double* work1,
+                           double* work2)
     {
-        LAHPC_CHECK_POSITIVE(M);
-        LAHPC_CHECK_POSITIVE(N);
-        LAHPC_CHECK_PREDICATE(lda >= std::max(1, M));
-        LAHPC_CHECK_PREDICATE(ldb >= std::max(1, M));
+        int myrow, mycol;
 
-        for (int j = 0; j < N; ++j)
-        {
-            for (int i = 0; i < M; ++i)
-            {
-                B(i, j) = A(i, j);
-            }
-        }
-    }
+        Summa& SUMMA = Summa::getInstance();
 
-    void init_lapack_mpi(int* argc, char*** argv) { Summa::getInstance().init(argc, argv); }
+        MPI_Comm_rank(comm_row, &mycol);
+        MPI_Comm_rank(comm_col, &myrow);
+
+        int ldw1 = std::max(1, m);
+        int ldw2 = std::max(1, k);
+
+        if (mycol == icurcol) my_dlacpy(m, k, a, lda, work1, ldw1);
+        if (myrow == icurrow) my_dlacpy(k, n, b, ldb, work2, ldw2);
+
+        /* broadcast work1 and work2*/
+        SUMMA.Bcast(work1, m * k, icurcol, comm_row);
+        SUMMA.Bcast(work2, n * k, icurrow, comm_col);
+
+        my_dgemm_seq(
+            CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, alpha, work1, ldw1, work2, ldw2, 1., c, ldc);
+    }
 
     void pdgemm(int           m,
                 int           n,
@@ -61,8 +90,6 @@ namespace my_lapack
         /*double* temp;
         double* p;*/
 
-        Summa& SUMMA = Summa::getInstance();
-
         MPI_Comm_rank(comm_row, &mycol);
         MPI_Comm_rank(comm_col, &myrow);
 
@@ -82,27 +109,22 @@ namespace my_lapack
             iwrk = std::min(nb, m_b[icurrow] - ii);
             iwrk = std::min(iwrk, n_a[icurcol] - jj);
 
-            if (mycol == icurcol) my_dlacpy(m_a[myrow], iwrk, &A(0, jj), lda, work1, m_a[myrow]);
-            if (myrow == icurrow) my_dlacpy(iwrk, n_b[mycol], &B(ii, 0), ldb, work2, iwrk);
-
-            /* broadcast work1 and work2*/
-            SUMMA.Bcast(work1, m_a[myrow] * iwrk, icurcol, comm_row);
-            SUMMA.Bcast(work2, n_b[mycol] * iwrk, icurrow, comm_col);
-
-            my_dgemm_seq(CblasColMajor,
-                         CblasNoTrans,
-                         CblasNoTrans,
-                         m_c[myrow],
-                         n_c[mycol],
-                         iwrk,
-                         alpha,
-                         work1,
-                         m_b[myrow],
-                         work2,
-                         iwrk,
-                         1.,
-                         c,
-                         ldc);
+            summa_step(m_c[myrow],
+                       n_c[mycol],
+                       iwrk,
+                       alpha,
+                       &A(0, jj),
+                       lda,
+                       &B(ii, 0),
+                       ldb,
+                       c,
+                       ldc,
+                       icurrow,
+                       icurcol,
+                       comm_row,
+                       comm_col,
+                       work1,
+                       work2);
 
             ii += iwrk;
             jj += iwrk;
@@ -290,4 +312,297 @@ namespace my_lapack
         delete[] work1;
         delete[] work2;
     }
+
+    /* Number of rows (or columns) of a n-long dimension distributed block-cyclically by blocks of nb over nprocs
+       processes which are owned by the process iproc. Also gives the local index of the first global index >= n. */
+    static int numroc(int n, int nb, int iproc, int nprocs)
+    {
+        int nblocks = n / nb;
+        int count   = (nblocks / nprocs) * nb;
+        int extra   = nblocks % nprocs;
+
+        if (iproc < extra) { count += nb; }
+        else if (iproc == extra) { count += n % nb; }
+        return count;
+    }
+
+    /* Process owning the global row (or column) g, and index of g on that process */
+    static int indxg2p(int g, int nb, int nprocs) { return (g / nb) % nprocs; }
+    static int indxg2l(int g, int nb, int nprocs) { return (g / (nb * nprocs)) * nb + g % nb; }
+
+    /* Global index of the local row (or column) l of the process iproc */
+    static int indxl2g(int l, int nb, int iproc, int nprocs) { return ((l / nb) * nprocs + iproc) * nb + l % nb; }
+
+    /* Swaps the global rows r1 and r2 over the local columns [c0, c1) of every process of the process column comm_col.
+       When the two rows live on different processes they exchange them through buf, of at least c1 - c0 doubles. */
+    static void swap_rows(int r1, int r2, int nb, int c0, int c1, double* a, int lda, MPI_Comm comm_col, double* buf)
+    {
+        if (r1 == r2 || c0 >= c1) { return; }
+
+        int myrow, nprow;
+        MPI_Comm_rank(comm_col, &myrow);
+        MPI_Comm_size(comm_col, &nprow);
+
+        int p1 = indxg2p(r1, nb, nprow);
+        int p2 = indxg2p(r2, nb, nprow);
+        int l1 = indxg2l(r1, nb, nprow);
+        int l2 = indxg2l(r2, nb, nprow);
+
+        if (myrow != p1 && myrow != p2) { return; }
+        if (p1 == p2)
+        {
+            for (int j = c0; j < c1; ++j) { std::swap(A(l1, j), A(l2, j)); }
+            return;
+        }
+
+        int l     = myrow == p1 ? l1 : l2;
+        int other = myrow == p1 ? p2 : p1;
+
+        for (int j = c0; j < c1; ++j) { buf[j - c0] = A(l, j); }
+        MPI_Sendrecv_replace(buf, c1 - c0, MPI_DOUBLE, other, 0, other, 0, comm_col, MPI_STATUS_IGNORE);
+        for (int j = c0; j < c1; ++j) { A(l, j) = buf[j - c0]; }
+    }
+
+    /* Unblocked LU of the panel made of the global columns [kk, kk + kb), stored in the local columns [ic, ic + kb)
+       of the process column comm_col, which calls it collectively. For each column, the pivot is the first entry of
+       largest magnitude at or below the diagonal, found with a MAXLOC reduction over the process column. Its row is
+       swapped with the diagonal one across the panel, then broadcast to scale the column and update the rest of the
+       panel. ipiv[ j ] receives the global pivot row of column j; when ipiv is null the panel is not pivoted.
+       info is set to j + 1 for the first exactly zero pivot if it is still 0. */
+    static void pdgetf2(int m, int kk, int kb, int nb, int ic, double* a, int lda, int* ipiv, int* info,
+                        MPI_Comm comm_col, double* work)
+    {
+        int myrow, nprow;
+        MPI_Comm_rank(comm_col, &myrow);
+        MPI_Comm_size(comm_col, &nprow);
+
+        Summa& SUMMA = Summa::getInstance();
+
+        int mloc = numroc(m, nb, myrow, nprow);
+
+        for (int j = kk; j < kk + kb; ++j)
+        {
+            int jc  = ic + j - kk;
+            int len = kb - (j - kk);
+
+            if (ipiv)
+            {
+                struct
+                {
+                    double val;
+                    int    row;
+                } loc = { -1., j }, piv;
+
+                for (int i = numroc(j, nb, myrow, nprow); i < mloc; ++i)
+                {
+                    if (std::fabs(A(i, jc)) > loc.val)
+                    {
+                        loc.val = std::fabs(A(i, jc));
+                        loc.row = indxl2g(i, nb, myrow, nprow);
+                    }
+                }
+                // Ties go to the lowest row, so this is the first maximum as with my_idamax
+                MPI_Allreduce(&loc, &piv, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm_col);
+
+                ipiv[j] = piv.row;
+                swap_rows(j, piv.row, nb, ic, ic + kb, a, lda, comm_col, work);
+            }
+
+            int pj = indxg2p(j, nb, nprow);
+            if (myrow == pj)
+            {
+                int lj = indxg2l(j, nb, nprow);
+                for (int c = 0; c < len; ++c) { work[c] = A(lj, jc + c); }
+            }
+            SUMMA.Bcast(work, len, pj, comm_col);
+
+            if (work[0] == 0. && *info == 0) { *info = j + 1; }
+
+            int ir2 = numroc(j + 1, nb, myrow, nprow);
+            my_dscal_dger_seq(CblasColMajor,
+                              mloc - ir2,
+                              len - 1,
+                              work[0] != 0. ? 1. / work[0] : 1.,
+                              &A(ir2, jc),
+                              1,
+                              -1.,
+                              work + 1,
+                              1,
+                              &A(ir2, jc + 1),
+                              lda);
+        }
+    }
+
+    /* LU factorization with partial pivoting P * A = L * U of a m-by-n matrix distributed 2-D block-cyclically by
+       nb-by-nb blocks over the process grid described by comm_row and comm_col. Block (I, J) is owned by the process
+       (I % r, J % c). For each block column:
+         - its process column factorizes the panel with pdgetf2, pivoting over the process column,
+         - the pivots are broadcast along the process rows and every process applies the interchanges to its other
+           local columns, on both sides of the panel,
+         - the diagonal block is broadcast along its process row, which computes U12 = L11^-1 * A12,
+         - the trailing matrix is updated with one SUMMA step: L21 is broadcast along the process rows,
+           U12 along the process columns, and each process performs A22 -= L21 * U12 on its local blocks. */
+    int pdgetrf(int m, int n, int nb, double* a, int lda, int* ipiv, MPI_Comm comm_row, MPI_Comm comm_col)
+    {
+        int myrow, mycol, nprow, npcol;
+
+        Summa& SUMMA = Summa::getInstance();
+
+        MPI_Comm_rank(comm_row, &mycol);
+        MPI_Comm_size(comm_row, &npcol);
+        MPI_Comm_rank(comm_col, &myrow);
+        MPI_Comm_size(comm_col, &nprow);
+
+        int mloc  = numroc(m, nb, myrow, nprow);
+        int nloc  = numroc(n, nb, mycol, npcol);
+        int minMN = std::min(m, n);
+        int info  = 0;
+
+        std::vector<double> diag(nb * nb);
+        std::vector<double> work1(std::max(1, mloc) * nb);
+        std::vector<double> work2(nb * std::max(1, nloc));
+        std::vector<double> row(std::max(nb, nloc));
+        std::vector<int>    piv(nb + 1);
+
+        for (int k = 0, kk = 0; kk < minMN; ++k, kk += nb)
+        {
+            int kb   = std::min(nb, minMN - kk);
+            int prow = k % nprow;
+            int pcol = k % npcol;
+
+            /* Local indices of the diagonal block and of the trailing matrix */
+            int ir  = numroc(kk, nb, myrow, nprow);
+            int ic  = numroc(kk, nb, mycol, npcol);
+            int ir2 = numroc(kk + kb, nb, myrow, nprow);
+            int ic2 = numroc(kk + kb, nb, mycol, npcol);
+
+            int mtrail = mloc - ir2;
+            int ntrail = nloc - ic2;
+
+            if (mycol == pcol) { pdgetf2(m, kk, kb, nb, ic, a, lda, ipiv, &info, comm_col, row.data()); }
+
+            // The pivots of the panel and the first zero pivot are known on its process column only
+            if (mycol == pcol)
+            {
+                if (ipiv) { std::copy(ipiv + kk, ipiv + kk + kb, piv.begin()); }
+                piv[kb] = info;
+            }
+            MPI_Bcast(piv.data(), kb + 1, MPI_INT, pcol, comm_row);
+            info = piv[kb];
+
+            if (ipiv)
+            {
+                std::copy(piv.begin(), piv.begin() + kb, ipiv + kk);
+                for (int j = kk; j < kk + kb; ++j)
+                {
+                    if (mycol == pcol)
+                    {
+                        swap_rows(j, ipiv[j], nb, 0, ic, a, lda, comm_col, row.data());
+                        swap_rows(j, ipiv[j], nb, ic + kb, nloc, a, lda, comm_col, row.data());
+                    }
+                    else { swap_rows(j, ipiv[j], nb, 0, nloc, a, lda, comm_col, row.data()); }
+                }
+            }
+
+            if (myrow == prow && mycol == pcol) { my_dlacpy(kb, kb, &A(ir, ic), lda, diag.data(), kb); }
+            if (myrow == prow) { SUMMA.Bcast(diag.data(), kb * kb, pcol, comm_row); }
+
+            if (myrow == prow && ntrail > 0)
+            {
+                my_dtrsm_seq(CblasColMajor,
+                             CblasLeft,
+                             CblasLower,
+                             CblasNoTrans,
+                             CblasUnit,
+                             kb,
+                             ntrail,
+                             1.,
+                             diag.data(),
+                             kb,
+                             &A(ir, ic2),
+                             lda);
+            }
+
+            summa_step(mtrail,
+                       ntrail,
+                       kb,
+                       -1.,
+                       &A(ir2, ic),
+                       lda,
+                       &A(ir, ic2),
+                       lda,
+                       &A(ir2, ic2),
+                       lda,
+                       prow,
+                       pcol,
+                       comm_row,
+                       comm_col,
+                       work1.data(),
+                       work2.data());
+        }
+
+        return info;
+    }
+
+    /* Sends the blocks of the m-by-n matrix a held by the root to their owners in the 2-D block-cyclic distribution
+       by nb-by-nb blocks of pdgetrf, local matrix a_local of leading dimension lld, or gathers them back. */
+    static void scatter_gather(bool scatter, int m, int n, int nb, double* a, int lda, double* a_local, int lld)
+    {
+        Summa& SUMMA = Summa::getInstance();
+
+        int rankWorld = SUMMA.rankWorld();
+        int rowCount, colCount;
+        SUMMA.gridDimensions(&rowCount, &colCount);
+
+        for (int J = 0; J * nb < n; ++J)
+        {
+            for (int I = 0; I * nb < m; ++I)
+            {
+                int     owner = (I % rowCount) * colCount + J % colCount;
+                int     mb    = std::min(nb, m - I * nb);
+                int     nbj   = std::min(nb, n - J * nb);
+                double* glob  = rankWorld == 0 ? &A(I * nb, J * nb) : nullptr;
+                double* loc   = rankWorld == owner ? &a_local[(J / colCount) * nb * lld + (I / rowCount) * nb] : nullptr;
+
+                if (scatter) { SUMMA.sendBlockWorld(0, owner, mb, nbj, glob, lda, loc, lld); }
+                else { SUMMA.sendBlockWorld(owner, 0, mb, nbj, loc, lld, glob, lda); }
+            }
+        }
+    }
+
+    /* Scatters A from the root by BLOCK_SIZE blocks, runs pdgetrf with or without pivoting and gathers the factors */
+    static int dgetrf_root(int M, int N, double* a, int lda, int* ipiv)
+    {
+        // SUMMA.reset( M, N, K ); Must have been done before !
+        LAHPC_CHECK_POSITIVE(M);
+        LAHPC_CHECK_POSITIVE(N);
+
+        Summa& SUMMA = Summa::getInstance();
+
+        int rowCount, colCount;
+        SUMMA.gridDimensions(&rowCount, &colCount);
+
+        if (SUMMA.rankWorld() == 0) LAHPC_CHECK_PREDICATE(lda >= std::max(1, M));
+
+        const int nb = BLOCK_SIZE;
+
+        int mloc = numroc(M, nb, SUMMA.rankRow(), rowCount);
+        int nloc = numroc(N, nb, SUMMA.rankCol(), colCount);
+        int lld  = std::max(1, mloc);
+
+        std::vector<double> A_local(lld * nloc);
+
+        scatter_gather(true, M, N, nb, a, lda, A_local.data(), lld);
+        int info = pdgetrf(M, N, nb, A_local.data(), lld, ipiv, SUMMA.getRowComm(), SUMMA.getColComm());
+        scatter_gather(false, M, N, nb, a, lda, A_local.data(), lld);
+
+        return info;
+    }
+
+    void my_dgetrf_mpi(CBLAS_ORDER order, int M, int N, double* a, int lda) { dgetrf_root(M, N, a, lda, nullptr); }
+
+    int my_dgetrf_piv_mpi(CBLAS_ORDER order, int M, int N, double* a, int lda, int* ipiv)
+    {
+        return dgetrf_root(M, N, a, lda, ipiv);
+    }
 } // namespace my_lapack
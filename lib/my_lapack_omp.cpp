@@ -1,7 +1,7 @@
-#include "err.h"
-#include "my_lapack.h"
+#include "my_lapack_internal.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -9,17 +9,41 @@
 #include <limits>
 #include <omp.h>
 #include <utility>
+#include <vector>
 
-#define _LAHPC_BLOCK_SIZE 34
-static const int BLOCK_SIZE = _LAHPC_BLOCK_SIZE;
+// Below this many elements, BLAS kernels run sequentially: the team would cost more than it saves
+static const int PARALLEL_MIN_ELEMENTS = 1 << 15;
+// Doubles per cache line, threads never share one in the vectors they write
+static const int CACHE_LINE_DOUBLES = 64 / sizeof( double );
+// Widest C handled by the skinny GEMM path, as in my_dgemm_seq
+static const int SKINNY_N_MAX = 16;
 
-#define AT_RM( i, j, width ) ( ( i ) * ( width ) + ( j ) )
-#define AT( i, j, heigth ) ( ( j ) * ( heigth ) + ( i ) )
-#define min_macro( a, b ) ( ( a ) < ( b ) ? ( a ) : ( b ) )
+namespace my_lapack {
 
-// TODO: simd if incX == 1
+    // Start of the chunk k of nt among N elements, moved to the next cache line boundary. offset is the position
+    // of the first element in its cache line.
+    static int level1Cut( int N, int k, int nt, int offset )
+    {
+        if ( k == 0 ) { return 0; }
+        if ( k == nt ) { return N; }
+        long i = static_cast<long>( N ) * k / nt + offset;
+        i      = ( i + CACHE_LINE_DOUBLES - 1 ) / CACHE_LINE_DOUBLES * CACHE_LINE_DOUBLES - offset;
+        return static_cast<int>( std::min( static_cast<long>( N ), i ) );
+    }
 
-namespace my_lapack {
+    // Range [ begin, end ) of the N elements of x, of stride inc, handled by the thread t of nt. Cuts are moved to
+    // cache lines of x only when x is contiguous: with a stride, consecutive elements are on distinct lines anyway.
+    static void level1Chunk( const double *x, int N, int inc, int t, int nt, int &begin, int &end )
+    {
+        if ( inc != 1 ) {
+            begin = static_cast<int>( static_cast<long>( N ) * t / nt );
+            end   = static_cast<int>( static_cast<long>( N ) * ( t + 1 ) / nt );
+            return;
+        }
+        int offset = static_cast<int>( reinterpret_cast<std::uintptr_t>( x ) / sizeof( double ) % CACHE_LINE_DOUBLES );
+        begin      = level1Cut( N, t, nt, offset );
+        end        = level1Cut( N, t + 1, nt, offset );
+    }
 
     double my_ddot_openmp( const int N, const double *X, const int incX, const double *Y, const int incY )
     {
@@ -27,13 +51,15 @@ namespace my_lapack {
         LAHPC_CHECK_POSITIVE( incX );
         LAHPC_CHECK_POSITIVE( incY );
 
+        if ( N < PARALLEL_MIN_ELEMENTS ) { return my_ddot_seq( N, X, incX, Y, incY ); }
+
+        // Each thread runs the sequential kernel on its chunk, the partial sums being combined by the reduction
         double ret = 0;
-        int    xi, yi;
-#pragma omp parallel for reduction( + : ret ) default( shared ) private( xi, yi )
-        for ( int i = 0; i < N; ++i ) {
-            xi = i * incX;
-            yi = i * incY;
-            ret += X[xi] * Y[yi];
+#pragma omp parallel default( shared ) reduction( + : ret )
+        {
+            int begin, end;
+            level1Chunk( X, N, incX, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) { ret += my_ddot_seq( end - begin, X + begin * incX, incX, Y + begin * incY, incY ); }
         }
         return ret;
     }
@@ -46,13 +72,89 @@ namespace my_lapack {
 
         if ( alpha == 0.0 ) { return; }
 
-        int xi, yi;
-#pragma omp parallel for private( xi, yi ) default( shared )
-        for ( int i = 0; i < N; i++ ) {
-            yi = i * incY;
-            xi = i * incX;
-            Y[yi] += alpha * X[xi];
+        if ( N < PARALLEL_MIN_ELEMENTS ) {
+            my_daxpy_seq( N, alpha, X, incX, Y, incY );
+            return;
+        }
+
+#pragma omp parallel default( shared )
+        {
+            int begin, end;
+            level1Chunk( Y, N, incY, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) { my_daxpy_seq( end - begin, alpha, X + begin * incX, incX, Y + begin * incY, incY ); }
+        }
+    }
+
+    void my_daxpby_openmp( int N, double alpha, const double *X, int incX, double beta, double *Y, int incY )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( N < PARALLEL_MIN_ELEMENTS ) {
+            my_daxpby_seq( N, alpha, X, incX, beta, Y, incY );
+            return;
+        }
+
+#pragma omp parallel default( shared )
+        {
+            int begin, end;
+            level1Chunk( Y, N, incY, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) {
+                my_daxpby_seq( end - begin, alpha, X + begin * incX, incX, beta, Y + begin * incY, incY );
+            }
+        }
+    }
+
+    double my_daxpy_dot_openmp(
+        int N, double alpha, const double *X, int incX, double *Y, int incY, const double *Z, int incZ )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_POSITIVE_STRICT( incZ );
+
+        if ( N < PARALLEL_MIN_ELEMENTS ) { return my_daxpy_dot_seq( N, alpha, X, incX, Y, incY, Z, incZ ); }
+
+        // Chunks are cut on the cache lines of the updated vector, each thread summing the dot of its own chunk
+        double ret = 0.;
+#pragma omp parallel default( shared ) reduction( + : ret )
+        {
+            int begin, end;
+            level1Chunk( Y, N, incY, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) {
+                ret += my_daxpy_dot_seq(
+                    end - begin, alpha, X + begin * incX, incX, Y + begin * incY, incY, Z + begin * incZ, incZ );
+            }
+        }
+        return ret;
+    }
+
+    void my_ddot2_openmp( int N, const double *X, int incX, const double *Y, int incY, double *xy, double *xx )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( N < PARALLEL_MIN_ELEMENTS ) {
+            my_ddot2_seq( N, X, incX, Y, incY, xy, xx );
+            return;
         }
+
+        double sxy = 0., sxx = 0.;
+#pragma omp parallel default( shared ) reduction( + : sxy, sxx )
+        {
+            int begin, end;
+            level1Chunk( X, N, incX, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) {
+                double cxy, cxx;
+                my_ddot2_seq( end - begin, X + begin * incX, incX, Y + begin * incY, incY, &cxy, &cxx );
+                sxy += cxy;
+                sxx += cxx;
+            }
+        }
+        *xy = sxy;
+        *xx = sxx;
     }
 
     void my_dgemv_openmp( CBLAS_ORDER     layout,
@@ -77,45 +179,138 @@ namespace my_lapack {
 
         if ( M == 0 || N == 0 || ( alpha == 0.0 && beta == 1.0 ) ) return;
 
-        if ( beta != 1.0 ) {
-            int lenY = ( TransA == CblasNoTrans ) ? M : N;
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dgemv_seq( layout, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY );
+            return;
+        }
 
-            if ( beta == 0 && incY == 1 ) { memset( Y, 0, lenY * sizeof( double ) ); }
-            else if ( beta == 0 ) {
-                int len = lenY * incY;
-#pragma omp parallel for default( shared )
-                for ( int yi = 0; yi < len; yi += incY ) {
-                    Y[yi] = 0;
-                }
+        // Threads own disjoint blocks of Y, cut on its cache lines: blocks of rows of A for NoTrans, of columns for
+        // Trans. Each block, scaling included, is handled by the sequential kernel.
+        int lenY = ( TransA == CblasNoTrans ) ? M : N;
+#pragma omp parallel default( shared )
+        {
+            int begin, end;
+            level1Chunk( Y, lenY, incY, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            double *y = Y + begin * incY;
+            if ( begin < end && TransA == CblasNoTrans ) {
+                my_dgemv_seq( layout, TransA, end - begin, N, alpha, A + begin, lda, X, incX, beta, y, incY );
             }
-            else {
-                int len = lenY * incY;
-#pragma omp parallel for default( shared )
-                for ( int yi = 0; yi < len; yi += incY ) {
-                    Y[yi] *= beta;
-                }
+            else if ( begin < end ) {
+                my_dgemv_seq( layout, TransA, M, end - begin, alpha, A + AT( 0, begin, lda ), lda, X, incX, beta, y, incY );
             }
         }
+    }
 
-        if ( TransA == CblasNoTrans ) {
-#pragma omp parallel for default( shared )
-            for ( int j = 0; j < N; ++j ) {
-                double tmp = alpha * X[incX * j];
-                for ( int i = 0; i < M; i++ ) {
-                    Y[i * incY] += tmp * A[j * lda + i];
-                }
+    double my_dgemv_norm_openmp( CBLAS_ORDER     layout,
+                                 CBLAS_TRANSPOSE TransA,
+                                 int             M,
+                                 int             N,
+                                 double          alpha,
+                                 const double *  A,
+                                 int             lda,
+                                 const double *  X,
+                                 int             incX,
+                                 double          beta,
+                                 double *        Y,
+                                 const int       incY )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            return my_dgemv_norm_seq( layout, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY );
+        }
+
+        // Same partition of Y as my_dgemv_openmp, the squared norms of the blocks being summed by the reduction
+        int    lenY = ( TransA == CblasNoTrans ) ? M : N;
+        double nrm2 = 0.;
+#pragma omp parallel default( shared ) reduction( + : nrm2 )
+        {
+            int begin, end;
+            level1Chunk( Y, lenY, incY, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            double *y = Y + begin * incY;
+            if ( begin < end && TransA == CblasNoTrans ) {
+                nrm2 += my_dgemv_norm_seq(
+                    layout, TransA, end - begin, N, alpha, A + begin, lda, X, incX, beta, y, incY );
+            }
+            else if ( begin < end ) {
+                nrm2 += my_dgemv_norm_seq(
+                    layout, TransA, M, end - begin, alpha, A + AT( 0, begin, lda ), lda, X, incX, beta, y, incY );
             }
         }
+        return nrm2;
+    }
 
-        else if ( TransA == CblasTrans ) {
-#pragma omp parallel for default( shared )
-            for ( int j = 0; j < N; ++j ) {
-                int    yi  = j * incY;
-                double tmp = 0;
-                for ( int i = 0, xi = 0; i < M; ++i, xi += incX ) {
-                    tmp += A[j * lda + i] * X[xi];
+    void my_dgemv2_openmp( CBLAS_ORDER   layout,
+                           int           M,
+                           int           N,
+                           double        alpha,
+                           const double *A,
+                           int           lda,
+                           const double *X,
+                           int           incX,
+                           const double *Y,
+                           int           incY,
+                           double        beta,
+                           double *      W,
+                           int           incW,
+                           double *      Z,
+                           int           incZ )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_POSITIVE_STRICT( incW );
+        LAHPC_CHECK_POSITIVE_STRICT( incZ );
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+
+        if ( M == 0 || N == 0 || ( alpha == 0.0 && beta == 1.0 ) ) return;
+
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dgemv2_seq( layout, M, N, alpha, A, lda, X, incX, Y, incY, beta, W, incW, Z, incZ );
+            return;
+        }
+
+        // Threads own blocks of rows of A, hence of W. Their contributions to Z go to zeroed private buffers, which
+        // are then summed into Z by blocks of columns.
+        std::vector<double> partial( static_cast<size_t>( omp_get_max_threads() ) * N, 0. );
+#pragma omp parallel default( shared )
+        {
+            int     t  = omp_get_thread_num();
+            int     nt = omp_get_num_threads();
+            double *zt = partial.data() + static_cast<size_t>( t ) * N;
+            int     begin, end;
+            level1Chunk( W, M, incW, t, nt, begin, end );
+            if ( begin < end ) {
+                my_dgemv2_seq( layout,
+                               end - begin,
+                               N,
+                               alpha,
+                               A + begin,
+                               lda,
+                               X,
+                               incX,
+                               Y + begin * incY,
+                               incY,
+                               beta,
+                               W + begin * incW,
+                               incW,
+                               zt,
+                               1 );
+            }
+#pragma omp barrier
+            level1Chunk( Z, N, incZ, t, nt, begin, end );
+            for ( int j = begin; j < end; ++j ) {
+                double sum = 0.;
+                for ( int k = 0; k < nt; ++k ) {
+                    sum += partial[static_cast<size_t>( k ) * N + j];
                 }
-                Y[yi] += alpha * tmp;
+                Z[j * incZ] = ( beta == 0.0 ) ? sum : beta * Z[j * incZ] + sum;
             }
         }
     }
@@ -248,12 +443,46 @@ namespace my_lapack {
         bool bTransA = ( TransA == CblasTrans );
         bool bTransB = ( TransB == CblasTrans );
 
+        // Few columns in C: the sequential skinny path on blocks of rows of C, each thread reading its own part of A
+        if ( N <= SKINNY_N_MAX ) {
+            if ( static_cast<long>( M ) * K < PARALLEL_MIN_ELEMENTS ) {
+                my_dgemm_seq( Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc );
+                return;
+            }
+#pragma omp parallel default( shared )
+            {
+                int begin, end;
+                level1Chunk( C, M, 1, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+                if ( begin < end ) {
+                    my_dgemm_seq( Order,
+                                  TransA,
+                                  TransB,
+                                  end - begin,
+                                  N,
+                                  K,
+                                  alpha,
+                                  bTransA ? A + AT( 0, begin, lda ) : A + begin,
+                                  lda,
+                                  B,
+                                  ldb,
+                                  beta,
+                                  C + begin,
+                                  ldc );
+                }
+            }
+            return;
+        }
+
         int lastMB = M % BLOCK_SIZE;
         int lastNB = N % BLOCK_SIZE;
         int lastKB = K % BLOCK_SIZE;
         int MB     = lastMB ? ( M / BLOCK_SIZE ) + 1 : ( M / BLOCK_SIZE );
         int NB     = lastNB ? ( N / BLOCK_SIZE ) + 1 : ( N / BLOCK_SIZE );
         int KB     = lastKB ? ( K / BLOCK_SIZE ) + 1 : ( K / BLOCK_SIZE );
+        // Last blocks are full when the dimensions are multiples of BLOCK_SIZE
+        if ( !lastMB ) { lastMB = BLOCK_SIZE; }
+        if ( !lastNB ) { lastNB = BLOCK_SIZE; }
+        if ( !lastKB ) { lastKB = BLOCK_SIZE; }
 
         double *C_padding;
         int     m, n, k, m_blk, n_blk;
@@ -395,6 +624,134 @@ namespace my_lapack {
         }
     }
 
+    void my_dtile_mask_openmp( int M, int N, const double *A, int lda, unsigned char *mask )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int MT = tileCount( M ), NT = tileCount( N );
+        if ( NT < 2 || static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dtile_mask_seq( M, N, A, lda, mask );
+            return;
+        }
+
+        // Zero tiles take longer to scan than dense ones, hence the dynamic schedule over the columns of tiles
+#pragma omp parallel for schedule( dynamic )
+        for ( int tj = 0; tj < NT; ++tj ) {
+            int nb = std::min( BLOCK_SIZE, N - tj * BLOCK_SIZE );
+            my_dtile_mask_seq( M, nb, A + AT( 0, tj * BLOCK_SIZE, lda ), lda, mask + static_cast<size_t>( tj ) * MT );
+        }
+    }
+
+    void my_dgemm_masked_openmp( CBLAS_ORDER          Order,
+                                 CBLAS_TRANSPOSE      TransA,
+                                 CBLAS_TRANSPOSE      TransB,
+                                 int                  M,
+                                 int                  N,
+                                 int                  K,
+                                 double               alpha,
+                                 const double *       A,
+                                 int                  lda,
+                                 const unsigned char *maskA,
+                                 const double *       B,
+                                 int                  ldb,
+                                 const unsigned char *maskB,
+                                 double               beta,
+                                 double *             C,
+                                 int                  ldc )
+    {
+        LAHPC_CHECK_PREDICATE( Order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+        LAHPC_CHECK_PREDICATE( ( TransB == CblasTrans ) || ( TransB == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+        LAHPC_CHECK_POSITIVE_STRICT( ldc );
+
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dgemm_masked_seq( Order, TransA, TransB, M, N, K, alpha, A, lda, maskA, B, ldb, maskB, beta, C, ldc );
+            return;
+        }
+
+        bool bTransA = ( TransA == CblasTrans );
+        bool bTransB = ( TransB == CblasTrans );
+        int  MT = tileCount( M ), NT = tileCount( N ), KT = tileCount( K );
+
+        std::vector<unsigned char> ownMaskA, ownMaskB;
+        if ( !maskA ) {
+            ownMaskA.resize( static_cast<size_t>( MT ) * KT );
+            my_dtile_mask_openmp( bTransA ? K : M, bTransA ? M : K, A, lda, ownMaskA.data() );
+            maskA = ownMaskA.data();
+        }
+        if ( !maskB ) {
+            ownMaskB.resize( static_cast<size_t>( KT ) * NT );
+            my_dtile_mask_openmp( bTransB ? N : K, bTransB ? K : N, B, ldb, ownMaskB.data() );
+            maskB = ownMaskB.data();
+        }
+
+        // Prefix sums of the work of the C tiles, taken column by column: one unit for the scaling by beta plus one
+        // per nonzero tile product. Each thread takes a contiguous range of tiles holding its share of the total, so
+        // that the dense tiles of a triangular or banded product do not all fall on the same threads.
+        int               tiles = MT * NT;
+        std::vector<long> work( tiles + 1, 0 );
+#pragma omp parallel for default( shared )
+        for ( int t = 0; t < tiles; ++t ) {
+            long w = 1;
+            for ( int k = 0; k < KT; ++k ) {
+                w += tileProductNonzero( bTransA, bTransB, t % MT, t / MT, k, MT, NT, KT, maskA, maskB );
+            }
+            work[t + 1] = w;
+        }
+        for ( int t = 0; t < tiles; ++t ) {
+            work[t + 1] += work[t];
+        }
+
+#pragma omp parallel default( shared )
+        {
+            int  nt = omp_get_num_threads(), id = omp_get_thread_num();
+            long total = work[tiles];
+            int  begin = std::lower_bound( work.begin(), work.end(), total * id / nt ) - work.begin();
+            int  end   = std::lower_bound( work.begin(), work.end(), total * ( id + 1 ) / nt ) - work.begin();
+
+            for ( int t = begin; t < end; ++t ) {
+                int     m = t % MT, n = t / MT;
+                int     mb = std::min( BLOCK_SIZE, M - m * BLOCK_SIZE );
+                int     nb = std::min( BLOCK_SIZE, N - n * BLOCK_SIZE );
+                double *tile = C + BLOCK_SIZE * AT( m, n, ldc );
+                for ( int j = 0; j < nb; ++j ) {
+                    double *c = tile + AT( 0, j, ldc );
+                    if ( beta == 0. ) { std::fill( c, c + mb, 0. ); }
+                    else if ( beta != 1. ) {
+                        for ( int i = 0; i < mb; ++i ) {
+                            c[i] *= beta;
+                        }
+                    }
+                }
+
+                for ( int k = 0; k < KT; ++k ) {
+                    if ( !tileProductNonzero( bTransA, bTransB, m, n, k, MT, NT, KT, maskA, maskB ) ) { continue; }
+                    my_dgemm_scal_seq( Order,
+                                       TransA,
+                                       TransB,
+                                       mb,
+                                       nb,
+                                       std::min( BLOCK_SIZE, K - k * BLOCK_SIZE ),
+                                       alpha,
+                                       A + BLOCK_SIZE * ( bTransA ? AT( k, m, lda ) : AT( m, k, lda ) ),
+                                       lda,
+                                       B + BLOCK_SIZE * ( bTransB ? AT( n, k, ldb ) : AT( k, n, ldb ) ),
+                                       ldb,
+                                       1.,
+                                       tile,
+                                       ldc );
+                }
+            }
+        }
+    }
+
     void my_dger_openmp( CBLAS_ORDER   layout,
                                   int           M,
                                   int           N,
@@ -415,10 +772,64 @@ namespace my_lapack {
 
         if ( M == 0 || N == 0 || alpha == 0.0 ) { return; }
 
-        for ( int i = 0; i < M; ++i ) {
-            double tmp = alpha * X[i * incX];
-            for ( int j = 0; j < N; ++j ) {
-                A[i + j * lda] += tmp * Y[j * incY];
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dger_seq( layout, M, N, alpha, X, incX, Y, incY, A, lda );
+            return;
+        }
+
+        // Threads take blocks of columns, or blocks of rows of the panels too narrow to give a column to each thread
+#pragma omp parallel default( shared )
+        {
+            int t  = omp_get_thread_num();
+            int nt = omp_get_num_threads();
+            if ( N >= nt ) {
+                int begin = static_cast<int>( static_cast<long>( N ) * t / nt );
+                int end   = static_cast<int>( static_cast<long>( N ) * ( t + 1 ) / nt );
+                my_dger_seq(
+                    layout, M, end - begin, alpha, X, incX, Y + begin * incY, incY, A + AT( 0, begin, lda ), lda );
+            }
+            else {
+                int begin, end;
+                level1Chunk( A, M, 1, t, nt, begin, end );
+                if ( begin < end ) {
+                    my_dger_seq( layout, end - begin, N, alpha, X + begin * incX, incX, Y, incY, A + begin, lda );
+                }
+            }
+        }
+    }
+
+    void my_dscal_dger_openmp( CBLAS_ORDER   layout,
+                               int           M,
+                               int           N,
+                               double        scale,
+                               double *      X,
+                               int           incX,
+                               double        alpha,
+                               const double *Y,
+                               int           incY,
+                               double *      A,
+                               int           lda )
+    {
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( static_cast<long>( M ) * std::max( N, 1 ) < PARALLEL_MIN_ELEMENTS ) {
+            my_dscal_dger_seq( layout, M, N, scale, X, incX, alpha, Y, incY, A, lda );
+            return;
+        }
+
+        // Blocks of rows, so that each thread scales the part of X it then uses
+#pragma omp parallel default( shared )
+        {
+            int begin, end;
+            level1Chunk( A, M, 1, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) {
+                my_dscal_dger_seq(
+                    layout, end - begin, N, scale, X + begin * incX, incX, alpha, Y, incY, A + begin, lda );
             }
         }
     }
@@ -433,270 +844,239 @@ namespace my_lapack {
 
         int minMN = std::min( M, N );
         for ( int j = 0; j < minMN; ++j ) {
-            if ( j < M - 1 ) { my_dscal( M - j - 1, 1.0 / A[j * lda + j], A + j * lda + j + 1, 1 ); }
             if ( j < minMN - 1 ) {
-                my_dger_openmp( CblasColMajor,
-                                M - j - 1,
-                                N - j - 1,
-                                -1.0,
-                                A + j * lda + j + 1,
-                                1,
-                                A + ( j + 1 ) * lda + j,
-                                lda,
-                                A + ( j + 1 ) * lda + j + 1,
-                                lda );
+                my_dscal_dger_openmp( CblasColMajor,
+                                      M - j - 1,
+                                      N - j - 1,
+                                      1.0 / A[j * lda + j],
+                                      A + j * lda + j + 1,
+                                      1,
+                                      -1.0,
+                                      A + ( j + 1 ) * lda + j,
+                                      lda,
+                                      A + ( j + 1 ) * lda + j + 1,
+                                      lda );
+            }
+            else if ( j < M - 1 ) {
+                my_dscal_openmp( M - j - 1, 1.0 / A[j * lda + j], A + j * lda + j + 1, 1 );
             }
         }
     }
 
     void my_dtrsm_openmp( CBLAS_ORDER     layout,
-                                   CBLAS_SIDE      side,
-                                   CBLAS_UPLO      uplo,
-                                   CBLAS_TRANSPOSE transA,
-                                   CBLAS_DIAG      diag,
-                                   int             M,
-                                   int             N,
-                                   double          alpha,
-                                   const double *  A,
-                                   int             lda,
-                                   double *        B,
-                                   int             ldb )
+                          CBLAS_SIDE      side,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE transA,
+                          CBLAS_DIAG      diag,
+                          int             M,
+                          int             N,
+                          double          alpha,
+                          const double *  A,
+                          int             lda,
+                          double *        B,
+                          int             ldb )
     {
         LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
         LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
         LAHPC_CHECK_POSITIVE( M );
         LAHPC_CHECK_POSITIVE( N );
         LAHPC_CHECK_POSITIVE_STRICT( lda );
         LAHPC_CHECK_POSITIVE_STRICT( ldb );
 
-        double lambda;
-
         if ( M == 0 || N == 0 ) return;
 
-        /* scale 0. */
-        if ( alpha == 0. ) {
-            for ( int j = 0; j < N; ++j ) {
-                memset( B + j * ldb, 0, M * sizeof( double ) );
+        const int nb = BLOCK_SIZE;
+        int       R  = ( side == CblasLeft ) ? N : M; // Number of independent right-hand sides
+
+        // Enough right-hand sides to feed every thread: each thread solves one contiguous range of about R / nt columns
+        // of B (rows on the right side), cut on multiples of nb, with a single call to the blocked sequential solve.
+        // A is then read once per thread instead of once per block of nb right-hand sides.
+        int nbRhsBlocks = ( R + nb - 1 ) / nb;
+        if ( nbRhsBlocks >= omp_get_max_threads() ) {
+#pragma omp parallel default( shared )
+            {
+                int t  = omp_get_thread_num();
+                int nt = omp_get_num_threads();
+                int r  = std::min( R, nbRhsBlocks * t / nt * nb );
+                int rb = std::min( R, nbRhsBlocks * ( t + 1 ) / nt * nb ) - r;
+                if ( rb > 0 && side == CblasLeft ) {
+                    dtrsmBlocked<SeqKernels>(
+                        side, uplo, transA, diag, M, rb, alpha, A, lda, nullptr, B + AT( 0, r, ldb ), ldb );
+                }
+                else if ( rb > 0 ) {
+                    dtrsmBlocked<SeqKernels>( side, uplo, transA, diag, rb, N, alpha, A, lda, nullptr, B + r, ldb );
+                }
             }
             return;
         }
 
-        /* Left side : op( A ) * X = alpha * B */
-        if ( side == CblasLeft ) {
-            /* B = alpha * inv(A ** t) * B */
-            if ( transA == CblasTrans ) {
-                /* A is a lower triangular */
-                if ( uplo == CblasLower ) {
-                    for ( int j = 0; j < N; ++j ) {
-                        for ( int i = M - 1; i >= 0; --i ) {
-                            lambda = alpha * B[i + j * ldb];
-#pragma omp parallel for default( shared ) schedule( dynamic )
-                            for ( int k = i + 1; k < M; ++k ) {
-                                lambda -= B[k + j * ldb] * A[k + i * lda];
-                            }
-                            /* The diagonal is A[i + i*lda] (Otherwise : 1.) */
-                            /* Relevent when solving A = L*U as we use A to store
-                               both L and U, so diag(L) is full of 1. . */
-                            if ( diag == CblasNonUnit ) lambda /= A[i * ( 1 + lda )];
-                            B[i + j * ldb] = lambda;
-                        }
-                    }
-                }
-                /* A is triangular upper */
-                else if ( uplo == CblasUpper ) {
-                    for ( int j = 0; j < N; ++j ) {
-                        for ( int i = 0; i < M; ++i ) {
-                            lambda = alpha * B[i + j * ldb];
+        // Otherwise the threads share the GEMM updates of the blocked solve
+        dtrsmBlocked<OmpKernels>( side, uplo, transA, diag, M, N, alpha, A, lda, nullptr, B, ldb );
+    }
+
+    int my_dtrtri_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( diag == CblasUnit ) || ( diag == CblasNonUnit ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        const int nb       = BLOCK_SIZE;
+        int       nbBlocks = ( N + nb - 1 ) / nb;
+        if ( nbBlocks < 2 ) { return my_dtrtri_seq( order, uplo, diag, N, A, lda ); }
+
+        if ( diag == CblasNonUnit ) {
+            for ( int j = 0; j < N; ++j ) {
+                if ( A[AT( j, j, lda )] == 0. ) { return j + 1; }
+            }
+        }
+
+        // Each block of columns of the inverse is the solution of A * X = I restricted to the rows where it is not
+        // zero. The blocks are independent, for the same flops as the sequential inversion, but need a copy of A.
+        std::vector<double> X( static_cast<size_t>( N ) * N, 0. );
 #pragma omp parallel for default( shared ) schedule( dynamic )
-                            for ( int k = 0; k < i; ++k ) {
-                                lambda -= A[k + i * lda] * B[k + j * ldb];
-                            }
-                            /* The diagonal is A[i + i*lda] (Otherwise : 1.) */
-                            if ( diag == CblasNonUnit ) lambda /= A[i * ( 1 + lda )];
-                            B[i + j * ldb] = lambda;
-                        }
-                    }
-                }
+        for ( int b = 0; b < nbBlocks; ++b ) {
+            int j  = b * nb;
+            int jb = std::min( nb, N - j );
+            for ( int i = j; i < j + jb; ++i ) {
+                X[AT( i, i, N )] = 1.;
+            }
+            if ( uplo == CblasUpper ) {
+                my_dtrsm_seq(
+                    order, CblasLeft, uplo, CblasNoTrans, diag, j + jb, jb, 1., A, lda, &X[AT( 0, j, N )], N );
             }
-            /* B = alpha * inv(A) * B */
             else {
-                /* A is triangular Upper */
-                if ( uplo == CblasUpper ) {
-                    for ( int j = 0; j < N; ++j ) {
-                        if ( alpha != 1. ) {
-                            for ( int i = 0; i < M; i++ ) {
-                                B[i + j * ldb] *= alpha;
-                            }
-                        }
-                        for ( int k = M - 1; k >= 0; --k ) {
-                            if ( B[k + j * ldb] ) {
-                                if ( diag == CblasNonUnit ) B[k + j * ldb] /= A[k * ( 1 + lda )];
-                                lambda = B[k + j * ldb];
-#pragma omp parallel for default( shared ) schedule( dynamic )
-                                for ( int i = 0; i < k; ++i ) {
-                                    B[i + j * ldb] -= lambda * A[i + k * lda];
-                                }
-                            }
-                        }
-                    }
-                }
-                /* A is lower triangular */
-                else {
-                    for ( int j = 0; j < N; ++j ) {
-                        for ( int i = 0; i < M; i++ ) {
-                            B[i + j * ldb] *= alpha;
-                        }
-                        for ( int k = 0; k < M; ++k ) {
-                            if ( B[k + j * ldb] != 0. ) {
-                                if ( diag == CblasNonUnit ) B[k + j * ldb] /= A[k * ( 1 + lda )];
-                                lambda = B[k + j * ldb];
-#pragma omp parallel for default( shared ) schedule( dynamic )
-                                for ( int i = k + 1; i < M; ++i ) {
-                                    B[i + j * ldb] -= lambda * A[i + k * lda];
-                                }
-                            }
-                        }
-                    }
-                }
+                my_dtrsm_seq( order,
+                              CblasLeft,
+                              uplo,
+                              CblasNoTrans,
+                              diag,
+                              N - j,
+                              jb,
+                              1.,
+                              A + AT( j, j, lda ),
+                              lda,
+                              &X[AT( j, j, N )],
+                              N );
             }
         }
-        /* Right side : X * op( A ) = alpha*B */
-        else {
-            /* X = alpha * B * inv(A) */
-            if ( transA == CblasNoTrans ) {
-                /* A is upper triangular */
-                if ( uplo == CblasUpper ) {
-                    for ( int j = 0; j < N; j++ ) {
-                        if ( alpha != 1.0 ) {
-                            for ( int i = 0; i < M; ++i ) {
-                                B[i + j * ldb] *= alpha;
-                            }
-                        }
-                        for ( int k = 0; k < j - 1; k++ ) {
-                            if ( A[k + j * lda] != 0.0 ) {
-                                for ( int i = 0; i < M; i++ ) {
-                                    B[i + j * ldb] -= A[k + j * lda] * B[i + k * ldb];
-                                }
-                            }
-                        }
-                        if ( diag == CblasNonUnit ) {
-                            lambda = 1.0 / A[j * ( 1 + lda )];
-#pragma omp parallel for default( shared ) schedule( dynamic )
-                            for ( int i = 0; i < M; i++ ) {
-                                B[i + j * ldb] = lambda * B[i + j * ldb];
-                            }
-                        }
-                    }
-                }
-                /* A is lower triangular */
-                else {
-                    for ( int j = N - 1; j >= 0; --j ) {
-                        if ( alpha != 1.0 ) {
-                            for ( int i = 0; i < M; ++i ) {
-                                B[i + j * ldb] *= alpha;
-                            }
-                        }
-                        for ( int k = j + 1; k < N; ++k ) {
-                            if ( A[k + j * lda] != 0.0 ) {
-                                for ( int i = 0; i < M; ++i ) {
-                                    B[i + j * ldb] -= A[k + j * lda] * B[i + k * ldb];
-                                }
-                            }
-                        }
-                        if ( diag == CblasNonUnit ) {
-                            lambda = 1.0 / A[j * ( 1 + lda )];
-#pragma omp parallel for default( shared ) schedule( dynamic )
-                            for ( int i = 0; i < M; i++ ) {
-                                B[i + j * ldb] = lambda * B[i + j * ldb];
-                            }
-                        }
-                    }
-                }
+
+        // Unit diagonals are not referenced
+        int shift = ( diag == CblasUnit ) ? 1 : 0;
+#pragma omp parallel for default( shared )
+        for ( int j = 0; j < N; ++j ) {
+            if ( uplo == CblasUpper ) {
+                std::copy( &X[AT( 0, j, N )], &X[AT( j + 1 - shift, j, N )], A + AT( 0, j, lda ) );
             }
-            /* X = alpha * B * inv(A ** t) */
             else {
-                /* A is upper triangular */
-                if ( uplo == CblasUpper ) {
-                    for ( int k = N - 1; k >= 0; --k ) {
-                        if ( diag == CblasNonUnit ) {
-                            lambda = 1.0 / A[k + k * lda];
-                            for ( int i = 0; i < M; i++ ) {
-                                B[i + k * ldb] = lambda * B[i + k * ldb];
-                            }
-                        }
-#pragma omp parallel sections
-                        {
-#pragma omp section
-                            for ( int j = 0; j < k; ++j ) {
-                                if ( A[j + k * lda] != 0.0 ) {
-                                    lambda = A[j + k * lda];
-                                    for ( int i = 0; i < M; ++i ) {
-                                        B[i + j * ldb] -= lambda * B[i + k * ldb];
-                                    }
-                                }
-                            }
-#pragma omp section
-                            if ( alpha != 1.0 ) {
-                                for ( int i = 0; i < M; i++ ) {
-                                    B[i + k * ldb] = alpha * B[i + k * ldb];
-                                }
-                            }
-                        }
-                    }
-                }
-                /* A is lower triangular */
-                else {
-                    for ( int k = 0; k < N; ++k ) {
-                        if ( diag == CblasNonUnit ) {
-                            lambda = 1.0 / A[k + k * lda];
-                            for ( int i = 0; i < M; ++i ) {
-                                B[i + k * ldb] = lambda * B[i + k * ldb];
-                            }
-                        }
-#pragma omp parallel sections
-                        {
-#pragma omp section
-                            for ( int j = k + 1; j < N; j++ ) {
-                                if ( A[j + k * lda] != 0.0 ) {
-                                    lambda = A[j + k * lda];
-                                    for ( int i = 0; i < M; i++ ) {
-                                        B[i + j * ldb] -= lambda * B[i + k * ldb];
-                                    }
-                                }
-                            }
-#pragma omp section
-                            if ( alpha != 1.0 ) {
-                                for ( int i = 0; i < M; ++i ) {
-                                    B[i + k * lda] = alpha * B[i + k * ldb];
-                                }
-                            }
-                        }
-                    }
-                }
+                std::copy( &X[AT( j + shift, j, N )], &X[AT( N, j, N )], A + AT( j + shift, j, lda ) );
             }
         }
+
+        return 0;
     }
 
-    void my_dgetrf_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda )
+    int my_dtrtri_diag_openmp(
+        CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, const double *A, int lda, double *invA )
     {
         LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( diag == CblasUnit ) || ( diag == CblasNonUnit ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        // The diagonal blocks are inverted independently, the first singular one giving the info
+        int nbBlocks = ( N + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+        int info     = 0;
+#pragma omp parallel for default( shared ) schedule( dynamic )
+        for ( int b = 0; b < nbBlocks; ++b ) {
+            int k  = b * BLOCK_SIZE;
+            int kb = std::min( BLOCK_SIZE, N - k );
+            int blockInfo =
+                my_dtrtri_diag_seq( order, uplo, diag, kb, A + AT( k, k, lda ), lda, invA + AT( 0, k, BLOCK_SIZE ) );
+            if ( blockInfo != 0 ) {
+#pragma omp critical
+                if ( info == 0 || k + blockInfo < info ) { info = k + blockInfo; }
+            }
+        }
+        return info;
+    }
+
+    void my_dtrsm_inv_openmp( CBLAS_ORDER     layout,
+                              CBLAS_SIDE      side,
+                              CBLAS_UPLO      uplo,
+                              CBLAS_TRANSPOSE transA,
+                              CBLAS_DIAG      diag,
+                              int             M,
+                              int             N,
+                              double          alpha,
+                              const double *  A,
+                              int             lda,
+                              const double *  invA,
+                              double *        B,
+                              int             ldb )
+    {
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
         LAHPC_CHECK_POSITIVE( M );
         LAHPC_CHECK_POSITIVE( N );
         LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
 
-        //if ( M == 0 || N == 0 ) { return; }
-
-        const int maxBlockSize = 10;
-        int       minMN        = std::min( M, N );
+        if ( M == 0 || N == 0 ) return;
 
-        if ( maxBlockSize <= 1 || maxBlockSize >= minMN ) {
-            my_dgetf2_seq( order, M, N, A, lda );
+        // Wide right-hand sides are shared between the threads. With fewer right-hand sides, the threads share the
+        // GEMM updates of the blocked solve instead.
+        const int nb          = BLOCK_SIZE;
+        int       R           = ( side == CblasLeft ) ? N : M;
+        int       nbRhsBlocks = ( R + nb - 1 ) / nb;
+        if ( nbRhsBlocks < omp_get_max_threads() ) {
+            dtrsmBlocked<OmpKernels>( side, uplo, transA, diag, M, N, alpha, A, lda, invA, B, ldb );
             return;
         }
-        //#pragma omp parallel for schedule( guided ) default( shared )
-        for ( int j = 0; j < minMN; j += maxBlockSize ) {
-            int blockSize = std::min( minMN - j, maxBlockSize );
-            my_dgetrf_openmp( order, M - j, blockSize, A + j * lda + j, lda );
+
+        // One contiguous range of right-hand sides per thread, as in my_dtrsm_openmp
+#pragma omp parallel default( shared )
+        {
+            int t  = omp_get_thread_num();
+            int nt = omp_get_num_threads();
+            int r  = std::min( R, nbRhsBlocks * t / nt * nb );
+            int rb = std::min( R, nbRhsBlocks * ( t + 1 ) / nt * nb ) - r;
+            if ( rb > 0 && side == CblasLeft ) {
+                dtrsmBlocked<SeqKernels>(
+                    side, uplo, transA, diag, M, rb, alpha, A, lda, invA, B + AT( 0, r, ldb ), ldb );
+            }
+            else if ( rb > 0 ) {
+                dtrsmBlocked<SeqKernels>( side, uplo, transA, diag, rb, N, alpha, A, lda, invA, B + r, ldb );
+            }
+        }
+    }
+
+    void my_dgetrf_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+
+        //if ( M == 0 || N == 0 ) { return; }
+
+        const int maxBlockSize = 10;
+        int       minMN        = std::min( M, N );
+
+        if ( maxBlockSize <= 1 || maxBlockSize >= minMN ) {
+            my_dgetf2_seq( order, M, N, A, lda );
+            return;
+        }
+        //#pragma omp parallel for schedule( guided ) default( shared )
+        for ( int j = 0; j < minMN; j += maxBlockSize ) {
+            int blockSize = std::min( minMN - j, maxBlockSize );
+            my_dgetrf_openmp( order, M - j, blockSize, A + j * lda + j, lda );
             if ( j + blockSize < N ) {
                 my_dtrsm_seq( order,
                               CblasLeft,
@@ -731,22 +1111,924 @@ namespace my_lapack {
         }
     }
 
+    int my_dgetf2_piv_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int info  = 0;
+        int minMN = std::min( M, N );
+
+        for ( int j = 0; j < minMN; ++j ) {
+            ipiv[j] = j + my_idamax_openmp( M - j, A + j * lda + j, 1 );
+
+            // A zero column is left as is, only the trailing update being applied
+            double scale = 1.0;
+            if ( A[j * lda + ipiv[j]] != 0.0 ) {
+                my_dlaswp_openmp( N, A, lda, j, j, ipiv, 1 );
+                scale = 1.0 / A[j * lda + j];
+            }
+            else if ( info == 0 ) {
+                info = j + 1;
+            }
+
+            if ( j < minMN - 1 ) {
+                my_dscal_dger_openmp( CblasColMajor,
+                                      M - j - 1,
+                                      N - j - 1,
+                                      scale,
+                                      A + j * lda + j + 1,
+                                      1,
+                                      -1.0,
+                                      A + ( j + 1 ) * lda + j,
+                                      lda,
+                                      A + ( j + 1 ) * lda + j + 1,
+                                      lda );
+            }
+            else if ( j < M - 1 ) {
+                my_dscal_openmp( M - j - 1, scale, A + j * lda + j + 1, 1 );
+            }
+        }
+
+        return info;
+    }
+
+    int my_dgetrf_piv_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return 0; }
+
+        const int nb    = BLOCK_SIZE;
+        int       minMN = std::min( M, N );
+
+        if ( nb >= minMN ) { return my_dgetf2_piv_openmp( order, M, N, A, lda, ipiv ); }
+
+        int info = 0;
+        for ( int j = 0; j < minMN; j += nb ) {
+            int jb    = std::min( minMN - j, nb );
+            int iinfo = my_dgetf2_piv_openmp( order, M - j, jb, A + j * lda + j, lda, ipiv + j );
+
+            if ( info == 0 && iinfo > 0 ) { info = iinfo + j; }
+            for ( int i = j; i < j + jb; ++i ) {
+                ipiv[i] += j;
+            }
+
+            // Apply the interchanges of the panel to the columns on its left and on its right
+            my_dlaswp_openmp( j, A, lda, j, j + jb - 1, ipiv, 1 );
+            if ( j + jb < N ) {
+                my_dlaswp_openmp( N - j - jb, A + ( j + jb ) * lda, lda, j, j + jb - 1, ipiv, 1 );
+
+                my_dtrsm_seq( order,
+                              CblasLeft,
+                              CblasLower,
+                              CblasNoTrans,
+                              CblasUnit,
+                              jb,
+                              N - j - jb,
+                              1.0,
+                              A + j * lda + j,
+                              lda,
+                              A + ( j + jb ) * lda + j,
+                              lda );
+
+                if ( j + jb < M ) {
+                    my_dgemm_openmp( CblasColMajor,
+                                     CblasNoTrans,
+                                     CblasNoTrans,
+                                     M - j - jb,
+                                     N - j - jb,
+                                     jb,
+                                     -1.0,
+                                     A + j * lda + j + jb,
+                                     lda,
+                                     A + ( j + jb ) * lda + j,
+                                     lda,
+                                     1.0,
+                                     A + ( j + jb ) * lda + j + jb,
+                                     lda );
+                }
+            }
+        }
+
+        return info;
+    }
+
+    void my_dgetrs_openmp( CBLAS_ORDER   order,
+                           int           N,
+                           int           NRHS,
+                           const double *A,
+                           int           lda,
+                           const int *   ipiv,
+                           double *      B,
+                           int           ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        // Enough right-hand sides to feed every thread: they are independent, so each thread solves its own blocks
+        // of columns with the blocked sequential substitution
+        int nbBlocks = ( NRHS + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+        if ( nbBlocks >= omp_get_max_threads() ) {
+#pragma omp parallel for default( shared ) schedule( dynamic )
+            for ( int b = 0; b < nbBlocks; ++b ) {
+                int j  = b * BLOCK_SIZE;
+                int jb = std::min( BLOCK_SIZE, NRHS - j );
+                my_dgetrs_seq( order, N, jb, A, lda, ipiv, B + j * ldb, ldb );
+            }
+            return;
+        }
+
+        // Otherwise the threads share the GEMM updates of the blocked substitution
+        my_dlaswp_openmp( NRHS, B, ldb, 0, N - 1, const_cast<int *>( ipiv ), 1 );
+
+        for ( int k = 0; k < N; k += BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, kb, NRHS, 1.0, A + k * lda + k, lda, B + k, ldb );
+            if ( k + kb < N ) {
+                my_dgemm_openmp( CblasColMajor,
+                                 CblasNoTrans,
+                                 CblasNoTrans,
+                                 N - k - kb,
+                                 NRHS,
+                                 kb,
+                                 -1.0,
+                                 A + k * lda + k + kb,
+                                 lda,
+                                 B + k,
+                                 ldb,
+                                 1.0,
+                                 B + k + kb,
+                                 ldb );
+            }
+        }
+
+        for ( int k = ( ( N - 1 ) / BLOCK_SIZE ) * BLOCK_SIZE; k >= 0; k -= BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq( order,
+                          CblasLeft,
+                          CblasUpper,
+                          CblasNoTrans,
+                          CblasNonUnit,
+                          kb,
+                          NRHS,
+                          1.0,
+                          A + k * lda + k,
+                          lda,
+                          B + k,
+                          ldb );
+            if ( k > 0 ) {
+                my_dgemm_openmp( CblasColMajor,
+                                 CblasNoTrans,
+                                 CblasNoTrans,
+                                 k,
+                                 NRHS,
+                                 kb,
+                                 -1.0,
+                                 A + k * lda,
+                                 lda,
+                                 B + k,
+                                 ldb,
+                                 1.0,
+                                 B,
+                                 ldb );
+            }
+        }
+    }
+
+    int my_dgesv_openmp( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, int *ipiv, double *B, int ldb )
+    {
+        int info = my_dgetrf_piv_openmp( order, N, N, A, lda, ipiv );
+        if ( info == 0 ) { my_dgetrs_openmp( order, N, NRHS, A, lda, ipiv, B, ldb ); }
+        return info;
+    }
+
+    // Only wide bands are worth it: the panels stay sequential, the threads sharing the TRSM and GEMM updates of the
+    // window each panel reaches, of about KL x ( KL + KU ) elements
+    int my_dgbtrf_openmp( CBLAS_ORDER order, int N, int KL, int KU, double *AB, int ldab, int *ipiv )
+    {
+        if ( KL < DGBTRF_BLOCK || static_cast<long>( KL ) * ( KL + KU ) < PARALLEL_MIN_ELEMENTS ) {
+            return my_dgbtrf_seq( order, N, KL, KU, AB, ldab, ipiv );
+        }
+
+        return dgbtrf<OmpKernels>( order, N, KL, KU, AB, ldab, ipiv );
+    }
+
+    // Each substitution runs down or up the whole band, so the threads share the right-hand sides instead
+    void my_dgbtrs_openmp( CBLAS_ORDER   order,
+                           int           N,
+                           int           KL,
+                           int           KU,
+                           int           NRHS,
+                           const double *AB,
+                           int           ldab,
+                           const int *   ipiv,
+                           double *      B,
+                           int           ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( NRHS < 2 || static_cast<long>( N ) * ( 2 * KL + KU + 1 ) * NRHS < PARALLEL_MIN_ELEMENTS ) {
+            my_dgbtrs_seq( order, N, KL, KU, NRHS, AB, ldab, ipiv, B, ldb );
+            return;
+        }
+
+#pragma omp parallel default( shared )
+        {
+            int nt = omp_get_num_threads(), t = omp_get_thread_num();
+            int begin = static_cast<long>( NRHS ) * t / nt, end = static_cast<long>( NRHS ) * ( t + 1 ) / nt;
+            if ( begin < end ) {
+                my_dgbtrs_seq(
+                    order, N, KL, KU, end - begin, AB, ldab, ipiv, B + static_cast<size_t>( begin ) * ldb, ldb );
+            }
+        }
+    }
+
+    // The matrices are distributed over the threads by chunks, each chunk being handled by the sequential batch
+    // kernels: a single parallel region for the whole batch, and no parallelism inside the small factorizations
+    void my_dgetrf_batch_openmp( CBLAS_ORDER order, int N, double **A, int lda, int **ipiv, int *info, int batchCount )
+    {
+        LAHPC_CHECK_POSITIVE( batchCount );
+
+        const int chunk = 16;
+#pragma omp parallel for schedule( dynamic ) default( shared )
+        for ( int b = 0; b < batchCount; b += chunk ) {
+            my_dgetrf_batch_seq( order, N, A + b, lda, ipiv + b, info + b, std::min( chunk, batchCount - b ) );
+        }
+    }
+
+    void my_dgetrs_batch_openmp( CBLAS_ORDER          order,
+                                 int                  N,
+                                 int                  NRHS,
+                                 const double *const *A,
+                                 int                  lda,
+                                 const int *const *   ipiv,
+                                 double **            B,
+                                 int                  ldb,
+                                 int                  batchCount )
+    {
+        LAHPC_CHECK_POSITIVE( batchCount );
+
+        const int chunk = 16;
+#pragma omp parallel for schedule( dynamic ) default( shared )
+        for ( int b = 0; b < batchCount; b += chunk ) {
+            my_dgetrs_batch_seq( order, N, NRHS, A + b, lda, ipiv + b, B + b, ldb, std::min( chunk, batchCount - b ) );
+        }
+    }
+
+    void my_dsyrk_openmp( CBLAS_ORDER     order,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          int             N,
+                          int             K,
+                          double          alpha,
+                          const double *  A,
+                          int             lda,
+                          double          beta,
+                          double *        C,
+                          int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, trans == CblasNoTrans ? N : K ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, N ) );
+
+        if ( N == 0 || ( ( alpha == 0. || K == 0 ) && beta == 1. ) ) { return; }
+
+        bool bTrans = ( trans == CblasTrans );
+        int  NB     = ( N + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+
+        // Block columns are independent, their heights vary so they are dealt dynamically
+#pragma omp parallel for default( shared ) schedule( dynamic )
+        for ( int b = 0; b < NB; ++b ) {
+            int j  = b * BLOCK_SIZE;
+            int jb = std::min( BLOCK_SIZE, N - j );
+
+            my_dsyrk_seq( order,
+                          uplo,
+                          trans,
+                          jb,
+                          K,
+                          alpha,
+                          bTrans ? A + AT( 0, j, lda ) : A + j,
+                          lda,
+                          beta,
+                          C + AT( j, j, ldc ),
+                          ldc );
+
+            if ( uplo == CblasLower && j + jb < N ) {
+                my_dgemm_seq( order,
+                              bTrans ? CblasTrans : CblasNoTrans,
+                              bTrans ? CblasNoTrans : CblasTrans,
+                              N - j - jb,
+                              jb,
+                              K,
+                              alpha,
+                              bTrans ? A + AT( 0, j + jb, lda ) : A + j + jb,
+                              lda,
+                              bTrans ? A + AT( 0, j, lda ) : A + j,
+                              lda,
+                              beta,
+                              C + AT( j + jb, j, ldc ),
+                              ldc );
+            }
+            else if ( uplo == CblasUpper && j > 0 ) {
+                my_dgemm_seq( order,
+                              bTrans ? CblasTrans : CblasNoTrans,
+                              bTrans ? CblasNoTrans : CblasTrans,
+                              j,
+                              jb,
+                              K,
+                              alpha,
+                              A,
+                              lda,
+                              bTrans ? A + AT( 0, j, lda ) : A + j,
+                              lda,
+                              beta,
+                              C + AT( 0, j, ldc ),
+                              ldc );
+            }
+        }
+    }
+
+    int my_dpotrf_openmp( CBLAS_ORDER order, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        if ( N == 0 ) { return 0; }
+
+        const int nb = BLOCK_SIZE;
+
+        if ( nb >= N ) { return my_dpotf2_seq( order, N, A, lda ); }
+
+        for ( int j = 0; j < N; j += nb ) {
+            int jb   = std::min( N - j, nb );
+            int info = my_dpotf2_seq( order, jb, A + AT( j, j, lda ), lda );
+            if ( info > 0 ) { return info + j; }
+
+            if ( j + jb < N ) {
+                // L21 = A21 * L11^-t: the rows are independent, each thread solves its own row blocks
+                int MB = ( N - j - jb + nb - 1 ) / nb;
+#pragma omp parallel for default( shared )
+                for ( int b = 0; b < MB; ++b ) {
+                    int i  = j + jb + b * nb;
+                    int ib = std::min( nb, N - i );
+                    my_dtrsm_seq( order,
+                                  CblasRight,
+                                  CblasLower,
+                                  CblasTrans,
+                                  CblasNonUnit,
+                                  ib,
+                                  jb,
+                                  1.0,
+                                  A + AT( j, j, lda ),
+                                  lda,
+                                  A + AT( i, j, lda ),
+                                  lda );
+                }
+
+                // A22 -= L21 * L21^t
+                my_dsyrk_openmp( order,
+                                 CblasLower,
+                                 CblasNoTrans,
+                                 N - j - jb,
+                                 jb,
+                                 -1.0,
+                                 A + AT( j + jb, j, lda ),
+                                 lda,
+                                 1.0,
+                                 A + AT( j + jb, j + jb, lda ),
+                                 lda );
+            }
+        }
+
+        return 0;
+    }
+
+    void my_dpotrs_openmp( CBLAS_ORDER order, int N, int NRHS, const double *A, int lda, double *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        // Same strategy as my_dgetrs_openmp: threads share the right-hand sides when there are enough of them,
+        // the GEMM updates otherwise
+        int nbBlocks = ( NRHS + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+        if ( nbBlocks >= omp_get_max_threads() ) {
+#pragma omp parallel for default( shared ) schedule( dynamic )
+            for ( int b = 0; b < nbBlocks; ++b ) {
+                int j  = b * BLOCK_SIZE;
+                int jb = std::min( BLOCK_SIZE, NRHS - j );
+                my_dpotrs_seq( order, N, jb, A, lda, B + j * ldb, ldb );
+            }
+            return;
+        }
+
+        for ( int k = 0; k < N; k += BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, kb, NRHS, 1.0, A + AT( k, k, lda ), lda, B + k, ldb );
+            if ( k + kb < N ) {
+                my_dgemm_openmp( order,
+                                 CblasNoTrans,
+                                 CblasNoTrans,
+                                 N - k - kb,
+                                 NRHS,
+                                 kb,
+                                 -1.0,
+                                 A + AT( k + kb, k, lda ),
+                                 lda,
+                                 B + k,
+                                 ldb,
+                                 1.0,
+                                 B + k + kb,
+                                 ldb );
+            }
+        }
+
+        for ( int k = ( ( N - 1 ) / BLOCK_SIZE ) * BLOCK_SIZE; k >= 0; k -= BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasTrans, CblasNonUnit, kb, NRHS, 1.0, A + AT( k, k, lda ), lda, B + k, ldb );
+            if ( k > 0 ) {
+                my_dgemm_openmp( order,
+                                 CblasTrans,
+                                 CblasNoTrans,
+                                 k,
+                                 NRHS,
+                                 kb,
+                                 -1.0,
+                                 A + k,
+                                 lda,
+                                 B + k,
+                                 ldb,
+                                 1.0,
+                                 B,
+                                 ldb );
+            }
+        }
+    }
+
+    int my_dposv_openmp( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, double *B, int ldb )
+    {
+        int info = my_dpotrf_openmp( order, N, A, lda );
+        if ( info == 0 ) { my_dpotrs_openmp( order, N, NRHS, A, lda, B, ldb ); }
+        return info;
+    }
+
+    // dst( j, i ) = src( i, j ) on the lower or upper triangle of src, each thread copying whole columns of tiles.
+    // Their lengths vary along the triangle, hence the dynamic schedule.
+    static void transposeTriangleOpenmp( bool lower, int N, const double *src, int lds, double *dst, int ldd )
+    {
+#pragma omp parallel for default( shared ) schedule( dynamic, 1 )
+        for ( int t = 0; t < tileCount( N ); ++t ) {
+            transposeTriangle( lower, N, src, lds, dst, ldd, t, t + 1 );
+        }
+    }
+
+    void my_dtrttf_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *A, int lda, double *ARF )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        if ( static_cast<long>( N ) * N / 2 < PARALLEL_MIN_ELEMENTS ) {
+            my_dtrttf_seq( order, uplo, N, A, lda, ARF );
+            return;
+        }
+
+        RfpBlocks b = rfpLayout( uplo, N );
+
+        if ( uplo == CblasLower ) {
+#pragma omp parallel for default( shared )
+            for ( int j = 0; j < b.n1; ++j ) {
+                std::copy( A + AT( j, j, lda ), A + AT( N, j, lda ), ARF + b.t1 + AT( j, j, b.ld ) );
+            }
+            transposeTriangleOpenmp( true, b.n2, A + AT( b.n1, b.n1, lda ), lda, ARF + b.t2, b.ld );
+        }
+        else {
+#pragma omp parallel for default( shared )
+            for ( int c = 0; c < b.n2; ++c ) {
+                std::copy( A + AT( 0, b.n1 + c, lda ), A + AT( b.n1 + c + 1, b.n1 + c, lda ), ARF + AT( 0, c, b.ld ) );
+            }
+            transposeTriangleOpenmp( false, b.n1, A, lda, ARF + b.t1, b.ld );
+        }
+    }
+
+    void my_dtfttr_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *ARF, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        if ( static_cast<long>( N ) * N / 2 < PARALLEL_MIN_ELEMENTS ) {
+            my_dtfttr_seq( order, uplo, N, ARF, A, lda );
+            return;
+        }
+
+        RfpBlocks b = rfpLayout( uplo, N );
+
+        if ( uplo == CblasLower ) {
+#pragma omp parallel for default( shared )
+            for ( int j = 0; j < b.n1; ++j ) {
+                const double *col = ARF + b.t1 + AT( j, j, b.ld );
+                std::copy( col, col + N - j, A + AT( j, j, lda ) );
+            }
+            transposeTriangleOpenmp( false, b.n2, ARF + b.t2, b.ld, A + AT( b.n1, b.n1, lda ), lda );
+        }
+        else {
+#pragma omp parallel for default( shared )
+            for ( int c = 0; c < b.n2; ++c ) {
+                const double *col = ARF + AT( 0, c, b.ld );
+                std::copy( col, col + b.n1 + c + 1, A + AT( 0, b.n1 + c, lda ) );
+            }
+            transposeTriangleOpenmp( true, b.n1, ARF + b.t1, b.ld, A, lda );
+        }
+    }
+
+    int my_dpftrf_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, double *ARF )
+    {
+        return pftrf<OmpKernels>( order, uplo, N, ARF );
+    }
+
+    void my_dpftrs_openmp( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, int NRHS, const double *ARF, double *B, int ldb )
+    {
+        pftrs<OmpKernels>( order, uplo, N, NRHS, ARF, B, ldb );
+    }
+
+    void my_dtfsm_openmp( CBLAS_ORDER     order,
+                          CBLAS_SIDE      side,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          CBLAS_DIAG      diag,
+                          int             M,
+                          int             N,
+                          double          alpha,
+                          const double *  ARF,
+                          double *        B,
+                          int             ldb )
+    {
+        tfsm<OmpKernels>( order, side, uplo, trans, diag, M, N, alpha, ARF, B, ldb );
+    }
+
+    void my_dsfrk_openmp( CBLAS_ORDER     order,
+                          CBLAS_UPLO      uplo,
+                          CBLAS_TRANSPOSE trans,
+                          int             N,
+                          int             K,
+                          double          alpha,
+                          const double *  A,
+                          int             lda,
+                          double          beta,
+                          double *        CRF )
+    {
+        sfrk<OmpKernels>( order, uplo, trans, N, K, alpha, A, lda, beta, CRF );
+    }
+
+    void my_dlarfb_openmp( CBLAS_ORDER     order,
+                           CBLAS_SIDE      side,
+                           CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           int             K,
+                           const double *  V,
+                           int             ldv,
+                           const double *  T,
+                           int             ldt,
+                           double *        C,
+                           int             ldc )
+    {
+        dlarfb<OmpKernels>( order, side, trans, M, N, K, V, ldv, T, ldt, C, ldc );
+    }
+
+    void my_dgeqrf_openmp( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        const int nb = BLOCK_SIZE;
+        int       K  = std::min( M, N );
+
+        if ( nb >= K ) {
+            my_dgeqr2_seq( order, M, N, A, lda, tau );
+            return;
+        }
+
+        std::vector<double> T( nb * nb );
+
+        for ( int j = 0; j < K; j += nb ) {
+            int jb = std::min( K - j, nb );
+            // The panel is too narrow to be worth parallelizing, the trailing update carries the flops
+            my_dgeqr2_seq( order, M - j, jb, A + AT( j, j, lda ), lda, tau + j );
+
+            if ( j + jb < N ) {
+                my_dlarft_seq( order, M - j, jb, A + AT( j, j, lda ), lda, tau + j, T.data(), nb );
+                my_dlarfb_openmp( order,
+                                  CblasLeft,
+                                  CblasTrans,
+                                  M - j,
+                                  N - j - jb,
+                                  jb,
+                                  A + AT( j, j, lda ),
+                                  lda,
+                                  T.data(),
+                                  nb,
+                                  A + AT( j, j + jb, lda ),
+                                  lda );
+            }
+        }
+    }
+
+    void my_dormqr_openmp( CBLAS_ORDER     order,
+                           CBLAS_SIDE      side,
+                           CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           int             K,
+                           const double *  A,
+                           int             lda,
+                           const double *  tau,
+                           double *        C,
+                           int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( K <= ( side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 || K == 0 ) { return; }
+
+        const int           nb = BLOCK_SIZE;
+        std::vector<double> T( nb * nb );
+
+        bool forward  = ( side == CblasLeft ) == ( trans == CblasTrans );
+        int  nbBlocks = ( K + nb - 1 ) / nb;
+
+        for ( int b = 0; b < nbBlocks; ++b ) {
+            int i  = ( forward ? b : nbBlocks - 1 - b ) * nb;
+            int ib = std::min( nb, K - i );
+            int nq = ( side == CblasLeft ) ? M : N;
+
+            my_dlarft_seq( order, nq - i, ib, A + AT( i, i, lda ), lda, tau + i, T.data(), nb );
+            if ( side == CblasLeft ) {
+                my_dlarfb_openmp( order, side, trans, M - i, N, ib, A + AT( i, i, lda ), lda, T.data(), nb, C + i, ldc );
+            }
+            else {
+                my_dlarfb_openmp(
+                    order, side, trans, M, N - i, ib, A + AT( i, i, lda ), lda, T.data(), nb, C + AT( 0, i, ldc ), ldc );
+            }
+        }
+    }
+
+    int my_dgels_openmp( CBLAS_ORDER order, int M, int N, int NRHS, double *A, int lda, double *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( M >= N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, M ) );
+
+        if ( N == 0 || NRHS == 0 ) { return 0; }
+
+        std::vector<double> tau( N );
+        my_dgeqrf_openmp( order, M, N, A, lda, tau.data() );
+
+        for ( int j = 0; j < N; ++j ) {
+            if ( A[AT( j, j, lda )] == 0. ) { return j + 1; }
+        }
+
+        my_dormqr_openmp( order, CblasLeft, CblasTrans, M, NRHS, N, A, lda, tau.data(), B, ldb );
+        my_dtrsm_openmp( order, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, N, NRHS, 1.0, A, lda, B, ldb );
+
+        return 0;
+    }
+
+    void my_sgemm_openmp( CBLAS_ORDER     Order,
+                          CBLAS_TRANSPOSE TransA,
+                          CBLAS_TRANSPOSE TransB,
+                          int             M,
+                          int             N,
+                          int             K,
+                          float           alpha,
+                          const float *   A,
+                          int             lda,
+                          const float *   B,
+                          int             ldb,
+                          float           beta,
+                          float *         C,
+                          int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( Order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+        LAHPC_CHECK_PREDICATE( ( TransB == CblasTrans ) || ( TransB == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+        LAHPC_CHECK_POSITIVE_STRICT( ldc );
+
+        if ( M == 0 || N == 0 || ( ( alpha == 0.f || K == 0 ) && beta == 1.f ) ) { return; }
+
+        bool bTransA = ( TransA == CblasTrans );
+        bool bTransB = ( TransB == CblasTrans );
+
+        // Each task computes one block of C with the sequential kernel
+        const int nb = 4 * BLOCK_SIZE;
+#pragma omp parallel for collapse( 2 ) schedule( dynamic ) default( shared )
+        for ( int j = 0; j < N; j += nb ) {
+            for ( int i = 0; i < M; i += nb ) {
+                my_sgemm_seq( Order,
+                              TransA,
+                              TransB,
+                              std::min( nb, M - i ),
+                              std::min( nb, N - j ),
+                              K,
+                              alpha,
+                              bTransA ? A + AT( 0, i, lda ) : A + i,
+                              lda,
+                              bTransB ? B + j : B + AT( 0, j, ldb ),
+                              ldb,
+                              beta,
+                              C + AT( i, j, ldc ),
+                              ldc );
+            }
+        }
+    }
+
+    static void slaswp( int N, float *A, int lda, int k1, int k2, const int *ipiv )
+    {
+#pragma omp parallel for default( shared )
+        for ( int j = 0; j < N; ++j ) {
+            for ( int i = k1; i <= k2; ++i ) {
+                if ( ipiv[i] != i ) { std::swap( A[AT( i, j, lda )], A[AT( ipiv[i], j, lda )] ); }
+            }
+        }
+    }
+
+    // B = L^-1 * B, L being unit lower triangular, the columns of B being solved in parallel
+    static void strsm_llnu( int M, int N, const float *L, int ldl, float *B, int ldb )
+    {
+#pragma omp parallel for default( shared )
+        for ( int j = 0; j < N; ++j ) {
+            float *b = B + AT( 0, j, ldb );
+            for ( int k = 0; k < M; ++k ) {
+                if ( b[k] != 0.f ) {
+                    for ( int i = k + 1; i < M; ++i ) {
+                        b[i] -= L[AT( i, k, ldl )] * b[k];
+                    }
+                }
+            }
+        }
+    }
+
+    int my_sgetrf_piv_openmp( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return 0; }
+
+        const int nb    = BLOCK_SIZE;
+        int       minMN = std::min( M, N );
+
+        if ( nb >= minMN ) { return my_sgetf2_piv_seq( order, M, N, A, lda, ipiv ); }
+
+        int info = 0;
+        for ( int j = 0; j < minMN; j += nb ) {
+            int jb    = std::min( minMN - j, nb );
+            int iinfo = my_sgetf2_piv_seq( order, M - j, jb, A + AT( j, j, lda ), lda, ipiv + j );
+
+            if ( info == 0 && iinfo > 0 ) { info = iinfo + j; }
+            for ( int i = j; i < j + jb; ++i ) {
+                ipiv[i] += j;
+            }
+
+            slaswp( j, A, lda, j, j + jb - 1, ipiv );
+            if ( j + jb < N ) {
+                slaswp( N - j - jb, A + AT( 0, j + jb, lda ), lda, j, j + jb - 1, ipiv );
+                strsm_llnu( jb, N - j - jb, A + AT( j, j, lda ), lda, A + AT( j, j + jb, lda ), lda );
+
+                if ( j + jb < M ) {
+                    my_sgemm_openmp( order,
+                                     CblasNoTrans,
+                                     CblasNoTrans,
+                                     M - j - jb,
+                                     N - j - jb,
+                                     jb,
+                                     -1.f,
+                                     A + AT( j + jb, j, lda ),
+                                     lda,
+                                     A + AT( j, j + jb, lda ),
+                                     lda,
+                                     1.f,
+                                     A + AT( j + jb, j + jb, lda ),
+                                     lda );
+                }
+            }
+        }
+
+        return info;
+    }
+
+    void my_sgetrs_openmp( CBLAS_ORDER order, int N, int NRHS, const float *A, int lda, const int *ipiv, float *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        // The right-hand sides are independent
+#pragma omp parallel for default( shared )
+        for ( int j = 0; j < NRHS; ++j ) {
+            my_sgetrs_seq( order, N, 1, A, lda, ipiv, B + AT( 0, j, ldb ), ldb );
+        }
+    }
+
+    int my_dsgesv_openmp( CBLAS_ORDER   order,
+                          int           N,
+                          int           NRHS,
+                          double *      A,
+                          int           lda,
+                          int *         ipiv,
+                          const double *B,
+                          int           ldb,
+                          double *      X,
+                          int           ldx,
+                          int *         iter )
+    {
+        return dsgesv<OmpKernels>( order, N, NRHS, A, lda, ipiv, B, ldb, X, ldx, iter );
+    }
+
     int my_idamax_openmp( int N, double *dx, int incX )
     {
         LAHPC_CHECK_POSITIVE_STRICT( N );
         LAHPC_CHECK_POSITIVE_STRICT( incX );
 
-        int idamax = -1;
+        if ( N < PARALLEL_MIN_ELEMENTS ) { return my_idamax_seq( N, dx, incX ); }
 
-        if ( N <= 0 ) { return idamax; }
+        // Index of the maximum of each chunk, -1 for the empty ones
+        std::vector<int> chunkMax( omp_get_max_threads(), -1 );
+#pragma omp parallel default( shared )
+        {
+            int t = omp_get_thread_num();
+            int begin, end;
+            level1Chunk( dx, N, incX, t, omp_get_num_threads(), begin, end );
 
-        idamax     = 0;
-        double max = std::abs( dx[0] );
-        for ( int i = 1, xi = incX; i < N; ++i, xi += incX ) {
-            double tmp = std::abs( dx[i] );
-            if ( tmp > max ) {
-                idamax = i;
-                max    = tmp;
+            // A NaN at the head of a chunk would hide the rest of it, which the sequential search only does for dx[0]
+            if ( t > 0 ) {
+                while ( begin < end && std::isnan( dx[begin * incX] ) ) {
+                    ++begin;
+                }
+            }
+            if ( begin < end ) { chunkMax[t] = begin + my_idamax_seq( end - begin, dx + begin * incX, incX ); }
+        }
+
+        // Chunks are in increasing order, so that keeping only strictly greater maxima returns the first one whatever
+        // the number of threads
+        int    idamax = chunkMax[0];
+        double max    = std::abs( dx[idamax * incX] );
+        for ( size_t t = 1; t < chunkMax.size(); ++t ) {
+            if ( chunkMax[t] >= 0 && std::abs( dx[chunkMax[t] * incX] ) > max ) {
+                idamax = chunkMax[t];
+                max    = std::abs( dx[idamax * incX] );
             }
         }
 
@@ -758,34 +2040,279 @@ namespace my_lapack {
         LAHPC_CHECK_POSITIVE( N );
         LAHPC_CHECK_POSITIVE_STRICT( incX );
 
-        if ( N == 0 ) { return; }
-        if ( da == 0.0 && incX == 1 ) {
-            std::memset( dx, 0, N * sizeof( double ) );
+        if ( N < PARALLEL_MIN_ELEMENTS ) {
+            my_dscal_seq( N, da, dx, incX );
             return;
         }
-        if ( da == 0.0 ) {
-            for ( int i = 0, xi = 0; i < N; ++i, xi += incX ) {
-                dx[xi] = 0.0;
+
+#pragma omp parallel default( shared )
+        {
+            int begin, end;
+            level1Chunk( dx, N, incX, omp_get_thread_num(), omp_get_num_threads(), begin, end );
+            if ( begin < end ) { my_dscal_seq( end - begin, da, dx + begin * incX, incX ); }
+        }
+    }
+
+    // Columns of the strips my_dlaswp_openmp hands out to the threads
+    static const int DLASWP_STRIP = 32;
+
+    void my_dlaswp_openmp( int N, double *A, int lda, int k1, int k2, int *ipv, int incX )
+    {
+        LAHPC_CHECK_POSITIVE( lda );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+
+        int nbStrips = ( N + DLASWP_STRIP - 1 ) / DLASWP_STRIP;
+        if ( nbStrips < 2 || static_cast<long>( N ) * ( k2 - k1 + 1 ) < PARALLEL_MIN_ELEMENTS ) {
+            my_dlaswp_seq( N, A, lda, k1, k2, ipv, incX );
+            return;
+        }
+
+        // The strips are independent, each thread applies all the interchanges to its own
+#pragma omp parallel for default( shared ) schedule( static )
+        for ( int s = 0; s < nbStrips; ++s ) {
+            int j0 = s * DLASWP_STRIP;
+            my_dlaswp_seq( std::min( DLASWP_STRIP, N - j0 ), A + j0 * lda, lda, k1, k2, ipv, incX );
+        }
+    }
+
+    void my_dlacpy_openmp( int M, int N, const double *a, int lda, double *b, int ldb )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, M ) );
+
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dlacpy_seq( M, N, a, lda, b, ldb );
+            return;
+        }
+
+        // Blocks of columns, or blocks of rows when there are fewer columns than threads
+#pragma omp parallel default( shared )
+        {
+            int t  = omp_get_thread_num();
+            int nt = omp_get_num_threads();
+            if ( N >= nt ) {
+                int begin = static_cast<int>( static_cast<long>( N ) * t / nt );
+                int end   = static_cast<int>( static_cast<long>( N ) * ( t + 1 ) / nt );
+                my_dlacpy_seq( M, end - begin, a + AT( 0, begin, lda ), lda, b + AT( 0, begin, ldb ), ldb );
+            }
+            else {
+                int begin, end;
+                level1Chunk( b, M, 1, t, nt, begin, end );
+                if ( begin < end ) { my_dlacpy_seq( end - begin, N, a + begin, lda, b + begin, ldb ); }
             }
         }
-        else {
-            for ( int i = 0, xi = 0; i < N; ++i, xi += incX ) {
-                dx[xi] *= da;
+    }
+
+    // Side of the tiles of B handed out to the threads by my_dlacpy_trans_openmp
+    static const int TRANSPOSE_TILE = 128;
+
+    void my_dlacpy_trans_openmp( int M, int N, const double *a, int lda, double *b, int ldb )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( static_cast<long>( M ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dlacpy_trans_seq( M, N, a, lda, b, ldb );
+            return;
+        }
+
+        int MT = ( M + TRANSPOSE_TILE - 1 ) / TRANSPOSE_TILE;
+        int NT = ( N + TRANSPOSE_TILE - 1 ) / TRANSPOSE_TILE;
+#pragma omp parallel for collapse( 2 ) schedule( static ) default( shared )
+        for ( int jt = 0; jt < NT; ++jt ) {
+            for ( int it = 0; it < MT; ++it ) {
+                int i0 = it * TRANSPOSE_TILE, j0 = jt * TRANSPOSE_TILE;
+                my_dlacpy_trans_seq( std::min( TRANSPOSE_TILE, M - i0 ),
+                                     std::min( TRANSPOSE_TILE, N - j0 ),
+                                     a + AT( i0, j0, lda ),
+                                     lda,
+                                     b + AT( j0, i0, ldb ),
+                                     ldb );
             }
         }
     }
 
-    void my_dlaswp_openmp( int N, double *A, int lda, int k1, int k2, int *ipv, int incX )
+    // First row of the part t of nt of a CSR matrix with M rows. The parts hold about the same number of nonzeros
+    // plus rows, so that neither a few dense rows nor many empty ones unbalance them
+    static int csrRowSplit( const int *rowPtr, int M, int t, int nt )
     {
-        LAHPC_CHECK_POSITIVE( lda );
+        if ( t == 0 ) { return 0; }
+        if ( t == nt ) { return M; }
+        long total  = static_cast<long>( rowPtr[M] - rowPtr[0] ) + M;
+        long target = total * t / nt;
+
+        // First row r whose start, in nonzeros plus rows, reaches the target
+        int lo = 0, hi = M;
+        while ( lo < hi ) {
+            int mid = lo + ( hi - lo ) / 2;
+            if ( static_cast<long>( rowPtr[mid] - rowPtr[0] ) + mid < target ) { lo = mid + 1; }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    void my_dcsrmv_openmp( CBLAS_TRANSPOSE trans,
+                           int             M,
+                           int             N,
+                           double          alpha,
+                           const int *     rowPtr,
+                           const int *     colInd,
+                           const double *  val,
+                           const double *  X,
+                           int             incX,
+                           double          beta,
+                           double *        Y,
+                           int             incY )
+    {
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
         LAHPC_CHECK_POSITIVE( N );
         LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
 
-        for ( int i = k1, xi = k1; i <= k2; ++i, xi += incX ) {
-            int pivot = ipv[xi];
-            if ( pivot != i ) {
-                for ( int j = 0; j < N; ++j ) {
-                    std::swap( A[j * lda + i], A[j * lda + pivot] );
+        if ( static_cast<long>( rowPtr[M] - rowPtr[0] ) + M < PARALLEL_MIN_ELEMENTS ) {
+            my_dcsrmv_seq( trans, M, N, alpha, rowPtr, colInd, val, X, incX, beta, Y, incY );
+            return;
+        }
+
+        if ( trans == CblasNoTrans ) {
+            // Rows are split by nonzeros, each thread writing its own part of Y
+#pragma omp parallel default( shared )
+            {
+                int nt    = omp_get_num_threads();
+                int begin = csrRowSplit( rowPtr, M, omp_get_thread_num(), nt );
+                int end   = csrRowSplit( rowPtr, M, omp_get_thread_num() + 1, nt );
+                if ( begin < end ) {
+                    double *y = Y + begin * incY;
+                    my_dcsrmv_seq( trans, end - begin, N, alpha, rowPtr + begin, colInd, val, X, incX, beta, y, incY );
+                }
+            }
+            return;
+        }
+
+        // The rows of A scatter into all of Y: each thread scatters its rows into a private buffer, the buffers being
+        // summed into Y by blocks after a barrier
+        std::vector<double> partial( static_cast<size_t>( omp_get_max_threads() ) * N, 0. );
+#pragma omp parallel default( shared )
+        {
+            int     t     = omp_get_thread_num();
+            int     nt    = omp_get_num_threads();
+            int     begin = csrRowSplit( rowPtr, M, t, nt );
+            int     end   = csrRowSplit( rowPtr, M, t + 1, nt );
+            double *yt    = partial.data() + static_cast<size_t>( t ) * N;
+            if ( begin < end ) {
+                my_dcsrmv_seq(
+                    trans, end - begin, N, alpha, rowPtr + begin, colInd, val, X + begin * incX, incX, 1., yt, 1 );
+            }
+#pragma omp barrier
+            level1Chunk( Y, N, incY, t, nt, begin, end );
+            for ( int j = begin; j < end; ++j ) {
+                double sum = 0.;
+                for ( int k = 0; k < nt; ++k ) {
+                    sum += partial[static_cast<size_t>( k ) * N + j];
+                }
+                Y[j * incY] = ( beta == 0.0 ) ? sum : beta * Y[j * incY] + sum;
+            }
+        }
+    }
+
+    void my_dcsrmm_openmp( CBLAS_TRANSPOSE transA,
+                           int             M,
+                           int             N,
+                           int             K,
+                           double          alpha,
+                           const int *     rowPtr,
+                           const int *     colInd,
+                           const double *  val,
+                           const double *  B,
+                           int             ldb,
+                           double          beta,
+                           double *        C,
+                           int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, K ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, M ) );
+
+        int rows = ( transA == CblasNoTrans ) ? M : K;
+        if ( ( static_cast<long>( rowPtr[rows] - rowPtr[0] ) + rows ) * N < PARALLEL_MIN_ELEMENTS ) {
+            my_dcsrmm_seq( transA, M, N, K, alpha, rowPtr, colInd, val, B, ldb, beta, C, ldc );
+            return;
+        }
+
+        if ( transA == CblasNoTrans ) {
+            // Rows of A and C split by nonzeros, as for my_dcsrmv_openmp
+#pragma omp parallel default( shared )
+            {
+                int nt    = omp_get_num_threads();
+                int begin = csrRowSplit( rowPtr, M, omp_get_thread_num(), nt );
+                int end   = csrRowSplit( rowPtr, M, omp_get_thread_num() + 1, nt );
+                if ( begin < end ) {
+                    my_dcsrmm_seq(
+                        transA, end - begin, N, K, alpha, rowPtr + begin, colInd, val, B, ldb, beta, C + begin, ldc );
+                }
+            }
+            return;
+        }
+
+        // Disjoint blocks of columns of B and C when there is one per thread, otherwise all of C is written by every
+        // thread and the rows of A go to private copies of C
+        if ( N >= omp_get_max_threads() ) {
+#pragma omp parallel default( shared )
+            {
+                int t     = omp_get_thread_num();
+                int nt    = omp_get_num_threads();
+                int begin = static_cast<int>( static_cast<long>( N ) * t / nt );
+                int end   = static_cast<int>( static_cast<long>( N ) * ( t + 1 ) / nt );
+                my_dcsrmm_seq( transA,
+                               M,
+                               end - begin,
+                               K,
+                               alpha,
+                               rowPtr,
+                               colInd,
+                               val,
+                               B + AT( 0, begin, ldb ),
+                               ldb,
+                               beta,
+                               C + AT( 0, begin, ldc ),
+                               ldc );
+            }
+            return;
+        }
+
+        size_t              size = static_cast<size_t>( M ) * N;
+        std::vector<double> partial( omp_get_max_threads() * size, 0. );
+#pragma omp parallel default( shared )
+        {
+            int     t     = omp_get_thread_num();
+            int     nt    = omp_get_num_threads();
+            int     begin = csrRowSplit( rowPtr, K, t, nt );
+            int     end   = csrRowSplit( rowPtr, K, t + 1, nt );
+            double *ct    = partial.data() + t * size;
+            if ( begin < end ) {
+                my_dcsrmm_seq(
+                    transA, M, N, end - begin, alpha, rowPtr + begin, colInd, val, B + begin, ldb, 1., ct, M );
+            }
+#pragma omp barrier
+            level1Chunk( C, M, 1, t, nt, begin, end );
+            for ( int j = 0; j < N; ++j ) {
+                for ( int i = begin; i < end; ++i ) {
+                    double sum = 0.;
+                    for ( int k = 0; k < nt; ++k ) {
+                        sum += partial[k * size + AT( i, j, M )];
+                    }
+                    C[AT( i, j, ldc )] = ( beta == 0.0 ) ? sum : beta * C[AT( i, j, ldc )] + sum;
                 }
             }
         }
@@ -1,20 +1,14 @@
-#include "err.h"
-#include "my_lapack.h"
+#include "my_lapack_internal.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <limits>
 #include <utility>
-
-#define _LAHPC_BLOCK_SIZE 34
-static const int BLOCK_SIZE = _LAHPC_BLOCK_SIZE;
-
-#define AT_RM( i, j, width ) ( ( i ) * ( width ) + ( j ) )
-#define AT( i, j, heigth ) ( ( i ) + ( j ) * ( heigth ) )
-#define min_macro( a, b ) ( ( a ) < ( b ) ? ( a ) : ( b ) )
+#include <vector>
 
 namespace my_lapack {
 
@@ -24,6 +18,26 @@ namespace my_lapack {
         LAHPC_CHECK_POSITIVE( incX );
         LAHPC_CHECK_POSITIVE( incY );
 
+        if ( incX == 1 && incY == 1 ) {
+            // Eight independent accumulators, so that consecutive FMAs do not wait for each other
+            double s0 = 0., s1 = 0., s2 = 0., s3 = 0., s4 = 0., s5 = 0., s6 = 0., s7 = 0.;
+            int    i  = 0;
+            for ( ; i + 8 <= N; i += 8 ) {
+                s0 += X[i] * Y[i];
+                s1 += X[i + 1] * Y[i + 1];
+                s2 += X[i + 2] * Y[i + 2];
+                s3 += X[i + 3] * Y[i + 3];
+                s4 += X[i + 4] * Y[i + 4];
+                s5 += X[i + 5] * Y[i + 5];
+                s6 += X[i + 6] * Y[i + 6];
+                s7 += X[i + 7] * Y[i + 7];
+            }
+            for ( ; i < N; ++i ) {
+                s0 += X[i] * Y[i];
+            }
+            return ( ( s0 + s1 ) + ( s2 + s3 ) ) + ( ( s4 + s5 ) + ( s6 + s7 ) );
+        }
+
         double ret = 0;
         for ( int i = 0, xi = 0, yi = 0; i < N; ++i, xi += incX, yi += incY ) {
             ret += X[xi] * Y[yi];
@@ -39,11 +53,278 @@ namespace my_lapack {
 
         if ( alpha == 0.0 ) { return; }
 
+        if ( incX == 1 && incY == 1 ) {
+            int i = 0;
+            for ( ; i + 8 <= N; i += 8 ) {
+                Y[i] += alpha * X[i];
+                Y[i + 1] += alpha * X[i + 1];
+                Y[i + 2] += alpha * X[i + 2];
+                Y[i + 3] += alpha * X[i + 3];
+                Y[i + 4] += alpha * X[i + 4];
+                Y[i + 5] += alpha * X[i + 5];
+                Y[i + 6] += alpha * X[i + 6];
+                Y[i + 7] += alpha * X[i + 7];
+            }
+            for ( ; i < N; ++i ) {
+                Y[i] += alpha * X[i];
+            }
+            return;
+        }
+
         for ( int i = 0, xi = 0, yi = 0; i < N; ++i, xi += incX, yi += incY ) {
             Y[yi] += alpha * X[xi];
         }
     }
 
+    void my_daxpby_seq( int N, double alpha, const double *X, int incX, double beta, double *Y, int incY )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( beta == 1.0 ) {
+            my_daxpy_seq( N, alpha, X, incX, Y, incY );
+            return;
+        }
+
+        // Y is not read when beta is zero, as in the BLAS
+        if ( beta == 0.0 ) {
+            for ( int i = 0, xi = 0, yi = 0; i < N; ++i, xi += incX, yi += incY ) {
+                Y[yi] = alpha * X[xi];
+            }
+        }
+        else if ( incX == 1 && incY == 1 ) {
+            for ( int i = 0; i < N; ++i ) {
+                Y[i] = alpha * X[i] + beta * Y[i];
+            }
+        }
+        else {
+            for ( int i = 0, xi = 0, yi = 0; i < N; ++i, xi += incX, yi += incY ) {
+                Y[yi] = alpha * X[xi] + beta * Y[yi];
+            }
+        }
+    }
+
+    double my_daxpy_dot_seq(
+        int N, double alpha, const double *X, int incX, double *Y, int incY, const double *Z, int incZ )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_POSITIVE_STRICT( incZ );
+
+        if ( incX == 1 && incY == 1 && incZ == 1 ) {
+            // Each updated element of Y is used by the dot while still in a register, Z being allowed to be Y
+            double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+            int    i  = 0;
+            for ( ; i + 4 <= N; i += 4 ) {
+                double y0 = Y[i] + alpha * X[i];
+                double y1 = Y[i + 1] + alpha * X[i + 1];
+                double y2 = Y[i + 2] + alpha * X[i + 2];
+                double y3 = Y[i + 3] + alpha * X[i + 3];
+                Y[i]      = y0;
+                Y[i + 1]  = y1;
+                Y[i + 2]  = y2;
+                Y[i + 3]  = y3;
+                s0 += y0 * Z[i];
+                s1 += y1 * Z[i + 1];
+                s2 += y2 * Z[i + 2];
+                s3 += y3 * Z[i + 3];
+            }
+            for ( ; i < N; ++i ) {
+                Y[i] += alpha * X[i];
+                s0 += Y[i] * Z[i];
+            }
+            return ( s0 + s1 ) + ( s2 + s3 );
+        }
+
+        double ret = 0.;
+        for ( int i = 0, xi = 0, yi = 0, zi = 0; i < N; ++i, xi += incX, yi += incY, zi += incZ ) {
+            Y[yi] += alpha * X[xi];
+            ret += Y[yi] * Z[zi];
+        }
+        return ret;
+    }
+
+    void my_ddot2_seq( int N, const double *X, int incX, const double *Y, int incY, double *xy, double *xx )
+    {
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( incX == 1 && incY == 1 ) {
+            double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+            double t0 = 0., t1 = 0., t2 = 0., t3 = 0.;
+            int    i  = 0;
+            for ( ; i + 4 <= N; i += 4 ) {
+                s0 += X[i] * Y[i];
+                s1 += X[i + 1] * Y[i + 1];
+                s2 += X[i + 2] * Y[i + 2];
+                s3 += X[i + 3] * Y[i + 3];
+                t0 += X[i] * X[i];
+                t1 += X[i + 1] * X[i + 1];
+                t2 += X[i + 2] * X[i + 2];
+                t3 += X[i + 3] * X[i + 3];
+            }
+            for ( ; i < N; ++i ) {
+                s0 += X[i] * Y[i];
+                t0 += X[i] * X[i];
+            }
+            *xy = ( s0 + s1 ) + ( s2 + s3 );
+            *xx = ( t0 + t1 ) + ( t2 + t3 );
+            return;
+        }
+
+        double sxy = 0., sxx = 0.;
+        for ( int i = 0, xi = 0, yi = 0; i < N; ++i, xi += incX, yi += incY ) {
+            sxy += X[xi] * Y[yi];
+            sxx += X[xi] * X[xi];
+        }
+        *xy = sxy;
+        *xx = sxx;
+    }
+
+    // Rows of Y updated together by the NoTrans dgemv, small enough to stay in the L1 cache
+    static const int GEMV_ROW_BLOCK = 1024;
+
+    // Y = beta * Y for the dgemv kernels, Y not being read when beta is zero
+    static void dgemv_scale( int lenY, double beta, double *Y, int incY )
+    {
+        if ( beta == 1.0 ) { return; }
+
+        if ( beta == 0 && incY == 1 ) { memset( Y, 0, lenY * sizeof( double ) ); }
+        else if ( beta == 0 ) {
+            for ( int i = 0, yi = 0; i < lenY; ++i, yi += incY ) {
+                Y[yi] = 0;
+            }
+        }
+        else {
+            for ( int i = 0, yi = 0; i < lenY; ++i, yi += incY ) {
+                Y[yi] *= beta;
+            }
+        }
+    }
+
+    // Body of my_dgemv_seq and my_dgemv_norm_seq, once the quick returns are done. With norm, the squared norm of Y is
+    // accumulated as each part of Y is finished, while it is still in cache
+    static double dgemv_kernel( CBLAS_TRANSPOSE TransA,
+                                int             M,
+                                int             N,
+                                double          alpha,
+                                const double *  A,
+                                int             lda,
+                                const double *  X,
+                                int             incX,
+                                double          beta,
+                                double *        Y,
+                                int             incY,
+                                bool            norm )
+    {
+        double nrm2 = 0.;
+
+        dgemv_scale( ( TransA == CblasNoTrans ) ? M : N, beta, Y, incY );
+
+        if ( TransA == CblasNoTrans ) {
+            // Blocks of rows of Y stay in cache while four columns of A at a time are added to them, so that Y is
+            // loaded and stored four times less than A is read
+            for ( int i0 = 0; i0 < M; i0 += GEMV_ROW_BLOCK ) {
+                int           mb = std::min( GEMV_ROW_BLOCK, M - i0 );
+                double *      y  = Y + i0 * incY;
+                const double *a  = A + i0;
+
+                int j = 0;
+                for ( ; j + 4 <= N; j += 4 ) {
+                    double        x0 = alpha * X[j * incX];
+                    double        x1 = alpha * X[( j + 1 ) * incX];
+                    double        x2 = alpha * X[( j + 2 ) * incX];
+                    double        x3 = alpha * X[( j + 3 ) * incX];
+                    const double *a0 = a + AT( 0, j, lda );
+                    const double *a1 = a0 + lda;
+                    const double *a2 = a1 + lda;
+                    const double *a3 = a2 + lda;
+                    if ( incY == 1 ) {
+                        for ( int i = 0; i < mb; ++i ) {
+                            y[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+                        }
+                    }
+                    else {
+                        for ( int i = 0, yi = 0; i < mb; ++i, yi += incY ) {
+                            y[yi] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+                        }
+                    }
+                }
+                for ( ; j < N; ++j ) {
+                    double        x0 = alpha * X[j * incX];
+                    const double *a0 = a + AT( 0, j, lda );
+                    for ( int i = 0, yi = 0; i < mb; ++i, yi += incY ) {
+                        y[yi] += a0[i] * x0;
+                    }
+                }
+                if ( norm ) { nrm2 += my_ddot_seq( mb, y, incY, y, incY ); }
+            }
+        }
+
+        else if ( TransA == CblasTrans ) {
+            // Four dot products at a time share the loads of X, each with two partial sums to keep eight independent
+            // FMA chains
+            int j = 0;
+            for ( ; j + 4 <= N; j += 4 ) {
+                const double *a0 = A + AT( 0, j, lda );
+                const double *a1 = a0 + lda;
+                const double *a2 = a1 + lda;
+                const double *a3 = a2 + lda;
+                double        t0 = 0., t1 = 0., t2 = 0., t3 = 0.;
+                if ( incX == 1 ) {
+                    double u0 = 0., u1 = 0., u2 = 0., u3 = 0.;
+                    int    i  = 0;
+                    for ( ; i + 2 <= M; i += 2 ) {
+                        t0 += a0[i] * X[i];
+                        t1 += a1[i] * X[i];
+                        t2 += a2[i] * X[i];
+                        t3 += a3[i] * X[i];
+                        u0 += a0[i + 1] * X[i + 1];
+                        u1 += a1[i + 1] * X[i + 1];
+                        u2 += a2[i + 1] * X[i + 1];
+                        u3 += a3[i + 1] * X[i + 1];
+                    }
+                    if ( i < M ) {
+                        t0 += a0[i] * X[i];
+                        t1 += a1[i] * X[i];
+                        t2 += a2[i] * X[i];
+                        t3 += a3[i] * X[i];
+                    }
+                    t0 += u0;
+                    t1 += u1;
+                    t2 += u2;
+                    t3 += u3;
+                }
+                else {
+                    for ( int i = 0, xi = 0; i < M; ++i, xi += incX ) {
+                        t0 += a0[i] * X[xi];
+                        t1 += a1[i] * X[xi];
+                        t2 += a2[i] * X[xi];
+                        t3 += a3[i] * X[xi];
+                    }
+                }
+                Y[j * incY] += alpha * t0;
+                Y[( j + 1 ) * incY] += alpha * t1;
+                Y[( j + 2 ) * incY] += alpha * t2;
+                Y[( j + 3 ) * incY] += alpha * t3;
+                if ( norm ) {
+                    for ( int k = j; k < j + 4; ++k ) {
+                        nrm2 += Y[k * incY] * Y[k * incY];
+                    }
+                }
+            }
+            for ( ; j < N; ++j ) {
+                Y[j * incY] += alpha * my_ddot_seq( M, A + AT( 0, j, lda ), 1, X, incX );
+                if ( norm ) { nrm2 += Y[j * incY] * Y[j * incY]; }
+            }
+        }
+
+        return nrm2;
+    }
+
     void my_dgemv_seq( CBLAS_ORDER     layout,
                        CBLAS_TRANSPOSE TransA,
                        int             M,
@@ -66,38 +347,120 @@ namespace my_lapack {
 
         if ( M == 0 || N == 0 || ( alpha == 0.0 && beta == 1.0 ) ) return;
 
-        if ( beta != 1.0 ) {
+        dgemv_kernel( TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY, false );
+    }
+
+    double my_dgemv_norm_seq( CBLAS_ORDER     layout,
+                              CBLAS_TRANSPOSE TransA,
+                              int             M,
+                              int             N,
+                              double          alpha,
+                              const double *  A,
+                              int             lda,
+                              const double *  X,
+                              int             incX,
+                              double          beta,
+                              double *        Y,
+                              const int       incY )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+
+        if ( M == 0 || N == 0 || ( alpha == 0.0 && beta == 1.0 ) ) {
             int lenY = ( TransA == CblasNoTrans ) ? M : N;
+            return my_ddot_seq( lenY, Y, incY, Y, incY );
+        }
 
-            if ( beta == 0 && incY == 1 ) { memset( Y, 0, lenY * sizeof( double ) ); }
-            else if ( beta == 0 ) {
-                for ( int i = 0, yi = 0; i < lenY; ++i, yi += incY ) {
-                    Y[yi] = 0;
-                }
+        return dgemv_kernel( TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY, true );
+    }
+
+    void my_dgemv2_seq( CBLAS_ORDER   layout,
+                        int           M,
+                        int           N,
+                        double        alpha,
+                        const double *A,
+                        int           lda,
+                        const double *X,
+                        int           incX,
+                        const double *Y,
+                        int           incY,
+                        double        beta,
+                        double *      W,
+                        int           incW,
+                        double *      Z,
+                        int           incZ )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+        LAHPC_CHECK_POSITIVE_STRICT( incW );
+        LAHPC_CHECK_POSITIVE_STRICT( incZ );
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+
+        if ( M == 0 || N == 0 || ( alpha == 0.0 && beta == 1.0 ) ) return;
+
+        if ( incY != 1 || incW != 1 ) {
+            // Y and W are walked along the columns of A: strided ones are gathered into contiguous copies, for O( M )
+            std::vector<double> y( M ), w( M );
+            for ( int i = 0; i < M; ++i ) {
+                y[i] = Y[i * incY];
+                w[i] = W[i * incW];
             }
-            else {
-                for ( int i = 0, yi = 0; i < lenY; ++i, yi += incY ) {
-                    Y[yi] *= beta;
-                }
+            my_dgemv2_seq( layout, M, N, alpha, A, lda, X, incX, y.data(), 1, beta, w.data(), 1, Z, incZ );
+            for ( int i = 0; i < M; ++i ) {
+                W[i * incW] = w[i];
             }
+            return;
         }
 
-        if ( TransA == CblasNoTrans ) {
-            for ( int j = 0, xi = 0; j < N; ++j, xi += incX ) {
-                double tmp = alpha * X[xi];
-                for ( int i = 0, yi = 0; i < M; ++i, yi += incY ) {
-                    Y[yi] += tmp * A[j * M + i];
+        dgemv_scale( M, beta, W, 1 );
+        dgemv_scale( N, beta, Z, incZ );
+
+        // Four columns of A at a time, over blocks of rows of W and Y that stay in cache: each element of A is loaded
+        // once for both the update of W and the dot products of Z
+        for ( int i0 = 0; i0 < M; i0 += GEMV_ROW_BLOCK ) {
+            int           mb = std::min( GEMV_ROW_BLOCK, M - i0 );
+            double *      w  = W + i0;
+            const double *y  = Y + i0;
+            const double *a  = A + i0;
+
+            int j = 0;
+            for ( ; j + 4 <= N; j += 4 ) {
+                double        x0 = alpha * X[j * incX];
+                double        x1 = alpha * X[( j + 1 ) * incX];
+                double        x2 = alpha * X[( j + 2 ) * incX];
+                double        x3 = alpha * X[( j + 3 ) * incX];
+                const double *a0 = a + AT( 0, j, lda );
+                const double *a1 = a0 + lda;
+                const double *a2 = a1 + lda;
+                const double *a3 = a2 + lda;
+                double        t0 = 0., t1 = 0., t2 = 0., t3 = 0.;
+                for ( int i = 0; i < mb; ++i ) {
+                    w[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+                    t0 += a0[i] * y[i];
+                    t1 += a1[i] * y[i];
+                    t2 += a2[i] * y[i];
+                    t3 += a3[i] * y[i];
                 }
+                Z[j * incZ] += alpha * t0;
+                Z[( j + 1 ) * incZ] += alpha * t1;
+                Z[( j + 2 ) * incZ] += alpha * t2;
+                Z[( j + 3 ) * incZ] += alpha * t3;
             }
-        }
-
-        else if ( TransA == CblasTrans ) {
-            for ( int j = 0, yi = 0; j < N; ++j, yi += incY ) {
-                double tmp = 0;
-                for ( int i = 0, xi = 0; i < N; ++i, xi += incX ) {
-                    tmp += A[j * M + i] * X[xi];
+            for ( ; j < N; ++j ) {
+                double        x0 = alpha * X[j * incX];
+                const double *a0 = a + AT( 0, j, lda );
+                double        t0 = 0.;
+                for ( int i = 0; i < mb; ++i ) {
+                    w[i] += a0[i] * x0;
+                    t0 += a0[i] * y[i];
                 }
-                Y[yi] += alpha * tmp;
+                Z[j * incZ] += alpha * t0;
             }
         }
     }
@@ -189,6 +552,98 @@ namespace my_lapack {
         }
     }
 
+    // Widest N sent to dgemm_skinny by my_dgemm_seq, and the rows of C (NoTrans A) or the depth (Trans A) of its
+    // blocks, whose part of C or of B stays in the L1 or L2 cache
+    static const int SKINNY_N_MAX = 16;
+    static const int SKINNY_BLOCK = 256;
+
+    // C = alpha * op( A ) * B + beta * C for N <= SKINNY_N_MAX, B not transposed: a multi-vector GEMV reading each
+    // element of A from memory once, instead of once per block column of C as the square tiling does
+    static void dgemm_skinny( bool          bTransA,
+                              int           M,
+                              int           N,
+                              int           K,
+                              double        alpha,
+                              const double *A,
+                              int           lda,
+                              const double *B,
+                              int           ldb,
+                              double        beta,
+                              double *      C,
+                              int           ldc )
+    {
+        for ( int j = 0; j < N; ++j ) {
+            dgemv_scale( M, beta, C + AT( 0, j, ldc ), 1 );
+        }
+
+        if ( !bTransA ) {
+            // Four columns of A, which stay in L1, are added to the N columns of a block of rows of C
+            for ( int i0 = 0; i0 < M; i0 += SKINNY_BLOCK ) {
+                int           mb = std::min( SKINNY_BLOCK, M - i0 );
+                const double *a  = A + i0;
+                int           k  = 0;
+                for ( ; k + 4 <= K; k += 4 ) {
+                    const double *a0 = a + AT( 0, k, lda );
+                    const double *a1 = a0 + lda;
+                    const double *a2 = a1 + lda;
+                    const double *a3 = a2 + lda;
+                    for ( int j = 0; j < N; ++j ) {
+                        const double *b  = B + AT( k, j, ldb );
+                        double        b0 = alpha * b[0], b1 = alpha * b[1], b2 = alpha * b[2], b3 = alpha * b[3];
+                        double *      c  = C + AT( i0, j, ldc );
+                        for ( int i = 0; i < mb; ++i ) {
+                            c[i] += a0[i] * b0 + a1[i] * b1 + a2[i] * b2 + a3[i] * b3;
+                        }
+                    }
+                }
+                for ( ; k < K; ++k ) {
+                    const double *a0 = a + AT( 0, k, lda );
+                    for ( int j = 0; j < N; ++j ) {
+                        double  b0 = alpha * B[AT( k, j, ldb )];
+                        double *c  = C + AT( i0, j, ldc );
+                        for ( int i = 0; i < mb; ++i ) {
+                            c[i] += a0[i] * b0;
+                        }
+                    }
+                }
+            }
+            return;
+        }
+
+        // Four columns of A, over a block of depth staying in L1, give the dot products of four rows of C with the
+        // same block of the N columns of B
+        for ( int k0 = 0; k0 < K; k0 += SKINNY_BLOCK ) {
+            int kb = std::min( SKINNY_BLOCK, K - k0 );
+            int i  = 0;
+            for ( ; i + 4 <= M; i += 4 ) {
+                const double *a0 = A + AT( k0, i, lda );
+                const double *a1 = a0 + lda;
+                const double *a2 = a1 + lda;
+                const double *a3 = a2 + lda;
+                for ( int j = 0; j < N; ++j ) {
+                    const double *b  = B + AT( k0, j, ldb );
+                    double        t0 = 0., t1 = 0., t2 = 0., t3 = 0.;
+                    for ( int k = 0; k < kb; ++k ) {
+                        t0 += a0[k] * b[k];
+                        t1 += a1[k] * b[k];
+                        t2 += a2[k] * b[k];
+                        t3 += a3[k] * b[k];
+                    }
+                    double *c = C + AT( i, j, ldc );
+                    c[0] += alpha * t0;
+                    c[1] += alpha * t1;
+                    c[2] += alpha * t2;
+                    c[3] += alpha * t3;
+                }
+            }
+            for ( ; i < M; ++i ) {
+                for ( int j = 0; j < N; ++j ) {
+                    C[AT( i, j, ldc )] += alpha * my_ddot_seq( kb, A + AT( k0, i, lda ), 1, B + AT( k0, j, ldb ), 1 );
+                }
+            }
+        }
+    }
+
     void my_dgemm_seq( CBLAS_ORDER     Order,
                        CBLAS_TRANSPOSE TransA,
                        CBLAS_TRANSPOSE TransB,
@@ -225,12 +680,29 @@ namespace my_lapack {
         bool bTransA = ( TransA == CblasTrans );
         bool bTransB = ( TransB == CblasTrans );
 
+        if ( N <= SKINNY_N_MAX ) {
+            // A transposed B is only K x N: it is copied once so that the skinny kernel walks its columns
+            if ( bTransB ) {
+                std::vector<double> Bt( static_cast<size_t>( K ) * N );
+                my_dlacpy_trans_seq( N, K, B, ldb, Bt.data(), std::max( 1, K ) );
+                dgemm_skinny( bTransA, M, N, K, alpha, A, lda, Bt.data(), std::max( 1, K ), beta, C, ldc );
+            }
+            else {
+                dgemm_skinny( bTransA, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc );
+            }
+            return;
+        }
+
         int lastMBB = M % BLOCK_SIZE;
         int lastNBB = N % BLOCK_SIZE;
         int lastKBB = K % BLOCK_SIZE;
         int MB      = lastMBB ? ( M / BLOCK_SIZE ) + 1 : ( M / BLOCK_SIZE );
         int NB      = lastNBB ? ( N / BLOCK_SIZE ) + 1 : ( N / BLOCK_SIZE );
         int KB      = lastKBB ? ( K / BLOCK_SIZE ) + 1 : ( K / BLOCK_SIZE );
+        // Last blocks are full when the dimensions are multiples of BLOCK_SIZE
+        if ( !lastMBB ) { lastMBB = BLOCK_SIZE; }
+        if ( !lastNBB ) { lastNBB = BLOCK_SIZE; }
+        if ( !lastKBB ) { lastKBB = BLOCK_SIZE; }
 
         double *C_padding;
         int     m, n, k, m_blk, n_blk;
@@ -356,6 +828,107 @@ namespace my_lapack {
         }
     }
 
+    void my_dtile_mask_seq( int M, int N, const double *A, int lda, unsigned char *mask )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int MT = tileCount( M ), NT = tileCount( N );
+        for ( int tj = 0; tj < NT; ++tj ) {
+            int nb = std::min( BLOCK_SIZE, N - tj * BLOCK_SIZE );
+            for ( int ti = 0; ti < MT; ++ti ) {
+                int           mb   = std::min( BLOCK_SIZE, M - ti * BLOCK_SIZE );
+                const double *tile = A + BLOCK_SIZE * AT( ti, tj, lda );
+
+                // Dense tiles stop at their first nonzero, only zero tiles are read entirely
+                unsigned char nonzero = 0;
+                for ( int j = 0; j < nb && !nonzero; ++j ) {
+                    for ( int i = 0; i < mb; ++i ) {
+                        if ( tile[AT( i, j, lda )] != 0. ) {
+                            nonzero = 1;
+                            break;
+                        }
+                    }
+                }
+                mask[ti + tj * MT] = nonzero;
+            }
+        }
+    }
+
+    void my_dgemm_masked_seq( CBLAS_ORDER          Order,
+                              CBLAS_TRANSPOSE      TransA,
+                              CBLAS_TRANSPOSE      TransB,
+                              int                  M,
+                              int                  N,
+                              int                  K,
+                              double               alpha,
+                              const double *       A,
+                              int                  lda,
+                              const unsigned char *maskA,
+                              const double *       B,
+                              int                  ldb,
+                              const unsigned char *maskB,
+                              double               beta,
+                              double *             C,
+                              int                  ldc )
+    {
+        LAHPC_CHECK_PREDICATE( Order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+        LAHPC_CHECK_PREDICATE( ( TransB == CblasTrans ) || ( TransB == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+        LAHPC_CHECK_POSITIVE_STRICT( ldc );
+
+        bool bTransA = ( TransA == CblasTrans );
+        bool bTransB = ( TransB == CblasTrans );
+        int  MT = tileCount( M ), NT = tileCount( N ), KT = tileCount( K );
+
+        std::vector<unsigned char> ownMaskA, ownMaskB;
+        if ( !maskA ) {
+            ownMaskA.resize( static_cast<size_t>( MT ) * KT );
+            my_dtile_mask_seq( bTransA ? K : M, bTransA ? M : K, A, lda, ownMaskA.data() );
+            maskA = ownMaskA.data();
+        }
+        if ( !maskB ) {
+            ownMaskB.resize( static_cast<size_t>( KT ) * NT );
+            my_dtile_mask_seq( bTransB ? N : K, bTransB ? K : N, B, ldb, ownMaskB.data() );
+            maskB = ownMaskB.data();
+        }
+
+        for ( int n = 0; n < NT; ++n ) {
+            int nb = std::min( BLOCK_SIZE, N - n * BLOCK_SIZE );
+            for ( int m = 0; m < MT; ++m ) {
+                int     mb   = std::min( BLOCK_SIZE, M - m * BLOCK_SIZE );
+                double *tile = C + BLOCK_SIZE * AT( m, n, ldc );
+                for ( int j = 0; j < nb; ++j ) {
+                    dgemv_scale( mb, beta, tile + AT( 0, j, ldc ), 1 );
+                }
+
+                for ( int k = 0; k < KT; ++k ) {
+                    if ( !tileProductNonzero( bTransA, bTransB, m, n, k, MT, NT, KT, maskA, maskB ) ) { continue; }
+                    my_dgemm_scal_seq( Order,
+                                       TransA,
+                                       TransB,
+                                       mb,
+                                       nb,
+                                       std::min( BLOCK_SIZE, K - k * BLOCK_SIZE ),
+                                       alpha,
+                                       A + BLOCK_SIZE * ( bTransA ? AT( k, m, lda ) : AT( m, k, lda ) ),
+                                       lda,
+                                       B + BLOCK_SIZE * ( bTransB ? AT( n, k, ldb ) : AT( k, n, ldb ) ),
+                                       ldb,
+                                       1.,
+                                       tile,
+                                       ldc );
+                }
+            }
+        }
+    }
+
     void my_dger_seq( CBLAS_ORDER   layout,
                       int           M,
                       int           N,
@@ -376,12 +949,45 @@ namespace my_lapack {
 
         if ( M == 0 || N == 0 || alpha == 0.0 ) { return; }
 
-        for ( int i = 0; i < M; ++i ) {
-            double tmp = alpha * X[i * incX];
-            for ( int j = 0; j < N; ++j ) {
-                A[i + j * lda] += tmp * Y[j * incY];
-            }
+        // Column by column, each one being a contiguous axpy with the whole X
+        for ( int j = 0; j < N; ++j ) {
+            double tmp = alpha * Y[j * incY];
+            if ( tmp != 0.0 ) { my_daxpy_seq( M, tmp, X, incX, A + AT( 0, j, lda ), 1 ); }
+        }
+    }
+
+    void my_dscal_dger_seq( CBLAS_ORDER   layout,
+                            int           M,
+                            int           N,
+                            double        scale,
+                            double *      X,
+                            int           incX,
+                            double        alpha,
+                            const double *Y,
+                            int           incY,
+                            double *      A,
+                            int           lda )
+    {
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( M == 0 ) { return; }
+        if ( N == 0 || alpha == 0.0 ) {
+            my_dscal_seq( M, scale, X, incX );
+            return;
         }
+
+        // X is scaled while the first column is updated, instead of in a pass of its own
+        double tmp = alpha * Y[0];
+        for ( int i = 0, xi = 0; i < M; ++i, xi += incX ) {
+            X[xi] *= scale;
+            A[i] += tmp * X[xi];
+        }
+        my_dger_seq( layout, M, N - 1, alpha, X, incX, Y + incY, incY, A + lda, lda );
     }
 
     void my_dgetf2_seq( CBLAS_ORDER order, int M, int N, double *A, int lda )
@@ -395,42 +1001,38 @@ namespace my_lapack {
         int minMN = std::min( M, N );
 
         for ( int j = 0; j < minMN; ++j ) {
-            if ( j < M - 1 ) { my_dscal( M - j - 1, 1.0 / A[j * lda + j], A + j * lda + j + 1, 1 ); }
             if ( j < minMN - 1 ) {
-                my_dger_seq( CblasColMajor,
-                             M - j - 1,
-                             N - j - 1,
-                             -1.0,
-                             A + j * lda + j + 1,
-                             1,
-                             A + ( j + 1 ) * lda + j,
-                             lda,
-                             A + ( j + 1 ) * lda + j + 1,
-                             lda );
+                my_dscal_dger_seq( CblasColMajor,
+                                   M - j - 1,
+                                   N - j - 1,
+                                   1.0 / A[j * lda + j],
+                                   A + j * lda + j + 1,
+                                   1,
+                                   -1.0,
+                                   A + ( j + 1 ) * lda + j,
+                                   lda,
+                                   A + ( j + 1 ) * lda + j + 1,
+                                   lda );
+            }
+            else if ( j < M - 1 ) {
+                my_dscal_seq( M - j - 1, 1.0 / A[j * lda + j], A + j * lda + j + 1, 1 );
             }
         }
     }
 
-    void my_dtrsm_seq( CBLAS_ORDER     layout,
-                       CBLAS_SIDE      side,
-                       CBLAS_UPLO      uplo,
-                       CBLAS_TRANSPOSE transA,
-                       CBLAS_DIAG      diag,
-                       int             M,
-                       int             N,
-                       double          alpha,
-                       const double *  A,
-                       int             lda,
-                       double *        B,
-                       int             ldb )
+    // Substitution kernel of the diagonal blocks of dtrsmBlocked
+    static void dtrsm_unblocked( CBLAS_SIDE      side,
+                                 CBLAS_UPLO      uplo,
+                                 CBLAS_TRANSPOSE transA,
+                                 CBLAS_DIAG      diag,
+                                 int             M,
+                                 int             N,
+                                 double          alpha,
+                                 const double *  A,
+                                 int             lda,
+                                 double *        B,
+                                 int             ldb )
     {
-        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
-        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
-        LAHPC_CHECK_POSITIVE( M );
-        LAHPC_CHECK_POSITIVE( N );
-        LAHPC_CHECK_POSITIVE_STRICT( lda );
-        LAHPC_CHECK_POSITIVE_STRICT( ldb );
-
         double lambda;
 
         if ( M == 0 || N == 0 ) return;
@@ -530,7 +1132,7 @@ namespace my_lapack {
                                 B[i + j * ldb] *= alpha;
                             }
                         }
-                        for ( int k = 0; k < j - 1; k++ ) {
+                        for ( int k = 0; k < j; k++ ) {
                             if ( A[k + j * lda] != 0.0 ) {
                                 for ( int i = 0; i < M; i++ ) {
                                     B[i + j * ldb] -= A[k + j * lda] * B[i + k * ldb];
@@ -614,7 +1216,7 @@ namespace my_lapack {
                         }
                         if ( alpha != 1.0 ) {
                             for ( int i = 0; i < M; ++i ) {
-                                B[i + k * lda] = alpha * B[i + k * ldb];
+                                B[i + k * ldb] = alpha * B[i + k * ldb];
                             }
                         }
                     }
@@ -623,60 +1225,1558 @@ namespace my_lapack {
         }
     }
 
-    void my_dgetrf_seq( CBLAS_ORDER order, int M, int N, double *A, int lda )
+    void dtrsmDiagonal( CBLAS_SIDE      side,
+                        CBLAS_UPLO      uplo,
+                        CBLAS_TRANSPOSE transA,
+                        CBLAS_DIAG      diag,
+                        int             M,
+                        int             N,
+                        double          alpha,
+                        const double *  A,
+                        int             lda,
+                        const double *  invA,
+                        int             k,
+                        double *        B,
+                        int             ldb,
+                        double *        work )
     {
-        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
-        LAHPC_CHECK_POSITIVE( M );
-        LAHPC_CHECK_POSITIVE( N );
-        LAHPC_CHECK_POSITIVE_STRICT( lda );
-
-        if ( M == 0 || N == 0 ) { return; }
-
-        const int nb    = 10;
-        int       minMN = std::min( M, N );
-
-        if ( nb <= 1 || nb >= minMN ) {
-            my_dgetf2_seq( order, M, N, A, lda );
+        if ( invA == nullptr ) {
+            dtrsm_unblocked( side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb );
             return;
         }
 
-        for ( int j = 0; j < minMN; j += nb ) {
-            int jb = std::min( minMN - j, nb );
-            my_dgetf2_seq( order, M - j, jb, A + j * lda + j, lda );
-            if ( j + jb < N ) {
-                my_dtrsm_seq( order,
-                              CblasLeft,
-                              CblasLower,
-                              CblasNoTrans,
+        const double *invBlock = invA + AT( 0, k, BLOCK_SIZE );
+        my_dlacpy_seq( M, N, B, ldb, work, M );
+        if ( side == CblasLeft ) {
+            // The transposed block is formed once, the GEMM being much faster on a non transposed left operand
+            double opInv[BLOCK_SIZE * BLOCK_SIZE];
+            if ( transA == CblasTrans ) {
+                my_dlacpy_trans_seq( M, M, invBlock, BLOCK_SIZE, opInv, BLOCK_SIZE );
+                invBlock = opInv;
+            }
+            my_dgemm_seq(
+                CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, M, alpha, invBlock, BLOCK_SIZE, work, M, 0., B, ldb );
+        }
+        else {
+            my_dgemm_seq(
+                CblasColMajor, CblasNoTrans, transA, M, N, N, alpha, work, M, invBlock, BLOCK_SIZE, 0., B, ldb );
+        }
+    }
+
+    void my_dtrsm_seq( CBLAS_ORDER     layout,
+                       CBLAS_SIDE      side,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE transA,
+                       CBLAS_DIAG      diag,
+                       int             M,
+                       int             N,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       double *        B,
+                       int             ldb )
+    {
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+
+        dtrsmBlocked<SeqKernels>( side, uplo, transA, diag, M, N, alpha, A, lda, nullptr, B, ldb );
+    }
+
+    // Inverse of a triangular matrix by columns, each one being the product of the already inverted part with the
+    // original column, as in the reference dtrti2
+    static void dtrti2( CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, double *A, int lda )
+    {
+        bool bUnit = ( diag == CblasUnit );
+
+        if ( uplo == CblasUpper ) {
+            for ( int j = 0; j < N; ++j ) {
+                double ajj = -1.;
+                if ( !bUnit ) {
+                    A[AT( j, j, lda )] = 1. / A[AT( j, j, lda )];
+                    ajj                = -A[AT( j, j, lda )];
+                }
+                // A( 0:j, j ) = ajj * A( 0:j, 0:j ) * A( 0:j, j )
+                double *x = A + AT( 0, j, lda );
+                for ( int k = 0; k < j; ++k ) {
+                    double xk = x[k];
+                    for ( int i = 0; i < k; ++i ) {
+                        x[i] += xk * A[AT( i, k, lda )];
+                    }
+                    x[k] = bUnit ? xk : xk * A[AT( k, k, lda )];
+                }
+                for ( int i = 0; i < j; ++i ) {
+                    x[i] *= ajj;
+                }
+            }
+        }
+        else {
+            for ( int j = N - 1; j >= 0; --j ) {
+                double ajj = -1.;
+                if ( !bUnit ) {
+                    A[AT( j, j, lda )] = 1. / A[AT( j, j, lda )];
+                    ajj                = -A[AT( j, j, lda )];
+                }
+                // A( j+1:N, j ) = ajj * A( j+1:N, j+1:N ) * A( j+1:N, j )
+                double *x = A + AT( 0, j, lda );
+                for ( int k = N - 1; k > j; --k ) {
+                    double xk = x[k];
+                    for ( int i = k + 1; i < N; ++i ) {
+                        x[i] += xk * A[AT( i, k, lda )];
+                    }
+                    x[k] = bUnit ? xk : xk * A[AT( k, k, lda )];
+                }
+                for ( int i = j + 1; i < N; ++i ) {
+                    x[i] *= ajj;
+                }
+            }
+        }
+    }
+
+    // B = T * B, T being the M-by-M triangular matrix already inverted by my_dtrtri_seq
+    static void
+        dtrmm_left( CBLAS_UPLO uplo, CBLAS_DIAG diag, int M, int N, const double *T, int ldt, double *B, int ldb )
+    {
+        bool bUnit = ( diag == CblasUnit );
+
+        for ( int j = 0; j < N; ++j ) {
+            double *x = B + AT( 0, j, ldb );
+            if ( uplo == CblasUpper ) {
+                for ( int k = 0; k < M; ++k ) {
+                    double xk = x[k];
+                    for ( int i = 0; i < k; ++i ) {
+                        x[i] += xk * T[AT( i, k, ldt )];
+                    }
+                    x[k] = bUnit ? xk : xk * T[AT( k, k, ldt )];
+                }
+            }
+            else {
+                for ( int k = M - 1; k >= 0; --k ) {
+                    double xk = x[k];
+                    for ( int i = k + 1; i < M; ++i ) {
+                        x[i] += xk * T[AT( i, k, ldt )];
+                    }
+                    x[k] = bUnit ? xk : xk * T[AT( k, k, ldt )];
+                }
+            }
+        }
+    }
+
+    int my_dtrtri_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( diag == CblasUnit ) || ( diag == CblasNonUnit ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        if ( diag == CblasNonUnit ) {
+            for ( int j = 0; j < N; ++j ) {
+                if ( A[AT( j, j, lda )] == 0. ) { return j + 1; }
+            }
+        }
+
+        const int nb = BLOCK_SIZE;
+        if ( N <= nb ) {
+            dtrti2( uplo, diag, N, A, lda );
+            return 0;
+        }
+
+        // Blocks of columns (upper) or rows (lower) are computed from the part of the inverse already obtained:
+        // A( 0:j, j:j+jb ) = -A( 0:j, 0:j )^-1 * A( 0:j, j:j+jb ) * A( j:j+jb, j:j+jb )^-1 for the upper case
+        if ( uplo == CblasUpper ) {
+            for ( int j = 0; j < N; j += nb ) {
+                int jb = std::min( nb, N - j );
+                if ( j > 0 ) {
+                    dtrmm_left( uplo, diag, j, jb, A, lda, A + AT( 0, j, lda ), lda );
+                    my_dtrsm_seq( order,
+                                  CblasRight,
+                                  uplo,
+                                  CblasNoTrans,
+                                  diag,
+                                  j,
+                                  jb,
+                                  -1.,
+                                  A + AT( j, j, lda ),
+                                  lda,
+                                  A + AT( 0, j, lda ),
+                                  lda );
+                }
+                dtrti2( uplo, diag, jb, A + AT( j, j, lda ), lda );
+            }
+        }
+        else {
+            for ( int j = ( ( N - 1 ) / nb ) * nb; j >= 0; j -= nb ) {
+                int jb = std::min( nb, N - j );
+                if ( j + jb < N ) {
+                    dtrmm_left(
+                        uplo, diag, N - j - jb, jb, A + AT( j + jb, j + jb, lda ), lda, A + AT( j + jb, j, lda ), lda );
+                    my_dtrsm_seq( order,
+                                  CblasRight,
+                                  uplo,
+                                  CblasNoTrans,
+                                  diag,
+                                  N - j - jb,
+                                  jb,
+                                  -1.,
+                                  A + AT( j, j, lda ),
+                                  lda,
+                                  A + AT( j + jb, j, lda ),
+                                  lda );
+                }
+                dtrti2( uplo, diag, jb, A + AT( j, j, lda ), lda );
+            }
+        }
+
+        return 0;
+    }
+
+    // Copies the kb-by-kb diagonal block A into inv, of leading dimension BLOCK_SIZE, with zeros in its other triangle
+    // and ones on a unit diagonal so that GEMMs can use it as is, and inverts it there
+    static int dtrtri_diag_block( CBLAS_UPLO uplo, CBLAS_DIAG diag, int kb, const double *A, int lda, double *inv )
+    {
+        for ( int j = 0; j < kb; ++j ) {
+            for ( int i = 0; i < kb; ++i ) {
+                bool bStored                = ( uplo == CblasLower ) ? i >= j : i <= j;
+                inv[AT( i, j, BLOCK_SIZE )] = bStored ? A[AT( i, j, lda )] : 0.;
+            }
+            if ( diag == CblasUnit ) { inv[AT( j, j, BLOCK_SIZE )] = 1.; }
+        }
+        return my_dtrtri_seq( CblasColMajor, uplo, diag, kb, inv, BLOCK_SIZE );
+    }
+
+    int my_dtrtri_diag_seq(
+        CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_DIAG diag, int N, const double *A, int lda, double *invA )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( diag == CblasUnit ) || ( diag == CblasNonUnit ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        for ( int k = 0; k < N; k += BLOCK_SIZE ) {
+            int kb   = std::min( BLOCK_SIZE, N - k );
+            int info = dtrtri_diag_block( uplo, diag, kb, A + AT( k, k, lda ), lda, invA + AT( 0, k, BLOCK_SIZE ) );
+            if ( info != 0 ) { return k + info; }
+        }
+        return 0;
+    }
+
+    void my_dtrsm_inv_seq( CBLAS_ORDER     layout,
+                           CBLAS_SIDE      side,
+                           CBLAS_UPLO      uplo,
+                           CBLAS_TRANSPOSE transA,
+                           CBLAS_DIAG      diag,
+                           int             M,
+                           int             N,
+                           double          alpha,
+                           const double *  A,
+                           int             lda,
+                           const double *  invA,
+                           double *        B,
+                           int             ldb )
+    {
+        LAHPC_CHECK_PREDICATE( layout == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+
+        dtrsmBlocked<SeqKernels>( side, uplo, transA, diag, M, N, alpha, A, lda, invA, B, ldb );
+    }
+
+    void my_dgetrf_seq( CBLAS_ORDER order, int M, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+
+        if ( M == 0 || N == 0 ) { return; }
+
+        const int nb    = 10;
+        int       minMN = std::min( M, N );
+
+        if ( nb <= 1 || nb >= minMN ) {
+            my_dgetf2_seq( order, M, N, A, lda );
+            return;
+        }
+
+        for ( int j = 0; j < minMN; j += nb ) {
+            int jb = std::min( minMN - j, nb );
+            my_dgetf2_seq( order, M - j, jb, A + j * lda + j, lda );
+            if ( j + jb < N ) {
+                my_dtrsm_seq( order,
+                              CblasLeft,
+                              CblasLower,
+                              CblasNoTrans,
+                              CblasUnit,
+                              jb,
+                              N - j - jb,
+                              1.0,
+                              A + j * lda + j,
+                              lda,
+                              A + ( j + jb ) * lda + j,
+                              lda );
+
+                if ( j + jb < M ) {
+                    my_dgemm_seq( CblasColMajor,
+                                  CblasNoTrans,
+                                  CblasNoTrans,
+                                  M - j - jb,
+                                  N - j - jb,
+                                  jb,
+                                  -1.0,
+                                  A + j * lda + j + jb,
+                                  lda,
+                                  A + ( j + jb ) * lda + j,
+                                  lda,
+                                  1.0,
+                                  A + ( j + jb ) * lda + j + jb,
+                                  lda );
+                }
+            }
+        }
+    }
+
+    int my_dgetf2_piv_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int info  = 0;
+        int minMN = std::min( M, N );
+
+        for ( int j = 0; j < minMN; ++j ) {
+            ipiv[j] = j + my_idamax_seq( M - j, A + j * lda + j, 1 );
+
+            // A zero column is left as is, only the trailing update being applied
+            double scale = 1.0;
+            if ( A[j * lda + ipiv[j]] != 0.0 ) {
+                my_dlaswp_seq( N, A, lda, j, j, ipiv, 1 );
+                scale = 1.0 / A[j * lda + j];
+            }
+            else if ( info == 0 ) {
+                info = j + 1;
+            }
+
+            if ( j < minMN - 1 ) {
+                my_dscal_dger_seq( CblasColMajor,
+                                   M - j - 1,
+                                   N - j - 1,
+                                   scale,
+                                   A + j * lda + j + 1,
+                                   1,
+                                   -1.0,
+                                   A + ( j + 1 ) * lda + j,
+                                   lda,
+                                   A + ( j + 1 ) * lda + j + 1,
+                                   lda );
+            }
+            else if ( j < M - 1 ) {
+                my_dscal_seq( M - j - 1, scale, A + j * lda + j + 1, 1 );
+            }
+        }
+
+        return info;
+    }
+
+    int my_dgetrf_piv_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return 0; }
+
+        const int nb    = BLOCK_SIZE;
+        int       minMN = std::min( M, N );
+
+        if ( nb >= minMN ) { return my_dgetf2_piv_seq( order, M, N, A, lda, ipiv ); }
+
+        int info = 0;
+        for ( int j = 0; j < minMN; j += nb ) {
+            int jb    = std::min( minMN - j, nb );
+            int iinfo = my_dgetf2_piv_seq( order, M - j, jb, A + j * lda + j, lda, ipiv + j );
+
+            if ( info == 0 && iinfo > 0 ) { info = iinfo + j; }
+            for ( int i = j; i < j + jb; ++i ) {
+                ipiv[i] += j;
+            }
+
+            // Apply the interchanges of the panel to the columns on its left and on its right
+            my_dlaswp_seq( j, A, lda, j, j + jb - 1, ipiv, 1 );
+            if ( j + jb < N ) {
+                my_dlaswp_seq( N - j - jb, A + ( j + jb ) * lda, lda, j, j + jb - 1, ipiv, 1 );
+
+                my_dtrsm_seq( order,
+                              CblasLeft,
+                              CblasLower,
+                              CblasNoTrans,
                               CblasUnit,
                               jb,
                               N - j - jb,
                               1.0,
-                              A + j * lda + j,
-                              lda,
-                              A + ( j + jb ) * lda + j,
-                              lda );
+                              A + j * lda + j,
+                              lda,
+                              A + ( j + jb ) * lda + j,
+                              lda );
+
+                if ( j + jb < M ) {
+                    my_dgemm_seq( CblasColMajor,
+                                  CblasNoTrans,
+                                  CblasNoTrans,
+                                  M - j - jb,
+                                  N - j - jb,
+                                  jb,
+                                  -1.0,
+                                  A + j * lda + j + jb,
+                                  lda,
+                                  A + ( j + jb ) * lda + j,
+                                  lda,
+                                  1.0,
+                                  A + ( j + jb ) * lda + j + jb,
+                                  lda );
+                }
+            }
+        }
+
+        return info;
+    }
+
+    void my_dgetrs_seq( CBLAS_ORDER   order,
+                        int           N,
+                        int           NRHS,
+                        const double *A,
+                        int           lda,
+                        const int *   ipiv,
+                        double *      B,
+                        int           ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        my_dlaswp_seq( NRHS, B, ldb, 0, N - 1, const_cast<int *>( ipiv ), 1 );
+
+        // Forward substitution L * Y = P * B, by blocks of BLOCK_SIZE rows: a triangular solve on the diagonal
+        // block, then a GEMM update of all the rows below it
+        for ( int k = 0; k < N; k += BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, kb, NRHS, 1.0, A + k * lda + k, lda, B + k, ldb );
+            if ( k + kb < N ) {
+                my_dgemm_seq( CblasColMajor,
+                              CblasNoTrans,
+                              CblasNoTrans,
+                              N - k - kb,
+                              NRHS,
+                              kb,
+                              -1.0,
+                              A + k * lda + k + kb,
+                              lda,
+                              B + k,
+                              ldb,
+                              1.0,
+                              B + k + kb,
+                              ldb );
+            }
+        }
+
+        // Backward substitution U * X = Y, starting from the last block
+        for ( int k = ( ( N - 1 ) / BLOCK_SIZE ) * BLOCK_SIZE; k >= 0; k -= BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq( order,
+                          CblasLeft,
+                          CblasUpper,
+                          CblasNoTrans,
+                          CblasNonUnit,
+                          kb,
+                          NRHS,
+                          1.0,
+                          A + k * lda + k,
+                          lda,
+                          B + k,
+                          ldb );
+            if ( k > 0 ) {
+                my_dgemm_seq( CblasColMajor,
+                              CblasNoTrans,
+                              CblasNoTrans,
+                              k,
+                              NRHS,
+                              kb,
+                              -1.0,
+                              A + k * lda,
+                              lda,
+                              B + k,
+                              ldb,
+                              1.0,
+                              B,
+                              ldb );
+            }
+        }
+    }
+
+    int my_dgesv_seq( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, int *ipiv, double *B, int ldb )
+    {
+        int info = my_dgetrf_piv_seq( order, N, N, A, lda, ipiv );
+        if ( info == 0 ) { my_dgetrs_seq( order, N, NRHS, A, lda, ipiv, B, ldb ); }
+        return info;
+    }
+
+    int my_dgbtrf_seq( CBLAS_ORDER order, int N, int KL, int KU, double *AB, int ldab, int *ipiv )
+    {
+        return dgbtrf<SeqKernels>( order, N, KL, KU, AB, ldab, ipiv );
+    }
+
+    void my_dgbtrs_seq( CBLAS_ORDER   order,
+                        int           N,
+                        int           KL,
+                        int           KU,
+                        int           NRHS,
+                        const double *AB,
+                        int           ldab,
+                        const int *   ipiv,
+                        double *      B,
+                        int           ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( KL );
+        LAHPC_CHECK_POSITIVE( KU );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( ldab >= 2 * KL + KU + 1 );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        int kv = KL + KU;
+
+        // L * Y = P * B, applying the interchange and the multipliers of each column in turn, as they are stored
+        for ( int j = 0; j < N - 1 && KL > 0; ++j ) {
+            int lm = std::min( KL, N - 1 - j );
+            my_dlaswp_seq( NRHS, B, ldb, j, j, const_cast<int *>( ipiv ), 1 );
+            my_dger_seq(
+                CblasColMajor, lm, NRHS, -1., bandAt( AB, ldab, kv, j + 1, j ), 1, B + j, ldb, B + j + 1, ldb );
+        }
+
+        // U * X = Y, U being upper triangular with KL + KU superdiagonals
+        for ( int j = N - 1; j >= 0; --j ) {
+            my_dscal_seq( NRHS, 1. / *bandAt( AB, ldab, kv, j, j ), B + j, ldb );
+            int i0 = std::max( 0, j - kv );
+            if ( i0 < j ) {
+                my_dger_seq(
+                    CblasColMajor, j - i0, NRHS, -1., bandAt( AB, ldab, kv, i0, j ), 1, B + j, ldb, B + i0, ldb );
+            }
+        }
+    }
+
+    // LU factorization of a small matrix copied into a local buffer of leading dimension NMAX. The buffer is a stack
+    // array that stays in L1 (32 KB for NMAX = 64), not in registers. With EXACT, N = NMAX is a compile time constant
+    // too, so that the compiler can unroll and vectorize the loops with no remainder handling.
+    template<int NMAX, bool EXACT>
+    static int dgetrf_small( int nArg, double *A, int lda, int *ipiv )
+    {
+        const int n = EXACT ? NMAX : nArg;
+        double    a[NMAX * NMAX];
+
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < n; ++i ) {
+                a[AT( i, j, NMAX )] = A[AT( i, j, lda )];
+            }
+        }
+
+        int info = 0;
+        for ( int j = 0; j < n; ++j ) {
+            int    p    = j;
+            double amax = std::fabs( a[AT( j, j, NMAX )] );
+            for ( int i = j + 1; i < n; ++i ) {
+                if ( std::fabs( a[AT( i, j, NMAX )] ) > amax ) {
+                    amax = std::fabs( a[AT( i, j, NMAX )] );
+                    p    = i;
+                }
+            }
+            ipiv[j] = p;
+
+            if ( a[AT( p, j, NMAX )] != 0. ) {
+                if ( p != j ) {
+                    for ( int c = 0; c < n; ++c ) {
+                        std::swap( a[AT( j, c, NMAX )], a[AT( p, c, NMAX )] );
+                    }
+                }
+                double r = 1. / a[AT( j, j, NMAX )];
+                for ( int i = j + 1; i < n; ++i ) {
+                    a[AT( i, j, NMAX )] *= r;
+                }
+            }
+            else if ( info == 0 ) {
+                info = j + 1;
+            }
+
+            for ( int c = j + 1; c < n; ++c ) {
+                double t = a[AT( j, c, NMAX )];
+                for ( int i = j + 1; i < n; ++i ) {
+                    a[AT( i, c, NMAX )] -= a[AT( i, j, NMAX )] * t;
+                }
+            }
+        }
+
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < n; ++i ) {
+                A[AT( i, j, lda )] = a[AT( i, j, NMAX )];
+            }
+        }
+
+        return info;
+    }
+
+    // Forward and backward substitutions of a small system, one right-hand side at a time in a local buffer
+    template<int NMAX, bool EXACT>
+    static void dgetrs_small( int nArg, int NRHS, const double *A, int lda, const int *ipiv, double *B, int ldb )
+    {
+        const int n = EXACT ? NMAX : nArg;
+        double    x[NMAX];
+
+        for ( int r = 0; r < NRHS; ++r ) {
+            double *b = B + AT( 0, r, ldb );
+            for ( int i = 0; i < n; ++i ) {
+                x[i] = b[i];
+            }
+            for ( int i = 0; i < n; ++i ) {
+                std::swap( x[i], x[ipiv[i]] );
+            }
+
+            for ( int k = 0; k < n; ++k ) {
+                for ( int i = k + 1; i < n; ++i ) {
+                    x[i] -= A[AT( i, k, lda )] * x[k];
+                }
+            }
+            for ( int k = n - 1; k >= 0; --k ) {
+                x[k] /= A[AT( k, k, lda )];
+                for ( int i = 0; i < k; ++i ) {
+                    x[i] -= A[AT( i, k, lda )] * x[k];
+                }
+            }
+
+            for ( int i = 0; i < n; ++i ) {
+                b[i] = x[i];
+            }
+        }
+    }
+
+    template<int NMAX, bool EXACT>
+    static void dgetrf_small_batch( int N, double **A, int lda, int **ipiv, int *info, int batchCount )
+    {
+        for ( int b = 0; b < batchCount; ++b ) {
+            info[b] = dgetrf_small<NMAX, EXACT>( N, A[b], lda, ipiv[b] );
+        }
+    }
+
+    template<int NMAX, bool EXACT>
+    static void dgetrs_small_batch( int                  N,
+                                    int                  NRHS,
+                                    const double *const *A,
+                                    int                  lda,
+                                    const int *const *   ipiv,
+                                    double **            B,
+                                    int                  ldb,
+                                    int                  batchCount )
+    {
+        for ( int b = 0; b < batchCount; ++b ) {
+            dgetrs_small<NMAX, EXACT>( N, NRHS, A[b], lda, ipiv[b], B[b], ldb );
+        }
+    }
+
+    void my_dgetrf_batch_seq( CBLAS_ORDER order, int N, double **A, int lda, int **ipiv, int *info, int batchCount )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_POSITIVE( batchCount );
+
+        // The size class is chosen once for the whole batch, matrices larger than 64 use the blocked factorization
+        if ( N == 8 ) { dgetrf_small_batch<8, true>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N < 8 ) { dgetrf_small_batch<8, false>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N == 16 ) { dgetrf_small_batch<16, true>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N < 16 ) { dgetrf_small_batch<16, false>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N == 32 ) { dgetrf_small_batch<32, true>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N < 32 ) { dgetrf_small_batch<32, false>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N == 64 ) { dgetrf_small_batch<64, true>( N, A, lda, ipiv, info, batchCount ); }
+        else if ( N < 64 ) { dgetrf_small_batch<64, false>( N, A, lda, ipiv, info, batchCount ); }
+        else {
+            for ( int b = 0; b < batchCount; ++b ) {
+                info[b] = my_dgetrf_piv_seq( order, N, N, A[b], lda, ipiv[b] );
+            }
+        }
+    }
+
+    void my_dgetrs_batch_seq( CBLAS_ORDER          order,
+                              int                  N,
+                              int                  NRHS,
+                              const double *const *A,
+                              int                  lda,
+                              const int *const *   ipiv,
+                              double **            B,
+                              int                  ldb,
+                              int                  batchCount )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+        LAHPC_CHECK_POSITIVE( batchCount );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        if ( N == 8 ) { dgetrs_small_batch<8, true>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N < 8 ) { dgetrs_small_batch<8, false>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N == 16 ) { dgetrs_small_batch<16, true>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N < 16 ) { dgetrs_small_batch<16, false>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N == 32 ) { dgetrs_small_batch<32, true>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N < 32 ) { dgetrs_small_batch<32, false>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N == 64 ) { dgetrs_small_batch<64, true>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else if ( N < 64 ) { dgetrs_small_batch<64, false>( N, NRHS, A, lda, ipiv, B, ldb, batchCount ); }
+        else {
+            for ( int b = 0; b < batchCount; ++b ) {
+                my_dgetrs_seq( order, N, NRHS, A[b], lda, ipiv[b], B[b], ldb );
+            }
+        }
+    }
+
+    void my_dsyrk_seq( CBLAS_ORDER     order,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       int             N,
+                       int             K,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       double          beta,
+                       double *        C,
+                       int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, trans == CblasNoTrans ? N : K ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, N ) );
+
+        if ( N == 0 || ( ( alpha == 0. || K == 0 ) && beta == 1. ) ) { return; }
+
+        bool bTrans = ( trans == CblasTrans );
+
+        for ( int j = 0; j < N; j += BLOCK_SIZE ) {
+            int jb = std::min( BLOCK_SIZE, N - j );
+
+            // Diagonal block: only its uplo triangle is computed
+            for ( int c = j; c < j + jb; ++c ) {
+                int rBegin = ( uplo == CblasLower ) ? c : j;
+                int rEnd   = ( uplo == CblasLower ) ? j + jb : c + 1;
+                for ( int r = rBegin; r < rEnd; ++r ) {
+                    double s = 0.;
+                    if ( bTrans ) {
+                        for ( int k = 0; k < K; ++k ) {
+                            s += A[AT( k, r, lda )] * A[AT( k, c, lda )];
+                        }
+                    }
+                    else {
+                        for ( int k = 0; k < K; ++k ) {
+                            s += A[AT( r, k, lda )] * A[AT( c, k, lda )];
+                        }
+                    }
+                    C[AT( r, c, ldc )] = ( beta == 0. ? 0. : beta * C[AT( r, c, ldc )] ) + alpha * s;
+                }
+            }
+
+            // Off-diagonal blocks of the block column are plain GEMM
+            if ( uplo == CblasLower && j + jb < N ) {
+                my_dgemm_seq( order,
+                              bTrans ? CblasTrans : CblasNoTrans,
+                              bTrans ? CblasNoTrans : CblasTrans,
+                              N - j - jb,
+                              jb,
+                              K,
+                              alpha,
+                              bTrans ? A + AT( 0, j + jb, lda ) : A + j + jb,
+                              lda,
+                              bTrans ? A + AT( 0, j, lda ) : A + j,
+                              lda,
+                              beta,
+                              C + AT( j + jb, j, ldc ),
+                              ldc );
+            }
+            else if ( uplo == CblasUpper && j > 0 ) {
+                my_dgemm_seq( order,
+                              bTrans ? CblasTrans : CblasNoTrans,
+                              bTrans ? CblasNoTrans : CblasTrans,
+                              j,
+                              jb,
+                              K,
+                              alpha,
+                              A,
+                              lda,
+                              bTrans ? A + AT( 0, j, lda ) : A + j,
+                              lda,
+                              beta,
+                              C + AT( 0, j, ldc ),
+                              ldc );
+            }
+        }
+    }
+
+    int my_dpotf2_seq( CBLAS_ORDER order, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        for ( int j = 0; j < N; ++j ) {
+            double ajj = A[AT( j, j, lda )] - my_ddot_seq( j, A + j, lda, A + j, lda );
+            if ( ajj <= 0. || std::isnan( ajj ) ) {
+                A[AT( j, j, lda )] = ajj;
+                return j + 1;
+            }
+            ajj                = std::sqrt( ajj );
+            A[AT( j, j, lda )] = ajj;
+
+            if ( j < N - 1 ) {
+                // A( j+1:N, j ) -= A( j+1:N, 0:j ) * A( j, 0:j )^t
+                if ( j > 0 ) {
+                    my_dgemm_seq( order,
+                                  CblasNoTrans,
+                                  CblasTrans,
+                                  N - j - 1,
+                                  1,
+                                  j,
+                                  -1.0,
+                                  A + j + 1,
+                                  lda,
+                                  A + j,
+                                  lda,
+                                  1.0,
+                                  A + AT( j + 1, j, lda ),
+                                  lda );
+                }
+                my_dscal_seq( N - j - 1, 1.0 / ajj, A + AT( j + 1, j, lda ), 1 );
+            }
+        }
+
+        return 0;
+    }
+
+    int my_dpotrf_seq( CBLAS_ORDER order, int N, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        if ( N == 0 ) { return 0; }
+
+        const int nb = BLOCK_SIZE;
+
+        if ( nb >= N ) { return my_dpotf2_seq( order, N, A, lda ); }
+
+        for ( int j = 0; j < N; j += nb ) {
+            int jb   = std::min( N - j, nb );
+            int info = my_dpotf2_seq( order, jb, A + AT( j, j, lda ), lda );
+            if ( info > 0 ) { return info + j; }
+
+            if ( j + jb < N ) {
+                // L21 = A21 * L11^-t, then A22 -= L21 * L21^t
+                my_dtrsm_seq( order,
+                              CblasRight,
+                              CblasLower,
+                              CblasTrans,
+                              CblasNonUnit,
+                              N - j - jb,
+                              jb,
+                              1.0,
+                              A + AT( j, j, lda ),
+                              lda,
+                              A + AT( j + jb, j, lda ),
+                              lda );
+                my_dsyrk_seq( order,
+                              CblasLower,
+                              CblasNoTrans,
+                              N - j - jb,
+                              jb,
+                              -1.0,
+                              A + AT( j + jb, j, lda ),
+                              lda,
+                              1.0,
+                              A + AT( j + jb, j + jb, lda ),
+                              lda );
+            }
+        }
+
+        return 0;
+    }
+
+    void my_dpotrs_seq( CBLAS_ORDER order, int N, int NRHS, const double *A, int lda, double *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        // L * Y = B
+        for ( int k = 0; k < N; k += BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, kb, NRHS, 1.0, A + AT( k, k, lda ), lda, B + k, ldb );
+            if ( k + kb < N ) {
+                my_dgemm_seq( order,
+                              CblasNoTrans,
+                              CblasNoTrans,
+                              N - k - kb,
+                              NRHS,
+                              kb,
+                              -1.0,
+                              A + AT( k + kb, k, lda ),
+                              lda,
+                              B + k,
+                              ldb,
+                              1.0,
+                              B + k + kb,
+                              ldb );
+            }
+        }
+
+        // L^t * X = Y
+        for ( int k = ( ( N - 1 ) / BLOCK_SIZE ) * BLOCK_SIZE; k >= 0; k -= BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, N - k );
+            my_dtrsm_seq(
+                order, CblasLeft, CblasLower, CblasTrans, CblasNonUnit, kb, NRHS, 1.0, A + AT( k, k, lda ), lda, B + k, ldb );
+            if ( k > 0 ) {
+                my_dgemm_seq( order,
+                              CblasTrans,
+                              CblasNoTrans,
+                              k,
+                              NRHS,
+                              kb,
+                              -1.0,
+                              A + k,
+                              lda,
+                              B + k,
+                              ldb,
+                              1.0,
+                              B,
+                              ldb );
+            }
+        }
+    }
+
+    int my_dposv_seq( CBLAS_ORDER order, int N, int NRHS, double *A, int lda, double *B, int ldb )
+    {
+        int info = my_dpotrf_seq( order, N, A, lda );
+        if ( info == 0 ) { my_dpotrs_seq( order, N, NRHS, A, lda, B, ldb ); }
+        return info;
+    }
+
+    void my_dtrttf_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *A, int lda, double *ARF )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        RfpBlocks b = rfpLayout( uplo, N );
+
+        // The columns of L11 and L21, or of U12 and U22, are contiguous in both storages
+        if ( uplo == CblasLower ) {
+            for ( int j = 0; j < b.n1; ++j ) {
+                std::copy( A + AT( j, j, lda ), A + AT( N, j, lda ), ARF + b.t1 + AT( j, j, b.ld ) );
+            }
+            transposeTriangle( true, b.n2, A + AT( b.n1, b.n1, lda ), lda, ARF + b.t2, b.ld, 0, tileCount( b.n2 ) );
+        }
+        else {
+            for ( int c = 0; c < b.n2; ++c ) {
+                std::copy( A + AT( 0, b.n1 + c, lda ), A + AT( b.n1 + c + 1, b.n1 + c, lda ), ARF + AT( 0, c, b.ld ) );
+            }
+            transposeTriangle( false, b.n1, A, lda, ARF + b.t1, b.ld, 0, tileCount( b.n1 ) );
+        }
+    }
+
+    void my_dtfttr_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, const double *ARF, double *A, int lda )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( uplo == CblasLower ) || ( uplo == CblasUpper ) );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+
+        RfpBlocks b = rfpLayout( uplo, N );
+
+        if ( uplo == CblasLower ) {
+            for ( int j = 0; j < b.n1; ++j ) {
+                const double *col = ARF + b.t1 + AT( j, j, b.ld );
+                std::copy( col, col + N - j, A + AT( j, j, lda ) );
+            }
+            transposeTriangle(
+                false, b.n2, ARF + b.t2, b.ld, A + AT( b.n1, b.n1, lda ), lda, 0, tileCount( b.n2 ) );
+        }
+        else {
+            for ( int c = 0; c < b.n2; ++c ) {
+                const double *col = ARF + AT( 0, c, b.ld );
+                std::copy( col, col + b.n1 + c + 1, A + AT( 0, b.n1 + c, lda ) );
+            }
+            transposeTriangle( true, b.n1, ARF + b.t1, b.ld, A, lda, 0, tileCount( b.n1 ) );
+        }
+    }
+
+    int my_dpftrf_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, double *ARF )
+    {
+        return pftrf<SeqKernels>( order, uplo, N, ARF );
+    }
+
+    void my_dpftrs_seq( CBLAS_ORDER order, CBLAS_UPLO uplo, int N, int NRHS, const double *ARF, double *B, int ldb )
+    {
+        pftrs<SeqKernels>( order, uplo, N, NRHS, ARF, B, ldb );
+    }
+
+    void my_dtfsm_seq( CBLAS_ORDER     order,
+                       CBLAS_SIDE      side,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       CBLAS_DIAG      diag,
+                       int             M,
+                       int             N,
+                       double          alpha,
+                       const double *  ARF,
+                       double *        B,
+                       int             ldb )
+    {
+        tfsm<SeqKernels>( order, side, uplo, trans, diag, M, N, alpha, ARF, B, ldb );
+    }
+
+    void my_dsfrk_seq( CBLAS_ORDER     order,
+                       CBLAS_UPLO      uplo,
+                       CBLAS_TRANSPOSE trans,
+                       int             N,
+                       int             K,
+                       double          alpha,
+                       const double *  A,
+                       int             lda,
+                       double          beta,
+                       double *        CRF )
+    {
+        sfrk<SeqKernels>( order, uplo, trans, N, K, alpha, A, lda, beta, CRF );
+    }
+
+    // Euclidean norm, scaled to avoid overflow and underflow as in the reference dnrm2
+    static double dnrm2( int N, const double *X )
+    {
+        double scale = 0.;
+        double ssq   = 1.;
+        for ( int i = 0; i < N; ++i ) {
+            if ( X[i] != 0. ) {
+                double absxi = std::fabs( X[i] );
+                if ( scale < absxi ) {
+                    ssq   = 1. + ssq * ( scale / absxi ) * ( scale / absxi );
+                    scale = absxi;
+                }
+                else {
+                    ssq += ( absxi / scale ) * ( absxi / scale );
+                }
+            }
+        }
+        return scale * std::sqrt( ssq );
+    }
+
+    // Generates the elementary reflector H = I - tau * v * v^t such that H * ( alpha, x ) = ( beta, 0 ), v( 0 ) = 1
+    // and v( 1:N ) overwrites x
+    static double dlarfg( int N, double *alpha, double *x )
+    {
+        if ( N <= 1 ) { return 0.; }
+
+        double xnorm = dnrm2( N - 1, x );
+        if ( xnorm == 0. ) { return 0.; }
+
+        double beta = -std::copysign( std::hypot( *alpha, xnorm ), *alpha );
+        double tau  = ( beta - *alpha ) / beta;
+        my_dscal_seq( N - 1, 1. / ( *alpha - beta ), x, 1 );
+        *alpha = beta;
+
+        return tau;
+    }
+
+    void my_dgeqr2_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int                 K = std::min( M, N );
+        std::vector<double> work( N );
+
+        for ( int j = 0; j < K; ++j ) {
+            tau[j] = dlarfg( M - j, A + AT( j, j, lda ), A + AT( std::min( j + 1, M - 1 ), j, lda ) );
+
+            // A( j:M, j+1:N ) = H( j ) * A( j:M, j+1:N )
+            if ( j < N - 1 && tau[j] != 0. ) {
+                double ajj         = A[AT( j, j, lda )];
+                A[AT( j, j, lda )] = 1.;
+                my_dgemm_seq( order,
+                              CblasTrans,
+                              CblasNoTrans,
+                              N - j - 1,
+                              1,
+                              M - j,
+                              1.0,
+                              A + AT( j, j + 1, lda ),
+                              lda,
+                              A + AT( j, j, lda ),
+                              lda,
+                              0.0,
+                              work.data(),
+                              N );
+                my_dger_seq(
+                    order, M - j, N - j - 1, -tau[j], A + AT( j, j, lda ), 1, work.data(), 1, A + AT( j, j + 1, lda ), lda );
+                A[AT( j, j, lda )] = ajj;
+            }
+        }
+    }
+
+    void my_dlarft_seq( CBLAS_ORDER order, int M, int K, const double *V, int ldv, const double *tau, double *T, int ldt )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( K <= M );
+        LAHPC_CHECK_PREDICATE( ldv >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldt >= std::max( 1, K ) );
+
+        for ( int i = 0; i < K; ++i ) {
+            if ( tau[i] == 0. ) {
+                for ( int l = 0; l <= i; ++l ) {
+                    T[AT( l, i, ldt )] = 0.;
+                }
+                continue;
+            }
+
+            // T( 0:i, i ) = -tau( i ) * V( i:M, 0:i )^t * V( i:M, i ), the unit diagonal of V being implicit
+            for ( int l = 0; l < i; ++l ) {
+                T[AT( l, i, ldt )] = -tau[i] * V[AT( i, l, ldv )];
+            }
+            if ( i > 0 && i < M - 1 ) {
+                my_dgemm_seq( order,
+                              CblasTrans,
+                              CblasNoTrans,
+                              i,
+                              1,
+                              M - i - 1,
+                              -tau[i],
+                              V + i + 1,
+                              ldv,
+                              V + AT( i + 1, i, ldv ),
+                              ldv,
+                              1.0,
+                              T + AT( 0, i, ldt ),
+                              ldt );
+            }
+
+            // T( 0:i, i ) = T( 0:i, 0:i ) * T( 0:i, i ), rows are updated top-down so that the inputs are still intact
+            for ( int r = 0; r < i; ++r ) {
+                double s = 0.;
+                for ( int c = r; c < i; ++c ) {
+                    s += T[AT( r, c, ldt )] * T[AT( c, i, ldt )];
+                }
+                T[AT( r, i, ldt )] = s;
+            }
+            T[AT( i, i, ldt )] = tau[i];
+        }
+    }
+
+    void my_dlarfb_seq( CBLAS_ORDER     order,
+                        CBLAS_SIDE      side,
+                        CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        int             K,
+                        const double *  V,
+                        int             ldv,
+                        const double *  T,
+                        int             ldt,
+                        double *        C,
+                        int             ldc )
+    {
+        dlarfb<SeqKernels>( order, side, trans, M, N, K, V, ldv, T, ldt, C, ldc );
+    }
+
+    void my_dgeqrf_seq( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        const int nb = BLOCK_SIZE;
+        int       K  = std::min( M, N );
+
+        if ( nb >= K ) {
+            my_dgeqr2_seq( order, M, N, A, lda, tau );
+            return;
+        }
+
+        std::vector<double> T( nb * nb );
+
+        for ( int j = 0; j < K; j += nb ) {
+            int jb = std::min( K - j, nb );
+            my_dgeqr2_seq( order, M - j, jb, A + AT( j, j, lda ), lda, tau + j );
+
+            // A( j:M, j+jb:N ) = H^t * A( j:M, j+jb:N ), H = I - V * T * V^t being the block reflector of the panel
+            if ( j + jb < N ) {
+                my_dlarft_seq( order, M - j, jb, A + AT( j, j, lda ), lda, tau + j, T.data(), nb );
+                my_dlarfb_seq( order,
+                               CblasLeft,
+                               CblasTrans,
+                               M - j,
+                               N - j - jb,
+                               jb,
+                               A + AT( j, j, lda ),
+                               lda,
+                               T.data(),
+                               nb,
+                               A + AT( j, j + jb, lda ),
+                               lda );
+            }
+        }
+    }
+
+    void my_dormqr_seq( CBLAS_ORDER     order,
+                        CBLAS_SIDE      side,
+                        CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        int             K,
+                        const double *  A,
+                        int             lda,
+                        const double *  tau,
+                        double *        C,
+                        int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( side == CblasLeft ) || ( side == CblasRight ) );
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( K <= ( side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, side == CblasLeft ? M : N ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 || K == 0 ) { return; }
+
+        const int           nb = BLOCK_SIZE;
+        std::vector<double> T( nb * nb );
+
+        // Q = H( 0 ) * ... * H( K-1 ): Q^t * C and C * Q apply the blocks first to last, Q * C and C * Q^t last to first
+        bool forward = ( side == CblasLeft ) == ( trans == CblasTrans );
+        int  nbBlocks = ( K + nb - 1 ) / nb;
+
+        for ( int b = 0; b < nbBlocks; ++b ) {
+            int i  = ( forward ? b : nbBlocks - 1 - b ) * nb;
+            int ib = std::min( nb, K - i );
+            int nq = ( side == CblasLeft ) ? M : N;
+
+            my_dlarft_seq( order, nq - i, ib, A + AT( i, i, lda ), lda, tau + i, T.data(), nb );
+            if ( side == CblasLeft ) {
+                my_dlarfb_seq( order, side, trans, M - i, N, ib, A + AT( i, i, lda ), lda, T.data(), nb, C + i, ldc );
+            }
+            else {
+                my_dlarfb_seq(
+                    order, side, trans, M, N - i, ib, A + AT( i, i, lda ), lda, T.data(), nb, C + AT( 0, i, ldc ), ldc );
+            }
+        }
+    }
+
+    int my_dgels_seq( CBLAS_ORDER order, int M, int N, int NRHS, double *A, int lda, double *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( M >= N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, M ) );
+
+        if ( N == 0 || NRHS == 0 ) { return 0; }
+
+        std::vector<double> tau( N );
+        my_dgeqrf_seq( order, M, N, A, lda, tau.data() );
+
+        for ( int j = 0; j < N; ++j ) {
+            if ( A[AT( j, j, lda )] == 0. ) { return j + 1; }
+        }
+
+        // B( 0:N, : ) = R^-1 * ( Q^t * B )( 0:N, : )
+        my_dormqr_seq( order, CblasLeft, CblasTrans, M, NRHS, N, A, lda, tau.data(), B, ldb );
+        my_dtrsm_seq( order, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, N, NRHS, 1.0, A, lda, B, ldb );
+
+        return 0;
+    }
+
+    void my_sgemm_seq( CBLAS_ORDER     Order,
+                       CBLAS_TRANSPOSE TransA,
+                       CBLAS_TRANSPOSE TransB,
+                       int             M,
+                       int             N,
+                       int             K,
+                       float           alpha,
+                       const float *   A,
+                       int             lda,
+                       const float *   B,
+                       int             ldb,
+                       float           beta,
+                       float *         C,
+                       int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( Order == CblasColMajor );
+        LAHPC_CHECK_PREDICATE( ( TransA == CblasTrans ) || ( TransA == CblasNoTrans ) );
+        LAHPC_CHECK_PREDICATE( ( TransB == CblasTrans ) || ( TransB == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_POSITIVE_STRICT( lda );
+        LAHPC_CHECK_POSITIVE_STRICT( ldb );
+        LAHPC_CHECK_POSITIVE_STRICT( ldc );
+
+        if ( M == 0 || N == 0 || ( ( alpha == 0.f || K == 0 ) && beta == 1.f ) ) { return; }
+
+        bool bTransA = ( TransA == CblasTrans );
+        bool bTransB = ( TransB == CblasTrans );
+
+        if ( beta != 1.f ) {
+            for ( int j = 0; j < N; ++j ) {
+                for ( int i = 0; i < M; ++i ) {
+                    C[AT( i, j, ldc )] = ( beta == 0.f ) ? 0.f : beta * C[AT( i, j, ldc )];
+                }
+            }
+        }
+        if ( alpha == 0.f ) { return; }
+
+        // The BLOCK_SIZE x BLOCK_SIZE block of A stays in cache while it sweeps the columns of C
+        for ( int k0 = 0; k0 < K; k0 += BLOCK_SIZE ) {
+            int kb = std::min( BLOCK_SIZE, K - k0 );
+            for ( int i0 = 0; i0 < M; i0 += BLOCK_SIZE ) {
+                int ib = std::min( BLOCK_SIZE, M - i0 );
+                for ( int j = 0; j < N; ++j ) {
+                    float *c = C + AT( i0, j, ldc );
+                    if ( !bTransA ) {
+                        for ( int k = k0; k < k0 + kb; ++k ) {
+                            float        b = alpha * ( bTransB ? B[AT( j, k, ldb )] : B[AT( k, j, ldb )] );
+                            const float *a = A + AT( i0, k, lda );
+                            for ( int i = 0; i < ib; ++i ) {
+                                c[i] += a[i] * b;
+                            }
+                        }
+                    }
+                    else {
+                        for ( int i = 0; i < ib; ++i ) {
+                            const float *a = A + AT( k0, i0 + i, lda );
+                            float        s = 0.f;
+                            for ( int k = 0; k < kb; ++k ) {
+                                s += a[k] * ( bTransB ? B[AT( j, k0 + k, ldb )] : B[AT( k0 + k, j, ldb )] );
+                            }
+                            c[i] += alpha * s;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static void slaswp( int N, float *A, int lda, int k1, int k2, const int *ipiv )
+    {
+        for ( int j = 0; j < N; ++j ) {
+            for ( int i = k1; i <= k2; ++i ) {
+                if ( ipiv[i] != i ) { std::swap( A[AT( i, j, lda )], A[AT( ipiv[i], j, lda )] ); }
+            }
+        }
+    }
+
+    // B = L^-1 * B, L being unit lower triangular
+    static void strsm_llnu( int M, int N, const float *L, int ldl, float *B, int ldb )
+    {
+        for ( int j = 0; j < N; ++j ) {
+            float *b = B + AT( 0, j, ldb );
+            for ( int k = 0; k < M; ++k ) {
+                if ( b[k] != 0.f ) {
+                    for ( int i = k + 1; i < M; ++i ) {
+                        b[i] -= L[AT( i, k, ldl )] * b[k];
+                    }
+                }
+            }
+        }
+    }
+
+    // B = U^-1 * B, U being upper triangular
+    static void strsm_lunn( int M, int N, const float *U, int ldu, float *B, int ldb )
+    {
+        for ( int j = 0; j < N; ++j ) {
+            float *b = B + AT( 0, j, ldb );
+            for ( int k = M - 1; k >= 0; --k ) {
+                if ( b[k] != 0.f ) {
+                    b[k] /= U[AT( k, k, ldu )];
+                    for ( int i = 0; i < k; ++i ) {
+                        b[i] -= U[AT( i, k, ldu )] * b[k];
+                    }
+                }
+            }
+        }
+    }
+
+    int my_sgetf2_piv_seq( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        int info  = 0;
+        int minMN = std::min( M, N );
+
+        for ( int j = 0; j < minMN; ++j ) {
+            int   p    = j;
+            float amax = std::fabs( A[AT( j, j, lda )] );
+            for ( int i = j + 1; i < M; ++i ) {
+                if ( std::fabs( A[AT( i, j, lda )] ) > amax ) {
+                    amax = std::fabs( A[AT( i, j, lda )] );
+                    p    = i;
+                }
+            }
+            ipiv[j] = p;
+
+            if ( A[AT( p, j, lda )] != 0.f ) {
+                slaswp( N, A, lda, j, j, ipiv );
+                float r = 1.f / A[AT( j, j, lda )];
+                for ( int i = j + 1; i < M; ++i ) {
+                    A[AT( i, j, lda )] *= r;
+                }
+            }
+            else if ( info == 0 ) {
+                info = j + 1;
+            }
+
+            // Rank-one update of the trailing submatrix, column by column
+            for ( int c = j + 1; c < N; ++c ) {
+                float t = A[AT( j, c, lda )];
+                if ( t != 0.f ) {
+                    for ( int i = j + 1; i < M; ++i ) {
+                        A[AT( i, c, lda )] -= A[AT( i, j, lda )] * t;
+                    }
+                }
+            }
+        }
+
+        return info;
+    }
+
+    int my_sgetrf_piv_seq( CBLAS_ORDER order, int M, int N, float *A, int lda, int *ipiv )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return 0; }
+
+        const int nb    = BLOCK_SIZE;
+        int       minMN = std::min( M, N );
+
+        if ( nb >= minMN ) { return my_sgetf2_piv_seq( order, M, N, A, lda, ipiv ); }
+
+        int info = 0;
+        for ( int j = 0; j < minMN; j += nb ) {
+            int jb    = std::min( minMN - j, nb );
+            int iinfo = my_sgetf2_piv_seq( order, M - j, jb, A + AT( j, j, lda ), lda, ipiv + j );
+
+            if ( info == 0 && iinfo > 0 ) { info = iinfo + j; }
+            for ( int i = j; i < j + jb; ++i ) {
+                ipiv[i] += j;
+            }
+
+            slaswp( j, A, lda, j, j + jb - 1, ipiv );
+            if ( j + jb < N ) {
+                slaswp( N - j - jb, A + AT( 0, j + jb, lda ), lda, j, j + jb - 1, ipiv );
+                strsm_llnu( jb, N - j - jb, A + AT( j, j, lda ), lda, A + AT( j, j + jb, lda ), lda );
 
                 if ( j + jb < M ) {
-                    my_dgemm_seq( CblasColMajor,
+                    my_sgemm_seq( order,
                                   CblasNoTrans,
                                   CblasNoTrans,
                                   M - j - jb,
                                   N - j - jb,
                                   jb,
-                                  -1.0,
-                                  A + j * lda + j + jb,
+                                  -1.f,
+                                  A + AT( j + jb, j, lda ),
                                   lda,
-                                  A + ( j + jb ) * lda + j,
+                                  A + AT( j, j + jb, lda ),
                                   lda,
-                                  1.0,
-                                  A + ( j + jb ) * lda + j + jb,
+                                  1.f,
+                                  A + AT( j + jb, j + jb, lda ),
                                   lda );
                 }
             }
         }
+
+        return info;
+    }
+
+    void my_sgetrs_seq( CBLAS_ORDER order, int N, int NRHS, const float *A, int lda, const int *ipiv, float *B, int ldb )
+    {
+        LAHPC_CHECK_PREDICATE( order == CblasColMajor );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( NRHS );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, N ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        if ( N == 0 || NRHS == 0 ) { return; }
+
+        slaswp( NRHS, B, ldb, 0, N - 1, ipiv );
+        strsm_llnu( N, NRHS, A, lda, B, ldb );
+        strsm_lunn( N, NRHS, A, lda, B, ldb );
     }
 
+    int my_dsgesv_seq( CBLAS_ORDER   order,
+                       int           N,
+                       int           NRHS,
+                       double *      A,
+                       int           lda,
+                       int *         ipiv,
+                       const double *B,
+                       int           ldb,
+                       double *      X,
+                       int           ldx,
+                       int *         iter )
+    {
+        return dsgesv<SeqKernels>( order, N, NRHS, A, lda, ipiv, B, ldb, X, ldx, iter );
+    }
+
+    // Elements per block of the contiguous search. The maximum of a block is a plain reduction that vectorizes, and the
+    // block is only scanned again for its index when it beats the maximum so far, which is rare past the first blocks
+    static const int IDAMAX_BLOCK = 256;
+
     int my_idamax_seq( int N, double *dx, int incX )
     {
         LAHPC_CHECK_POSITIVE_STRICT( N );
@@ -688,8 +2788,35 @@ namespace my_lapack {
 
         idamax     = 0;
         double max = std::abs( dx[0] );
+
+        if ( incX == 1 ) {
+            for ( int b = 0; b < N; b += IDAMAX_BLOCK ) {
+                int    end = std::min( N, b + IDAMAX_BLOCK );
+                double m0 = -1., m1 = -1., m2 = -1., m3 = -1.;
+                int    i  = b;
+                for ( ; i + 4 <= end; i += 4 ) {
+                    m0 = std::max( m0, std::abs( dx[i] ) );
+                    m1 = std::max( m1, std::abs( dx[i + 1] ) );
+                    m2 = std::max( m2, std::abs( dx[i + 2] ) );
+                    m3 = std::max( m3, std::abs( dx[i + 3] ) );
+                }
+                for ( ; i < end; ++i ) {
+                    m0 = std::max( m0, std::abs( dx[i] ) );
+                }
+
+                // Strictly greater only, so that the first maximum is kept as in the reference IDAMAX
+                double blockMax = std::max( std::max( m0, m1 ), std::max( m2, m3 ) );
+                if ( blockMax > max ) {
+                    for ( i = b; std::abs( dx[i] ) != blockMax; ++i ) {}
+                    idamax = i;
+                    max    = blockMax;
+                }
+            }
+            return idamax;
+        }
+
         for ( int i = 1, xi = incX; i < N; ++i, xi += incX ) {
-            double tmp = std::abs( dx[i] );
+            double tmp = std::abs( dx[xi] );
             if ( tmp > max ) {
                 idamax = i;
                 max    = tmp;
@@ -714,6 +2841,22 @@ namespace my_lapack {
                 dx[xi] = 0.0;
             }
         }
+        else if ( incX == 1 ) {
+            int i = 0;
+            for ( ; i + 8 <= N; i += 8 ) {
+                dx[i] *= da;
+                dx[i + 1] *= da;
+                dx[i + 2] *= da;
+                dx[i + 3] *= da;
+                dx[i + 4] *= da;
+                dx[i + 5] *= da;
+                dx[i + 6] *= da;
+                dx[i + 7] *= da;
+            }
+            for ( ; i < N; ++i ) {
+                dx[i] *= da;
+            }
+        }
         else {
             for ( int i = 0, xi = 0; i < N; ++i, xi += incX ) {
                 dx[xi] *= da;
@@ -721,19 +2864,186 @@ namespace my_lapack {
         }
     }
 
+    // Columns per strip of my_dlaswp, as in the reference DLASWP
+    static const int DLASWP_STRIP = 32;
+
     void my_dlaswp_seq( int N, double *A, int lda, int k1, int k2, int *ipv, int incX )
     {
         LAHPC_CHECK_POSITIVE( lda );
         LAHPC_CHECK_POSITIVE( N );
         LAHPC_CHECK_POSITIVE_STRICT( incX );
 
-        for ( int i = k1, xi = k1; i <= k2; ++i, xi += incX ) {
-            int pivot = ipv[xi];
-            if ( pivot != i ) {
-                for ( int j = 0; j < N; ++j ) {
-                    std::swap( A[j * lda + i], A[j * lda + pivot] );
+        // All the interchanges are applied to a strip of columns, which stays in cache, before moving to the next one
+        for ( int j0 = 0; j0 < N; j0 += DLASWP_STRIP ) {
+            int jEnd = std::min( N, j0 + DLASWP_STRIP );
+            for ( int i = k1, xi = k1; i <= k2; ++i, xi += incX ) {
+                int pivot = ipv[xi];
+                if ( pivot != i ) {
+                    for ( int j = j0; j < jEnd; ++j ) {
+                        std::swap( A[j * lda + i], A[j * lda + pivot] );
+                    }
+                }
+            }
+        }
+    }
+
+    void my_dlacpy_seq( int M, int N, const double *a, int lda, double *b, int ldb )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, M ) );
+
+        if ( M == 0 || N == 0 ) { return; }
+
+        // Columns are contiguous: one memcpy each, or a single one when neither matrix has leading dimension padding
+        if ( lda == M && ldb == M ) {
+            std::memcpy( b, a, sizeof( double ) * M * N );
+            return;
+        }
+        for ( int j = 0; j < N; ++j ) {
+            std::memcpy( b + AT( 0, j, ldb ), a + AT( 0, j, lda ), sizeof( double ) * M );
+        }
+    }
+
+    // Side of the square tiles of my_dlacpy_trans: the 32 destination columns written by a tile stay in cache while
+    // its source columns are read
+    static const int TRANSPOSE_TILE = 32;
+
+    void my_dlacpy_trans_seq( int M, int N, const double *a, int lda, double *b, int ldb )
+    {
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_PREDICATE( lda >= std::max( 1, M ) );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, N ) );
+
+        for ( int j0 = 0; j0 < N; j0 += TRANSPOSE_TILE ) {
+            int jEnd = std::min( N, j0 + TRANSPOSE_TILE );
+            for ( int i0 = 0; i0 < M; i0 += TRANSPOSE_TILE ) {
+                int iEnd = std::min( M, i0 + TRANSPOSE_TILE );
+                for ( int j = j0; j < jEnd; ++j ) {
+                    for ( int i = i0; i < iEnd; ++i ) {
+                        b[AT( j, i, ldb )] = a[AT( i, j, lda )];
+                    }
+                }
+            }
+        }
+    }
+
+    void my_dcsrmv_seq( CBLAS_TRANSPOSE trans,
+                        int             M,
+                        int             N,
+                        double          alpha,
+                        const int *     rowPtr,
+                        const int *     colInd,
+                        const double *  val,
+                        const double *  X,
+                        int             incX,
+                        double          beta,
+                        double *        Y,
+                        int             incY )
+    {
+        LAHPC_CHECK_PREDICATE( ( trans == CblasTrans ) || ( trans == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE_STRICT( incX );
+        LAHPC_CHECK_POSITIVE_STRICT( incY );
+
+        if ( trans == CblasNoTrans ) {
+            // One sparse dot product per row, each element of Y being written once with its scaling
+            for ( int i = 0; i < M; ++i ) {
+                double sum = 0.;
+                for ( int k = rowPtr[i]; k < rowPtr[i + 1]; ++k ) {
+                    sum += val[k] * X[colInd[k] * incX];
+                }
+                double *y = Y + i * incY;
+                *y        = ( beta == 0.0 ) ? alpha * sum : alpha * sum + beta * *y;
+            }
+            return;
+        }
+
+        // op( A ) = A^t: each row of A is scattered into Y
+        dgemv_scale( N, beta, Y, incY );
+        if ( alpha == 0.0 ) { return; }
+        for ( int i = 0; i < M; ++i ) {
+            double x = alpha * X[i * incX];
+            for ( int k = rowPtr[i]; k < rowPtr[i + 1]; ++k ) {
+                Y[colInd[k] * incY] += val[k] * x;
+            }
+        }
+    }
+
+    void my_dcsrmm_seq( CBLAS_TRANSPOSE transA,
+                        int             M,
+                        int             N,
+                        int             K,
+                        double          alpha,
+                        const int *     rowPtr,
+                        const int *     colInd,
+                        const double *  val,
+                        const double *  B,
+                        int             ldb,
+                        double          beta,
+                        double *        C,
+                        int             ldc )
+    {
+        LAHPC_CHECK_PREDICATE( ( transA == CblasTrans ) || ( transA == CblasNoTrans ) );
+        LAHPC_CHECK_POSITIVE( M );
+        LAHPC_CHECK_POSITIVE( N );
+        LAHPC_CHECK_POSITIVE( K );
+        LAHPC_CHECK_PREDICATE( ldb >= std::max( 1, K ) );
+        LAHPC_CHECK_PREDICATE( ldc >= std::max( 1, M ) );
+
+        for ( int j = 0; j < N; ++j ) {
+            dgemv_scale( M, beta, C + AT( 0, j, ldc ), 1 );
+        }
+        if ( alpha == 0.0 ) { return; }
+
+        // Four columns of B and C at a time share the loads of the indices and values of each row of A
+        int j = 0;
+        for ( ; j + 4 <= N; j += 4 ) {
+            const double *b0 = B + AT( 0, j, ldb );
+            const double *b1 = b0 + ldb;
+            const double *b2 = b1 + ldb;
+            const double *b3 = b2 + ldb;
+            double *      c0 = C + AT( 0, j, ldc );
+            double *      c1 = c0 + ldc;
+            double *      c2 = c1 + ldc;
+            double *      c3 = c2 + ldc;
+            if ( transA == CblasNoTrans ) {
+                for ( int i = 0; i < M; ++i ) {
+                    double t0 = 0., t1 = 0., t2 = 0., t3 = 0.;
+                    for ( int k = rowPtr[i]; k < rowPtr[i + 1]; ++k ) {
+                        int col = colInd[k];
+                        t0 += val[k] * b0[col];
+                        t1 += val[k] * b1[col];
+                        t2 += val[k] * b2[col];
+                        t3 += val[k] * b3[col];
+                    }
+                    c0[i] += alpha * t0;
+                    c1[i] += alpha * t1;
+                    c2[i] += alpha * t2;
+                    c3[i] += alpha * t3;
+                }
+            }
+            else {
+                for ( int r = 0; r < K; ++r ) {
+                    double x0 = alpha * b0[r], x1 = alpha * b1[r], x2 = alpha * b2[r], x3 = alpha * b3[r];
+                    for ( int k = rowPtr[r]; k < rowPtr[r + 1]; ++k ) {
+                        int col = colInd[k];
+                        c0[col] += val[k] * x0;
+                        c1[col] += val[k] * x1;
+                        c2[col] += val[k] * x2;
+                        c3[col] += val[k] * x3;
+                    }
                 }
             }
         }
+        for ( ; j < N; ++j ) {
+            int rows = ( transA == CblasNoTrans ) ? M : K;
+            int cols = ( transA == CblasNoTrans ) ? K : M;
+            my_dcsrmv_seq(
+                transA, rows, cols, alpha, rowPtr, colInd, val, B + AT( 0, j, ldb ), 1, 1., C + AT( 0, j, ldc ), 1 );
+        }
     }
 } // namespace my_lapack
@@ -0,0 +1,112 @@
+#include "Mat.h"
+#include "Summa.hpp"
+#include "cblas.h"
+#include "my_lapack.h"
+#include "util.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace my_lapack;
+
+/*============ UTILS FOR TESTING PURPOSE =============== */
+
+void print_test_result( int result, int *nb_success, int *nb_tests )
+{
+    if ( result == EXIT_SUCCESS ) {
+        printf( "\x1B[32mSUCCESS\x1B[0m\n" );
+        ( *nb_success )++;
+    }
+    else {
+        printf( "\x1B[31mFAILED\x1B[0m\n" );
+    }
+
+    ( *nb_tests )++;
+}
+
+void print_test_summary( int nb_success, int nb_tests )
+{
+    if ( nb_success == nb_tests )
+        printf( "TESTS SUMMARY: \t\x1B[32m%d\x1B[0m/%d\n", nb_success, nb_tests );
+    else
+        printf( "TESTS SUMMARY: \t\x1B[31m%d\x1B[0m/%d\n", nb_success, nb_tests );
+}
+
+/*============================================= */
+/*============ TESTS DEFINITION =============== */
+/*============================================= */
+
+/*============ TESTS DGETRF =============== */
+
+// Compare the distributed factors with the sequential ones, on a diagonally dominant matrix since neither pivots
+int test_dgetrf_mpi( int M, int N )
+{
+    Summa &SUMMA = Summa::getInstance();
+    SUMMA.reset( M, N, N );
+
+    Mat A = MatRandi( M, N, 10 );
+    for ( int i = 0; i < std::min( M, N ); ++i ) {
+        A.at( i, i ) += 10. * N;
+    }
+    Mat LU( A );
+
+    my_dgetrf_mpi( CblasColMajor, M, N, A.get(), A.dimX() );
+
+    if ( SUMMA.rankWorld() != 0 ) { return EXIT_SUCCESS; }
+
+    printf( "%s(%d, %d):\t", __func__, M, N );
+    my_dgetrf_seq( CblasColMajor, M, N, LU.get(), LU.dimX() );
+
+    return LU.equals( A, 1e-8 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Compare the pivoted distributed factors and pivots with the sequential ones, on a matrix that needs pivoting
+int test_dgetrf_piv_mpi( int M, int N )
+{
+    Summa &SUMMA = Summa::getInstance();
+    SUMMA.reset( M, N, N );
+
+    Mat A = MatRandi( M, N, 10 );
+    for ( int i = 0; i < std::min( M, N ); ++i ) {
+        A.at( i, i ) = 0.;
+    }
+    Mat LU( A );
+
+    std::vector<int> ipiv( std::min( M, N ) ), ipivSeq( std::min( M, N ) );
+    int info = my_dgetrf_piv_mpi( CblasColMajor, M, N, A.get(), A.dimX(), ipiv.data() );
+
+    if ( SUMMA.rankWorld() != 0 ) { return EXIT_SUCCESS; }
+
+    printf( "%s(%d, %d):\t", __func__, M, N );
+    int infoSeq = my_dgetrf_piv_seq( CblasColMajor, M, N, LU.get(), LU.dimX(), ipivSeq.data() );
+
+    return ( info == infoSeq && ipiv == ipivSeq && LU.equals( A, 1e-8 ) ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main( int argc, char **argv )
+{
+    Summa &SUMMA = Summa::getInstance();
+    SUMMA.init( &argc, &argv );
+    SUMMA.reset( 1, 1, 1 );
+
+    int rank = SUMMA.rankWorld();
+    if ( rank == 0 ) { printf( "----------- TEST MPI (%d processes) -----------\n", SUMMA.sizeWorld() ); }
+
+    int nb_success = 0;
+    int nb_tests   = 0;
+
+    int sizes[][2] = { { 1, 1 }, { 34, 34 }, { 100, 100 }, { 204, 204 }, { 150, 90 }, { 90, 150 } };
+    for ( auto &size : sizes ) {
+        int result = test_dgetrf_mpi( size[0], size[1] );
+        if ( rank == 0 ) { print_test_result( result, &nb_success, &nb_tests ); }
+        result = test_dgetrf_piv_mpi( size[0], size[1] );
+        if ( rank == 0 ) { print_test_result( result, &nb_success, &nb_tests ); }
+    }
+
+    if ( rank == 0 ) { print_test_summary( nb_success, nb_tests ); }
+
+    SUMMA.finalize();
+
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,6 @@
+#include "Krylov.h"
 #include "Mat.h"
+#include "RFPMat.h"
 #include "my_lapack.h"
 #include "algonum.h"
 #include "util.h"
@@ -6,6 +8,7 @@
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 //TODO: Calculer la perf théorique
 
@@ -106,6 +109,330 @@ int test_perf_dgemm(dgemm_fct_t dgemm_func,
     return EXIT_SUCCESS;
 }
 
+typedef void ( *dgeqrf_fct_t )( CBLAS_ORDER order, int M, int N, double *A, int lda, double *tau );
+
+// Tall and skinny least squares shapes are the main target, so M = 2 * N
+int test_perf_dgeqrf( dgeqrf_fct_t dgeqrf_func, const char *curve_title )
+{
+    printf( "%s, curve \"%s\"\n", __func__, curve_title );
+
+    for ( int len = 128; len <= 1024; len *= 2 ) {
+        Mat            A = MatRandi( 2 * len, len, 10 );
+        vector<double> tau( len );
+
+        auto t0 = chrono::system_clock::now();
+        dgeqrf_func( CblasColMajor, A.dimX(), A.dimY(), A.get(), A.ld(), tau.data() );
+        auto t1 = chrono::system_clock::now();
+        chrono::duration<double> diff = t1 - t0;
+
+        double Gflops = flops_dgeqrf( 2 * len, len ) / diff.count() / 1e9;
+        cout << "M: " << 2 * len << "\tN: " << len << "\tTime: " << diff.count() << "\tGFlop/s: " << Gflops << endl;
+    }
+
+    cout << "Done.\n";
+    return EXIT_SUCCESS;
+}
+
+// Throughput of many small independent factorizations, compared to one my_dgetrf_piv_openmp call per matrix
+int test_perf_dgetrf_batch( int n, int batch )
+{
+    printf( "%s, N = %d, batch of %d\n", __func__, n, batch );
+
+    vector<double>   storage( static_cast<size_t>( batch ) * n * n );
+    vector<double *> A( batch );
+    vector<int>      ipivs( static_cast<size_t>( batch ) * n ), info( batch );
+    vector<int *>    ipiv( batch );
+    for ( int b = 0; b < batch; ++b ) {
+        A[b]    = storage.data() + static_cast<size_t>( b ) * n * n;
+        ipiv[b] = ipivs.data() + static_cast<size_t>( b ) * n;
+    }
+
+    const char *titles[] = { "Batch sequential", "Batch OpenMP", "Loop of my_dgetrf_piv_openmp" };
+    for ( int version = 0; version < 3; ++version ) {
+        Mat M = MatRandi( n * n, batch, 100 );
+        std::copy( M.get(), M.get() + storage.size(), storage.begin() );
+
+        auto t0 = chrono::system_clock::now();
+        if ( version == 0 ) { my_dgetrf_batch_seq( CblasColMajor, n, A.data(), n, ipiv.data(), info.data(), batch ); }
+        else if ( version == 1 ) {
+            my_dgetrf_batch_openmp( CblasColMajor, n, A.data(), n, ipiv.data(), info.data(), batch );
+        }
+        else {
+            for ( int b = 0; b < batch; ++b ) {
+                info[b] = my_dgetrf_piv_openmp( CblasColMajor, n, n, A[b], n, ipiv[b] );
+            }
+        }
+        auto t1 = chrono::system_clock::now();
+        chrono::duration<double> diff = t1 - t0;
+
+        cout << titles[version] << "\tTime: " << diff.count() << "\tMatrices/s: " << batch / diff.count() << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+typedef void ( *dgemv_fct_t )( CBLAS_ORDER     layout,
+                               CBLAS_TRANSPOSE TransA,
+                               int             M,
+                               int             N,
+                               double          alpha,
+                               const double *  A,
+                               int             lda,
+                               const double *  X,
+                               int             incX,
+                               double          beta,
+                               double *        Y,
+                               const int       incY );
+
+// STREAM triad a = b + s * c on arrays far larger than the caches, in GB/s counting 24 bytes per element as STREAM
+double stream_triad_bandwidth()
+{
+    const long     n = 1L << 23;
+    vector<double> a( n ), b( n, 1. ), c( n, 2. );
+
+    double best = 0.;
+    for ( int r = 0; r < 5; ++r ) {
+        auto t0 = chrono::system_clock::now();
+#pragma omp parallel for
+        for ( long i = 0; i < n; ++i ) {
+            a[i] = b[i] + 3. * c[i];
+        }
+        chrono::duration<double> diff = chrono::system_clock::now() - t0;
+        best                          = std::max( best, 24. * n / diff.count() / 1e9 );
+    }
+    return best;
+}
+
+// DGEMV is bound by the reading of A, so it is measured in GB/s of A, X and Y traffic, best of 5 runs
+int test_perf_dgemv( dgemv_fct_t dgemv_func, const char *curve_title, double streamBandwidth )
+{
+    printf( "%s, curve \"%s\", STREAM triad: %.2f GB/s\n", __func__, curve_title, streamBandwidth );
+
+    for ( int len = 1024; len <= 8192; len *= 2 ) {
+        Mat            A = MatRandi( len, len, 10 );
+        vector<double> x( len, 1. ), y( len, 0. );
+
+        CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+        for ( CBLAS_TRANSPOSE trans : transs ) {
+            double best = 1e30;
+            for ( int r = 0; r < 5; ++r ) {
+                auto t0 = chrono::system_clock::now();
+                dgemv_func( CblasColMajor, trans, len, len, 1., A.get(), A.ld(), x.data(), 1, 1., y.data(), 1 );
+                chrono::duration<double> diff = chrono::system_clock::now() - t0;
+                best                          = std::min( best, diff.count() );
+            }
+
+            double GBs = 8. * ( (double)len * len + 3. * len ) / best / 1e9;
+            cout << ( trans == CblasNoTrans ? "NoTrans" : "Trans" ) << "\tN: " << len << "\tTime: " << best
+                 << "\tGB/s: " << GBs << "\t(" << 100. * GBs / streamBandwidth << "% of STREAM)" << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// One my_dgemv2_openmp sweep against the two my_dgemv_openmp sweeps it replaces, in GB/s of A traffic only
+int test_perf_dgemv2( double streamBandwidth )
+{
+    printf( "%s, STREAM triad: %.2f GB/s\n", __func__, streamBandwidth );
+
+    for ( int len = 1024; len <= 8192; len *= 2 ) {
+        Mat            A = MatRandi( len, len, 10 );
+        vector<double> x( len, 1. ), y( len, 1. ), w( len, 0. ), z( len, 0. );
+
+        double best[2] = { 1e30, 1e30 };
+        for ( int r = 0; r < 5; ++r ) {
+            auto t0 = chrono::system_clock::now();
+            my_dgemv_openmp( CblasColMajor, CblasNoTrans, len, len, 1., A.get(), A.ld(), x.data(), 1, 0., w.data(), 1 );
+            my_dgemv_openmp( CblasColMajor, CblasTrans, len, len, 1., A.get(), A.ld(), y.data(), 1, 0., z.data(), 1 );
+            auto t1 = chrono::system_clock::now();
+            my_dgemv2_openmp(
+                CblasColMajor, len, len, 1., A.get(), A.ld(), x.data(), 1, y.data(), 1, 0., w.data(), 1, z.data(), 1 );
+            auto t2 = chrono::system_clock::now();
+            best[0] = std::min( best[0], chrono::duration<double>( t1 - t0 ).count() );
+            best[1] = std::min( best[1], chrono::duration<double>( t2 - t1 ).count() );
+        }
+
+        double bytes = 8. * len * len;
+        cout << "N: " << len << "\tTwo dgemv: " << best[0] << " s\tdgemv2: " << best[1] << " s\t("
+             << bytes / best[1] / 1e9 << " GB/s, " << 100. * bytes / best[1] / 1e9 / streamBandwidth
+             << "% of STREAM)" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Five point finite differences of -laplacian + c * d/dx on an s x s grid, symmetric when c is 0
+static SparseMat convection_diffusion( int s, double c )
+{
+    vector<int>    rows, cols;
+    vector<double> values;
+    for ( int j = 0; j < s; ++j ) {
+        for ( int i = 0; i < s; ++i ) {
+            // West, east, south and north neighbours, -1 outside of the grid
+            int    k         = j * s + i;
+            int    nb[]      = { i > 0 ? k - 1 : -1,
+                                 i < s - 1 ? k + 1 : -1,
+                                 j > 0 ? k - s : -1,
+                                 j < s - 1 ? k + s : -1 };
+            double weights[] = { -1. - c, -1. + c, -1., -1. };
+            rows.push_back( k );
+            cols.push_back( k );
+            values.push_back( 4. );
+            for ( int e = 0; e < 4; ++e ) {
+                if ( nb[e] < 0 ) { continue; }
+                rows.push_back( k );
+                cols.push_back( nb[e] );
+                values.push_back( weights[e] );
+            }
+        }
+    }
+    return SparseMat( s * s, s * s, (int)values.size(), rows.data(), cols.data(), values.data() );
+}
+
+// CG on the Poisson problem and GMRES on a convection-diffusion one, against my_dgetrf_piv + my_dgetrs on the
+// dense matrix. The iterative solvers stop at the relative residual the direct solve reaches.
+int test_perf_krylov( int s )
+{
+    int n = s * s;
+    printf( "%s, %d x %d grid, N = %d\n", __func__, s, s, n );
+
+    for ( int symmetric = 1; symmetric >= 0; --symmetric ) {
+        SparseMat      A  = convection_diffusion( s, symmetric ? 0. : 0.4 );
+        LinearOperator op = sparseOperator( A );
+        Mat            b  = MatRandi( n, 1, 100, 3 );
+        vector<double> w( n );
+        double         bnorm = std::sqrt( my_ddot( n, b.get(), 1, b.get(), 1 ) );
+
+        Mat         LU = A.toDense(), x( b );
+        vector<int> ipiv( n );
+        auto        t0 = chrono::system_clock::now();
+        my_dgetrf_piv( CblasColMajor, n, n, LU.get(), LU.ld(), ipiv.data() );
+        my_dgetrs( CblasColMajor, n, 1, LU.get(), LU.ld(), ipiv.data(), x.get(), x.ld() );
+        chrono::duration<double> direct = chrono::system_clock::now() - t0;
+        op( x.get(), w.data() );
+        my_daxpby( n, 1., b.get(), 1, -1., w.data(), 1 );
+        double tol = std::sqrt( my_ddot( n, w.data(), 1, w.data(), 1 ) ) / bnorm;
+        cout << ( symmetric ? "Poisson" : "Convection-diffusion" ) << "\tDirect\tTime: " << direct.count()
+             << "\tResidual: " << tol << endl;
+
+        for ( int precond = 0; precond < 2; ++precond ) {
+            x       = MatZero( n, 1 );
+            auto t1 = chrono::system_clock::now();
+            BlockJacobi *M =
+                precond ? new BlockJacobi( A, s, symmetric ? BlockJacobi::Cholesky : BlockJacobi::LU ) : nullptr;
+            KrylovResult r = symmetric ? conjugateGradient( n, op, b.get(), x.get(), M, tol, 10 * n )
+                                       : gmres( n, op, b.get(), x.get(), M, tol, 10 * n, 30 );
+            chrono::duration<double> diff = chrono::system_clock::now() - t1;
+            delete M;
+
+            cout << ( symmetric ? "\tCG" : "\tGMRES(30)" ) << ( precond ? " + block-Jacobi" : "" )
+                 << "\tTime: " << diff.count() << "\tIterations: " << r.iterations << "\tResidual: " << r.residual
+                 << "\tSpeedup: " << direct.count() / diff.count() << ( r.converged ? "" : "\t(not converged)" )
+                 << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Block-triangular and block-banded products, where my_dgemm_masked_openmp skips the zero tile products that
+// my_dgemm_openmp computes. The tile masks are computed by the call and included in its time.
+int test_perf_dgemm_masked( int n )
+{
+    printf( "%s, N = %d\n", __func__, n );
+
+    Mat L = MatRandLi( n ), U = MatRandUi( n ), Band = MatRandi( n, n, 10 ), C = MatZero( n, n );
+    for ( int j = 0; j < n; ++j ) {
+        for ( int i = 0; i < n; ++i ) {
+            if ( std::abs( i / _LAHPC_BLOCK_SIZE - j / _LAHPC_BLOCK_SIZE ) > 2 ) { Band.at( i, j ) = 0.; }
+        }
+    }
+
+    const char *titles[] = { "L * U", "U * L", "Band * Band" };
+    Mat *       As[]     = { &L, &U, &Band };
+    Mat *       Bs[]     = { &U, &L, &Band };
+    for ( int p = 0; p < 3; ++p ) {
+        const double *A = As[p]->get(), *B = Bs[p]->get();
+
+        auto t0 = chrono::system_clock::now();
+        my_dgemm_openmp( CblasColMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1., A, n, B, n, 0., C.get(), n );
+        auto t1 = chrono::system_clock::now();
+        my_dgemm_masked_openmp(
+            CblasColMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1., A, n, nullptr, B, n, nullptr, 0., C.get(), n );
+        auto t2 = chrono::system_clock::now();
+
+        chrono::duration<double> dense = t1 - t0, masked = t2 - t1;
+        cout << titles[p] << "\tmy_dgemm: " << dense.count() << " s\tmy_dgemm_masked: " << masked.count()
+             << " s\tSpeedup: " << dense.count() / masked.count() << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Banded LU against the dense one on the same matrix, then the sequential and parallel banded LU on wider bands
+int test_perf_dgbtrf( int n )
+{
+    printf( "%s, N = %d\n", __func__, n );
+
+    const int bands[] = { 16, 50, 200 };
+    for ( int b : bands ) {
+        int kv = 2 * b, ldab = 3 * b + 1;
+
+        Mat            A = MatRandi( n, n, 10 );
+        vector<double> AB( static_cast<size_t>( ldab ) * n, 0. );
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < n; ++i ) {
+                if ( std::abs( i - j ) > b ) { A.at( i, j ) = 0.; }
+                else {
+                    AB[kv + i - j + static_cast<size_t>( j ) * ldab] = A.at( i, j );
+                }
+            }
+        }
+        vector<double> AB2( AB );
+        vector<int>    ipiv( n );
+
+        auto t0 = chrono::system_clock::now();
+        my_dgetrf_piv_openmp( CblasColMajor, n, n, A.get(), A.ld(), ipiv.data() );
+        auto t1 = chrono::system_clock::now();
+        my_dgbtrf_seq( CblasColMajor, n, b, b, AB.data(), ldab, ipiv.data() );
+        auto t2 = chrono::system_clock::now();
+        my_dgbtrf_openmp( CblasColMajor, n, b, b, AB2.data(), ldab, ipiv.data() );
+        auto t3 = chrono::system_clock::now();
+
+        chrono::duration<double> dense = t1 - t0, seq = t2 - t1, omp = t3 - t2;
+        cout << "KL = KU = " << b << "\tDense OpenMP: " << dense.count() << " s\tBanded Sequential: " << seq.count()
+             << " s\tBanded OpenMP: " << omp.count() << " s" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Cholesky factorization in RFP storage against the dense one, which holds twice as many doubles
+int test_perf_dpftrf( int n )
+{
+    printf( "%s, N = %d\n", __func__, n );
+
+    Mat R = MatRandi( n, n, 10 );
+    Mat A = MatSqrDiag( n, n );
+    my_dsyrk_openmp( CblasColMajor, CblasLower, CblasNoTrans, n, n, 1., R.get(), R.ld(), 1., A.get(), A.ld() );
+    RFPMat P = RFPMat::fromDense( n, A.get(), A.ld(), CblasLower );
+
+    auto t0 = chrono::system_clock::now();
+    my_dpotrf_openmp( CblasColMajor, n, A.get(), A.ld() );
+    auto t1 = chrono::system_clock::now();
+    my_dpftrf_openmp( CblasColMajor, CblasLower, n, P.data() );
+    auto t2 = chrono::system_clock::now();
+
+    chrono::duration<double> dense = t1 - t0, packed = t2 - t1;
+    double                   flops = flops_dpotrf( n );
+    cout << "my_dpotrf: " << dense.count() << " s, " << flops / dense.count() / 1e9 << " GFlop/s, "
+         << 8. * n * n / 1e6 << " MB\tmy_dpftrf: " << packed.count() << " s, " << flops / packed.count() / 1e9
+         << " GFlop/s, " << 8. * n * ( n + 1 ) / 2 / 1e6 << " MB" << endl;
+
+    return EXIT_SUCCESS;
+}
+
 /*============ MAIN CALL =============== */
 
 /* 
@@ -137,6 +464,27 @@ int main( int argc, char **argv )
     test_perf_dgemm(my_dgemm_scal_openmp, argv[1], argv[2], "OpenMP Scalar", true);
     test_perf_dgemm(my_dgemm_seq, argv[1], argv[2], "Sequential", true);
     test_perf_dgemm(my_dgemm_openmp, argv[1], argv[2], "OpenMP", true);
+
+    double streamBandwidth = stream_triad_bandwidth();
+    test_perf_dgemv( my_dgemv_seq, "Sequential", streamBandwidth );
+    test_perf_dgemv( my_dgemv_openmp, "OpenMP", streamBandwidth );
+    test_perf_dgemv2( streamBandwidth );
+
+    test_perf_dgeqrf( my_dgeqrf_seq, "Sequential" );
+    test_perf_dgeqrf( my_dgeqrf_openmp, "OpenMP" );
+
+    int batchSizes[] = { 8, 16, 32, 64 };
+    for ( int n : batchSizes ) {
+        test_perf_dgetrf_batch( n, 100000 / ( n / 8 ) );
+    }
+
+    test_perf_dgemm_masked( 2048 );
+
+    test_perf_dgbtrf( 2000 );
+
+    test_perf_dpftrf( 2000 );
+
+    test_perf_krylov( 48 );
     
     return EXIT_SUCCESS;
 }
@@ -1,10 +1,20 @@
 //#include "algonum.h"
+#include "Krylov.h"
+#include "LUFactorization.h"
 #include "Mat.h"
+#include "RFPMat.h"
+#include "SparseMat.h"
 #include "cblas.h"
 #include "my_lapack.h"
 #include "util.h"
 
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 using namespace my_lapack;
@@ -32,6 +42,46 @@ void print_test_summary( int nb_success, int nb_tests )
         printf( "TESTS SUMMARY: \t\x1B[31m%d\x1B[0m/%d\n", nb_success, nb_tests );
 }
 
+// Multiples of 1/8 between -6 and 6, so that sums of their products are exact whatever the order of the additions
+static vector<double> test_vector( int n, int seed )
+{
+    vector<double> v( n );
+    for ( int i = 0; i < n; ++i ) {
+        v[i] = ( ( i * 37 + seed * 11 ) % 97 - 48 ) / 8.;
+    }
+    return v;
+}
+
+// max | A * X - B | / ( max | A | * max | X | * N )
+double solve_residual( Mat &A, Mat &X, Mat &B )
+{
+    Mat R( B );
+    my_dgemm_seq( CblasColMajor,
+                  CblasNoTrans,
+                  CblasNoTrans,
+                  A.dimX(),
+                  X.dimY(),
+                  A.dimY(),
+                  1.0,
+                  A.get(),
+                  A.ld(),
+                  X.get(),
+                  X.ld(),
+                  -1.0,
+                  R.get(),
+                  R.ld() );
+
+    double Rnorm = 0., Anorm = 0., Xnorm = 0.;
+    for ( int i = 0; i < R.dimX() * R.dimY(); ++i ) {
+        Rnorm = std::max( Rnorm, std::abs( R.at( i ) ) );
+        Xnorm = std::max( Xnorm, std::abs( X.at( i ) ) );
+    }
+    for ( int i = 0; i < A.dimX() * A.dimY(); ++i ) {
+        Anorm = std::max( Anorm, std::abs( A.at( i ) ) );
+    }
+    return Rnorm / ( Anorm * Xnorm * A.dimX() );
+}
+
 /*============================================= */
 /*============ TESTS DEFINITION =============== */
 /*============================================= */
@@ -79,18 +129,16 @@ int test_dgemm_square()
     return EXIT_SUCCESS;
 }
 
-// FIXME: This test is bugged.
+// M and K are multiples of the block size, so the last blocks along them are full, N is not
 int test_dgemm_rectangle()
 {
     printf( "%s:\t", __func__ );
 
-    size_t M = 200;
+    size_t M = 6 * _LAHPC_BLOCK_SIZE;
     size_t N = 100;
-    size_t K = 260;
+    size_t K = 7 * _LAHPC_BLOCK_SIZE;
     double alpha, beta, val;
-    Mat    A = Mat( M, K );
-    Mat    B = Mat( K, N );
-    Mat    C = Mat( M, N );
+    Mat    A, B, C;
 
     // Main loop, testing for all possible transpose cases
     int AdimX, AdimY, BdimX, BdimY;
@@ -103,21 +151,15 @@ int test_dgemm_rectangle()
             AdimY = transA ? M : K;
             BdimX = transB ? N : K;
             BdimY = transB ? K : N;
-            // A.reshape(AdimX, AdimY, val);
-            // B.reshape(BdimX, BdimY, val);
-            C.fill( val );
-            if ( ( ( transA ? AdimX : AdimY ) != (int)K ) || ( ( transB ? BdimY : BdimX ) != (int)K ) ) {
-                printf( "ERROR: Invalid dims %d and %d doesn't match.\t",
-                        ( transA ? AdimX : AdimY ),
-                        ( transB ? BdimY : BdimX ) );
-                return EXIT_FAILURE;
-            }
+            A     = Mat( AdimX, AdimY, val );
+            B     = Mat( BdimX, BdimY, val );
+            C     = Mat( M, N, val );
             my_dgemm( CblasColMajor,
                       transA ? CblasTrans : CblasNoTrans,
                       transB ? CblasTrans : CblasNoTrans,
-                      AdimX,
-                      BdimY,
-                      AdimY,
+                      M,
+                      N,
+                      K,
                       alpha,
                       A.get(),
                       AdimX,
@@ -126,8 +168,8 @@ int test_dgemm_rectangle()
                       beta,
                       C.get(),
                       C.dimX() );
-            if ( !C.containsOnly( AdimY * val * val * alpha + val * beta ) ) {
-                printf( "ERROR: Expected %f, got %f.\t", AdimY * val * val * alpha + val * beta, C.at( 0 ) );
+            if ( !C.containsOnly( K * val * val * alpha + val * beta ) ) {
+                printf( "ERROR: Expected %f, got %f.\t", K * val * val * alpha + val * beta, C.at( 0 ) );
                 return EXIT_FAILURE;
             }
         }
@@ -136,10 +178,331 @@ int test_dgemm_rectangle()
     return EXIT_SUCCESS;
 }
 
+// Every N of the skinny kernel, and 17 which is past it
+int test_dgemm_skinny()
+{
+    printf( "%s:\t", __func__ );
+
+    const int sizes[][2] = { { 33, 21 }, { 300, 150 } };
+    for ( const int *size : sizes ) {
+        int m = size[0], k = size[1];
+        for ( int n = 1; n <= 17; ++n ) {
+            for ( CBLAS_TRANSPOSE transA : { CblasNoTrans, CblasTrans } ) {
+                for ( CBLAS_TRANSPOSE transB : { CblasNoTrans, CblasTrans } ) {
+                    bool ta = ( transA == CblasTrans ), tb = ( transB == CblasTrans );
+                    int  lda = ( ta ? k : m ) + 1, ldb = ( tb ? n : k ) + 2, ldc = m + 3;
+                    vector<double> A = test_vector( lda * ( ta ? m : k ), 16 );
+                    vector<double> B = test_vector( ldb * ( tb ? k : n ), 17 );
+                    vector<double> C = test_vector( ldc * n, 18 ), D( C );
+
+                    my_dgemm( CblasColMajor, transA, transB, m, n, k, 0.5, A.data(), lda, B.data(), ldb, -2., C.data(),
+                              ldc );
+                    for ( int j = 0; j < n; ++j ) {
+                        for ( int i = 0; i < m; ++i ) {
+                            double sum = 0.;
+                            for ( int l = 0; l < k; ++l ) {
+                                double a = ta ? A[i * lda + l] : A[l * lda + i];
+                                sum += a * ( tb ? B[l * ldb + j] : B[j * ldb + l] );
+                            }
+                            D[j * ldc + i] = 0.5 * sum - 2. * D[j * ldc + i];
+                        }
+                    }
+                    if ( C != D ) { return EXIT_FAILURE; }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
 int test_dgemm_submatrix();
 
 int test_dgemm_error_cases();
 
+/*============ TESTS LEVEL 1 =============== */
+
+// The threads split contiguous vectors on cache lines only, strided ones are cut anywhere
+int test_level1()
+{
+    printf( "%s:\t", __func__ );
+
+    const int incs[][2] = { { 1, 1 }, { 3, 2 }, { 1, 4 } };
+    for ( int n : { 1000, 100003 } ) {
+        for ( const int *inc : incs ) {
+            int            incX = inc[0], incY = inc[1];
+            vector<double> X = test_vector( n * incX, 1 ), Y = test_vector( n * incY, 2 ), Z( Y );
+
+            double dot = 0.;
+            for ( int i = 0; i < n; ++i ) {
+                dot += X[i * incX] * Y[i * incY];
+            }
+            if ( my_ddot( n, X.data(), incX, Y.data(), incY ) != dot ) { return EXIT_FAILURE; }
+
+            my_daxpy( n, -0.5, X.data(), incX, Y.data(), incY );
+            for ( int i = 0; i < n; ++i ) {
+                Z[i * incY] += -0.5 * X[i * incX];
+            }
+            if ( Y != Z ) { return EXIT_FAILURE; }
+
+            for ( double da : { -2., 0. } ) {
+                my_dscal( n, da, Y.data(), incY );
+                for ( int i = 0; i < n * incY; i += incY ) {
+                    Z[i] *= da;
+                }
+                if ( Y != Z ) { return EXIT_FAILURE; }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Each fused kernel must give exactly what the unfused calls it replaces give
+int test_fused_level1()
+{
+    printf( "%s:\t", __func__ );
+
+    const int incs[][2] = { { 1, 1 }, { 3, 2 } };
+    for ( int n : { 1000, 100003 } ) {
+        for ( const int *inc : incs ) {
+            int            incX = inc[0], incY = inc[1];
+            vector<double> X = test_vector( n * incX, 20 ), Y = test_vector( n * incY, 21 ), Z( Y );
+
+            my_daxpby( n, 0.5, X.data(), incX, -2., Y.data(), incY );
+            my_dscal( n, -2., Z.data(), incY );
+            my_daxpy( n, 0.5, X.data(), incX, Z.data(), incY );
+            if ( Y != Z ) { return EXIT_FAILURE; }
+
+            // Against another vector, of the stride of X, then against Y itself
+            vector<double> W = test_vector( n * incX, 22 );
+            double         dot = my_daxpy_dot( n, -0.5, X.data(), incX, Y.data(), incY, W.data(), incX );
+            my_daxpy( n, -0.5, X.data(), incX, Z.data(), incY );
+            if ( Y != Z || dot != my_ddot( n, Z.data(), incY, W.data(), incX ) ) { return EXIT_FAILURE; }
+            dot = my_daxpy_dot( n, 0.5, X.data(), incX, Y.data(), incY, Y.data(), incY );
+            my_daxpy( n, 0.5, X.data(), incX, Z.data(), incY );
+            if ( Y != Z || dot != my_ddot( n, Z.data(), incY, Z.data(), incY ) ) { return EXIT_FAILURE; }
+
+            double xy, xx;
+            my_ddot2( n, X.data(), incX, Y.data(), incY, &xy, &xx );
+            if ( xy != my_ddot( n, X.data(), incX, Y.data(), incY ) ) { return EXIT_FAILURE; }
+            if ( xx != my_ddot( n, X.data(), incX, X.data(), incX ) ) { return EXIT_FAILURE; }
+        }
+    }
+
+    const int sizes[][2] = { { 37, 29 }, { 700, 300 } };
+    for ( const int *size : sizes ) {
+        int            m = size[0], n = size[1], lda = m + 5;
+        vector<double> A = test_vector( lda * n, 23 );
+        for ( const int *inc : incs ) {
+            int incX = inc[0], incY = inc[1];
+            for ( CBLAS_TRANSPOSE trans : { CblasNoTrans, CblasTrans } ) {
+                int            lenX = ( trans == CblasNoTrans ) ? n : m, lenY = ( trans == CblasNoTrans ) ? m : n;
+                vector<double> X = test_vector( lenX * incX, 24 ), Y = test_vector( lenY * incY, 25 ), Z( Y );
+
+                double nrm2 = my_dgemv_norm(
+                    CblasColMajor, trans, m, n, 0.5, A.data(), lda, X.data(), incX, -2., Y.data(), incY );
+                my_dgemv( CblasColMajor, trans, m, n, 0.5, A.data(), lda, X.data(), incX, -2., Z.data(), incY );
+                if ( Y != Z || nrm2 != my_ddot( lenY, Z.data(), incY, Z.data(), incY ) ) { return EXIT_FAILURE; }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#ifdef _OPENMP
+// Equal maxima in several chunks of the threads, or across their cuts: the first one must win
+int test_idamax_openmp()
+{
+    printf( "%s:\t", __func__ );
+
+    int maxThreads = omp_get_max_threads();
+    int result     = EXIT_SUCCESS;
+
+    const int n = 100003;
+    for ( int nt : { 1, 2, 3, 4, 7 } ) {
+        omp_set_num_threads( nt );
+        for ( int incX : { 1, 3 } ) {
+            for ( int first : { 0, 1, 2 } ) {
+                if ( nt == 1 && first > 0 ) { continue; }
+                vector<double> X = test_vector( n * incX, 19 );
+                int            expected;
+                if ( first < 2 ) {
+                    // One maximum in the middle of each chunk from the chunk first on, of alternating signs
+                    expected = static_cast<int>( static_cast<long>( n ) * ( 2 * first + 1 ) / ( 2 * nt ) );
+                    for ( int t = first; t < nt; ++t ) {
+                        int i       = static_cast<int>( static_cast<long>( n ) * ( 2 * t + 1 ) / ( 2 * nt ) );
+                        X[i * incX] = ( t % 2 ) ? -10. : 10.;
+                    }
+                }
+                else {
+                    // Runs of maxima across the first and the last cuts, whichever cache line they are moved to
+                    int c0 = n / nt, c1 = static_cast<int>( static_cast<long>( n ) * ( nt - 1 ) / nt );
+                    for ( int c : { c0, c1 } ) {
+                        for ( int i = c - 12; i < c + 12; ++i ) {
+                            X[i * incX] = ( i % 2 ) ? -10. : 10.;
+                        }
+                    }
+                    expected = c0 - 12;
+                }
+                if ( my_idamax_openmp( n, X.data(), incX ) != expected ) { result = EXIT_FAILURE; }
+            }
+        }
+    }
+
+    omp_set_num_threads( maxThreads );
+    return result;
+}
+#endif
+
+/*============ TESTS DGEMV =============== */
+
+// y = alpha * op( A ) * x + beta * y by a plain loop, for the M x N column-major matrix A
+static void naive_dgemv( CBLAS_TRANSPOSE trans, int M, int N, double alpha, const double *A, int lda,
+                         const double *X, int incX, double beta, double *Y, int incY )
+{
+    int lenY = ( trans == CblasNoTrans ) ? M : N, lenX = ( trans == CblasNoTrans ) ? N : M;
+    for ( int i = 0; i < lenY; ++i ) {
+        double sum = 0.;
+        for ( int k = 0; k < lenX; ++k ) {
+            sum += ( ( trans == CblasNoTrans ) ? A[k * lda + i] : A[i * lda + k] ) * X[k * incX];
+        }
+        Y[i * incY] = alpha * sum + beta * Y[i * incY];
+    }
+}
+
+// Both outputs of dgemv2 are checked on their own. Negative strides are not supported and must be rejected.
+int test_dgemv()
+{
+    printf( "%s:\t", __func__ );
+
+    const int sizes[][2] = { { 37, 29 }, { 700, 300 } }, incs[][2] = { { 1, 1 }, { 2, 3 } };
+    for ( const int *size : sizes ) {
+        int            m = size[0], n = size[1], lda = m + 5;
+        vector<double> A = test_vector( lda * n, 3 );
+        for ( const int *inc : incs ) {
+            int incX = inc[0], incY = inc[1];
+            for ( CBLAS_TRANSPOSE trans : { CblasNoTrans, CblasTrans } ) {
+                int            lenX = ( trans == CblasNoTrans ) ? n : m, lenY = ( trans == CblasNoTrans ) ? m : n;
+                vector<double> X = test_vector( lenX * incX, 4 ), Y = test_vector( lenY * incY, 5 ), Z( Y );
+
+                my_dgemv( CblasColMajor, trans, m, n, 0.5, A.data(), lda, X.data(), incX, -2., Y.data(), incY );
+                naive_dgemv( trans, m, n, 0.5, A.data(), lda, X.data(), incX, -2., Z.data(), incY );
+                if ( Y != Z ) { return EXIT_FAILURE; }
+            }
+
+            // W = alpha * A * X + beta * W and Z = alpha * A^t * Y + beta * Z, the strides of X and W being incX and
+            // those of Y and Z incY
+            vector<double> X = test_vector( n * incX, 6 ), Y = test_vector( m * incY, 7 );
+            vector<double> W = test_vector( m * incX, 8 ), Z = test_vector( n * incY, 9 ), W2( W ), Z2( Z );
+            my_dgemv2( CblasColMajor, m, n, 0.5, A.data(), lda, X.data(), incX, Y.data(), incY, -2., W.data(), incX,
+                       Z.data(), incY );
+            naive_dgemv( CblasNoTrans, m, n, 0.5, A.data(), lda, X.data(), incX, -2., W2.data(), incX );
+            naive_dgemv( CblasTrans, m, n, 0.5, A.data(), lda, Y.data(), incY, -2., Z2.data(), incY );
+            if ( W != W2 || Z != Z2 ) { return EXIT_FAILURE; }
+        }
+    }
+
+    vector<double> A( 4 ), X( 2 ), Y( 2 );
+    try {
+        my_dgemv( CblasColMajor, CblasNoTrans, 2, 2, 1., A.data(), 2, X.data(), -1, 0., Y.data(), 1 );
+        return EXIT_FAILURE;
+    }
+    catch ( const std::domain_error & ) {
+    }
+    try {
+        my_dgemv2( CblasColMajor, 2, 2, 1., A.data(), 2, X.data(), 1, Y.data(), 1, 0., Y.data(), 1, X.data(), -1 );
+        return EXIT_FAILURE;
+    }
+    catch ( const std::domain_error & ) {
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS DGER =============== */
+
+// With fewer columns than threads, the rows are split instead of the columns
+int test_dger()
+{
+    printf( "%s:\t", __func__ );
+
+    const int sizes[][2] = { { 37, 29 }, { 700, 300 }, { 40000, 2 } }, incs[][2] = { { 1, 1 }, { 3, 2 } };
+    for ( const int *size : sizes ) {
+        int m = size[0], n = size[1], lda = m + 3;
+        for ( const int *inc : incs ) {
+            int            incX = inc[0], incY = inc[1];
+            vector<double> X = test_vector( m * incX, 10 ), Y = test_vector( n * incY, 11 );
+            vector<double> A = test_vector( lda * n, 12 ), B( A );
+
+            my_dger( CblasColMajor, m, n, 0.5, X.data(), incX, Y.data(), incY, A.data(), lda );
+            for ( int j = 0; j < n; ++j ) {
+                for ( int i = 0; i < m; ++i ) {
+                    B[j * lda + i] += 0.5 * X[i * incX] * Y[j * incY];
+                }
+            }
+            if ( A != B ) { return EXIT_FAILURE; }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS DLASWP / DLACPY =============== */
+
+// More columns than two strips, and rows exchanged several times
+int test_dlaswp()
+{
+    printf( "%s:\t", __func__ );
+
+    const int m = 300, lda = m + 3, k1 = 2, k2 = 251;
+    for ( int n : { 70, 150 } ) {
+        for ( int incX : { 1, 2 } ) {
+            // Pivots among the last five rows, so that each of them is exchanged about fifty times, a few rows
+            // staying in place
+            vector<int> ipv( k1 + ( k2 - k1 + 1 ) * incX );
+            for ( int i = k1; i <= k2; ++i ) {
+                ipv[k1 + ( i - k1 ) * incX] = ( i % 7 == 0 ) ? i : m - 1 - i % 5;
+            }
+            vector<double> A = test_vector( lda * n, 13 ), B( A );
+
+            my_dlaswp( n, A.data(), lda, k1, k2, ipv.data(), incX );
+            for ( int i = k1; i <= k2; ++i ) {
+                int pivot = ipv[k1 + ( i - k1 ) * incX];
+                for ( int j = 0; j < n; ++j ) {
+                    std::swap( B[j * lda + i], B[j * lda + pivot] );
+                }
+            }
+            if ( A != B ) { return EXIT_FAILURE; }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Sides that are not multiples of the tiles. The padding of B must be left untouched.
+int test_dlacpy_trans()
+{
+    printf( "%s:\t", __func__ );
+
+    const int sizes[][2] = { { 45, 77 }, { 77, 45 }, { 300, 170 }, { 170, 301 } };
+    for ( const int *size : sizes ) {
+        int            m = size[0], n = size[1], lda = m + 3, ldb = n + 5;
+        vector<double> A = test_vector( lda * n, 14 ), B = test_vector( ldb * m, 15 ), C( B );
+
+        my_dlacpy_trans( m, n, A.data(), lda, B.data(), ldb );
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < m; ++i ) {
+                C[i * ldb + j] = A[j * lda + i];
+            }
+        }
+        if ( B != C ) { return EXIT_FAILURE; }
+    }
+
+    return EXIT_SUCCESS;
+}
+
 /*============ TESTS DGETRF =============== */
 
 int test_dgetrf()
@@ -187,6 +550,743 @@ int test_dgetrf()
     return !equal;
 }
 
+/*============ TESTS DTRSM =============== */
+
+// Solves op( A ) * X = alpha * B, or X * op( A ) = alpha * B, with my_dtrsm and checks it against the dense op( A ),
+// transposed for the right side solves. With bInverses, the solve is done by my_dtrsm_inv on the inverses of the
+// diagonal blocks computed by my_dtrtri_diag.
+static int check_dtrsm( CBLAS_SIDE      side,
+                        CBLAS_UPLO      uplo,
+                        CBLAS_TRANSPOSE trans,
+                        CBLAS_DIAG      diag,
+                        double          alpha,
+                        int             m,
+                        int             n,
+                        bool            bInverses = false )
+{
+    // The unit diagonal is not referenced, a wrong value there would show. The off-diagonal entries are then scaled
+    // down so that the unit triangular matrix stays well conditioned.
+    int k = ( side == CblasLeft ) ? m : n;
+    Mat A = MatRandi( k, k, 10 );
+    for ( int j = 0; j < k; ++j ) {
+        for ( int i = 0; i < k; ++i ) {
+            if ( diag == CblasUnit ) { A.at( i, j ) /= 10. * k; }
+        }
+        A.at( j, j ) = ( diag == CblasUnit ) ? 1e3 : A.at( j, j ) + 10. * k;
+    }
+    Mat B = MatRandi( m, n, 100, 42 );
+    Mat X( B );
+    if ( bInverses ) {
+        std::vector<double> invA( _LAHPC_BLOCK_SIZE * k );
+        if ( my_dtrtri_diag( CblasColMajor, uplo, diag, k, A.get(), A.ld(), invA.data() ) != 0 ) {
+            return EXIT_FAILURE;
+        }
+        my_dtrsm_inv(
+            CblasColMajor, side, uplo, trans, diag, m, n, alpha, A.get(), A.ld(), invA.data(), X.get(), X.ld() );
+    }
+    else {
+        my_dtrsm( CblasColMajor, side, uplo, trans, diag, m, n, alpha, A.get(), A.ld(), X.get(), X.ld() );
+    }
+    for ( int i = 0; i < m * n; ++i ) {
+        B.at( i ) *= alpha;
+    }
+
+    // Dense op( A ) for the left side, op( A )^t for the right side
+    bool bTrans = ( trans == CblasTrans ) != ( side == CblasRight );
+    Mat  T      = MatZero( k, k );
+    for ( int j = 0; j < k; ++j ) {
+        for ( int i = 0; i < k; ++i ) {
+            bool bStored = ( uplo == CblasLower ) ? i >= j : i <= j;
+            if ( bStored ) { T.at( bTrans ? j : i, bTrans ? i : j ) = A.at( i, j ); }
+        }
+        if ( diag == CblasUnit ) { T.at( j, j ) = 1.; }
+    }
+
+    if ( side == CblasLeft ) { return solve_residual( T, X, B ) < 1e-14 ? EXIT_SUCCESS : EXIT_FAILURE; }
+
+    Mat Xt( n, m ), Bt( n, m );
+    for ( int j = 0; j < n; ++j ) {
+        for ( int i = 0; i < m; ++i ) {
+            Xt.at( j, i ) = X.at( i, j );
+            Bt.at( j, i ) = B.at( i, j );
+        }
+    }
+    return solve_residual( T, Xt, Bt ) < 1e-14 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Every side/uplo/trans/diag case, with alpha = 1 and not. The small size fits in a single diagonal block.
+int test_dtrsm()
+{
+    printf( "%s:\t", __func__ );
+
+    int sizes[][2] = { { 100, 70 }, { 20, 30 } };
+
+    CBLAS_SIDE      sides[]  = { CblasLeft, CblasRight };
+    CBLAS_UPLO      uplos[]  = { CblasLower, CblasUpper };
+    CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+    CBLAS_DIAG      diags[]  = { CblasNonUnit, CblasUnit };
+    double          alphas[] = { 1., -2.5 };
+    for ( auto &size : sizes ) {
+        for ( CBLAS_SIDE side : sides ) {
+            for ( CBLAS_UPLO uplo : uplos ) {
+                for ( CBLAS_TRANSPOSE trans : transs ) {
+                    for ( CBLAS_DIAG diag : diags ) {
+                        for ( double alpha : alphas ) {
+                            if ( check_dtrsm( side, uplo, trans, diag, alpha, size[0], size[1] ) != EXIT_SUCCESS ) {
+                                return EXIT_FAILURE;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#ifdef _OPENMP
+// Each thread gets a range of right-hand sides, or, when there are fewer blocks of them than threads, a share of the
+// GEMM updates
+int test_dtrsm_openmp()
+{
+    printf( "%s:\t", __func__ );
+
+    int maxThreads = omp_get_max_threads();
+    int result     = EXIT_SUCCESS;
+
+    // 9 blocks of right-hand sides always split, 2 blocks fall back to the shared GEMMs past 2 threads. The triangular
+    // matrix has 5 diagonal blocks.
+    int sizes[][2] = { { 150, 300 }, { 150, 50 } };
+    int threads[]  = { 2, 4, 7 };
+
+    CBLAS_SIDE      sides[]  = { CblasLeft, CblasRight };
+    CBLAS_UPLO      uplos[]  = { CblasLower, CblasUpper };
+    CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+    for ( int nt : threads ) {
+        omp_set_num_threads( nt );
+        for ( auto &size : sizes ) {
+            for ( CBLAS_SIDE side : sides ) {
+                // The triangular matrix keeps its order on both sides
+                int m = ( side == CblasLeft ) ? size[0] : size[1];
+                int n = ( side == CblasLeft ) ? size[1] : size[0];
+                for ( CBLAS_UPLO uplo : uplos ) {
+                    for ( CBLAS_TRANSPOSE trans : transs ) {
+                        if ( check_dtrsm( side, uplo, trans, CblasNonUnit, -2.5, m, n ) != EXIT_SUCCESS ) {
+                            result = EXIT_FAILURE;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    omp_set_num_threads( maxThreads );
+    return result;
+}
+#endif
+
+// A * A^-1 = I, the unit diagonal being left untouched, then solves with the cached inverses of the diagonal blocks
+int test_dtrtri()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 150, nrhs = 500;
+
+    CBLAS_SIDE      sides[]  = { CblasLeft, CblasRight };
+    CBLAS_UPLO      uplos[]  = { CblasLower, CblasUpper };
+    CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+    CBLAS_DIAG      diags[]  = { CblasNonUnit, CblasUnit };
+    for ( CBLAS_UPLO uplo : uplos ) {
+        for ( CBLAS_DIAG diag : diags ) {
+            // Same matrices as check_dtrsm, with the other triangle zeroed so that A is its own dense form
+            Mat A = MatRandi( size, size, 10 );
+            for ( int j = 0; j < size; ++j ) {
+                for ( int i = 0; i < size; ++i ) {
+                    bool bStored = ( uplo == CblasLower ) ? i >= j : i <= j;
+                    if ( !bStored ) { A.at( i, j ) = 0.; }
+                    else if ( diag == CblasUnit ) { A.at( i, j ) /= 10. * size; }
+                }
+                A.at( j, j ) = ( diag == CblasUnit ) ? 1e3 : A.at( j, j ) + 10. * size;
+            }
+            Mat Ainv( A ), I = MatSqrDiag( size, 1. );
+            if ( my_dtrtri( CblasColMajor, uplo, diag, size, Ainv.get(), Ainv.ld() ) != 0 ) { return EXIT_FAILURE; }
+
+            if ( diag == CblasUnit ) {
+                for ( int j = 0; j < size; ++j ) {
+                    if ( Ainv.at( j, j ) != 1e3 ) { return EXIT_FAILURE; }
+                    A.at( j, j ) = Ainv.at( j, j ) = 1.;
+                }
+            }
+            if ( solve_residual( A, Ainv, I ) >= 1e-14 ) { return EXIT_FAILURE; }
+
+            for ( CBLAS_SIDE side : sides ) {
+                for ( CBLAS_TRANSPOSE trans : transs ) {
+                    int m = ( side == CblasLeft ) ? size : nrhs;
+                    int n = ( side == CblasLeft ) ? nrhs : size;
+                    if ( check_dtrsm( side, uplo, trans, diag, -2.5, m, n, true ) != EXIT_SUCCESS ) {
+                        return EXIT_FAILURE;
+                    }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS DGESV =============== */
+
+int test_dgesv()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 150, nrhs = 40;
+
+    // Zero diagonal, so the factorization has to pivot
+    Mat A = MatRandi( size, size, 100 );
+    for ( int i = 0; i < size; ++i ) {
+        A.at( i, i ) = 0.;
+    }
+    Mat B = MatRandi( size, nrhs, 100, 42 );
+
+    Mat LU( A ), X( B );
+    int *ipiv = new int[size];
+    int  info = my_dgesv( CblasColMajor, size, nrhs, LU.get(), LU.ld(), ipiv, X.get(), X.ld() );
+    delete[] ipiv;
+
+    return ( info == 0 && solve_residual( A, X, B ) < 1e-14 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int test_lu_factorization()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 100;
+
+    Mat             A = MatRandi( size, size, 100 );
+    LUFactorization F( A );
+    if ( F.isSingular() ) { return EXIT_FAILURE; }
+
+    // Solve several batches against the same factors
+    for ( int nrhs = 1; nrhs <= 64; nrhs *= 4 ) {
+        Mat B = MatRandi( size, nrhs, 100, nrhs );
+        Mat X( B );
+        F.solve( X );
+        if ( solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS LU UPDATE =============== */
+
+// Low-rank modifications are solved through the Woodbury correction, until the cost model asks for a refactorization
+int test_lu_update()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 120;
+
+    Mat             A = MatRandi( size, size, 100 );
+    LUFactorization F( A );
+    Mat             B = MatRandi( size, 4, 100, 42 );
+
+    // Replace two columns
+    int cols[] = { 3, 77 };
+    Mat C      = MatRandi( size, 2, 100, 7 );
+    for ( int j = 0; j < 2; ++j ) {
+        for ( int i = 0; i < size; ++i ) {
+            A.at( i, cols[j] ) = C.at( i, j );
+        }
+    }
+    if ( F.updateColumns( 2, cols, C.get(), C.ld() ) || F.correctionRank() != 2 ) { return EXIT_FAILURE; }
+    Mat X( B );
+    F.solve( X );
+    if ( solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+
+    // Then three rows, one of them overlapping a modified column
+    int rows[] = { 0, 3, 119 };
+    Mat R      = MatRandi( 3, size, 100, 8 );
+    for ( int i = 0; i < 3; ++i ) {
+        for ( int j = 0; j < size; ++j ) {
+            A.at( rows[i], j ) = R.at( i, j );
+        }
+    }
+    if ( F.updateRows( 3, rows, R.get(), R.ld() ) || F.correctionRank() != 5 ) { return EXIT_FAILURE; }
+    X = B;
+    F.solve( X );
+    if ( solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+
+    // A high rank update is cheaper to refactorize
+    Mat U = MatRandi( size, 90, 10, 9 ), V = MatRandi( size, 90, 10, 10 );
+    my_dgemm_seq(
+        CblasColMajor, CblasNoTrans, CblasTrans, size, size, 90, 1.0, U.get(), U.ld(), V.get(), V.ld(), 1.0, A.get(), A.ld() );
+    if ( !F.update( 90, U.get(), U.ld(), V.get(), V.ld() ) || F.correctionRank() != 0 ) { return EXIT_FAILURE; }
+    X = B;
+    F.solve( X );
+
+    return solve_residual( A, X, B ) < 1e-14 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*============ TESTS DPOSV =============== */
+
+int test_dposv()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 150, nrhs = 40;
+
+    // A = R * R^t + size * I is symmetric positive definite
+    Mat R = MatRandi( size, size, 10 );
+    Mat A = MatSqrDiag( size, size );
+    my_dsyrk( CblasColMajor, CblasLower, CblasNoTrans, size, size, 1.0, R.get(), R.ld(), 1.0, A.get(), A.ld() );
+    for ( int j = 0; j < size; ++j ) {
+        for ( int i = 0; i < j; ++i ) {
+            A.at( i, j ) = A.at( j, i );
+        }
+    }
+    Mat B = MatRandi( size, nrhs, 100, 42 );
+
+    Mat L( A ), X( B );
+    int info = my_dposv( CblasColMajor, size, nrhs, L.get(), L.ld(), X.get(), X.ld() );
+
+    return ( info == 0 && solve_residual( A, X, B ) < 1e-14 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*============ TESTS DGELS =============== */
+
+// The least squares residual R = B - A * X is orthogonal to the range of A: A^t * R = 0
+int test_dgels()
+{
+    printf( "%s:\t", __func__ );
+
+    const int m = 200, n = 90, nrhs = 7;
+
+    Mat A = MatRandi( m, n, 10 );
+    Mat B = MatRandi( m, nrhs, 100, 42 );
+
+    Mat QR( A ), X( B );
+    int info = my_dgels( CblasColMajor, m, n, nrhs, QR.get(), QR.ld(), X.get(), X.ld() );
+
+    Mat R( B );
+    my_dgemm_seq(
+        CblasColMajor, CblasNoTrans, CblasNoTrans, m, nrhs, n, -1.0, A.get(), A.ld(), X.get(), X.ld(), 1.0, R.get(), R.ld() );
+    Mat G( n, nrhs );
+    my_dgemm_seq(
+        CblasColMajor, CblasTrans, CblasNoTrans, n, nrhs, m, 1.0, A.get(), A.ld(), R.get(), R.ld(), 0.0, G.get(), G.ld() );
+
+    double Gnorm = 0., Anorm = 0., Bnorm = 0.;
+    for ( int i = 0; i < n * nrhs; ++i ) {
+        Gnorm = std::max( Gnorm, std::abs( G.at( i ) ) );
+    }
+    for ( int i = 0; i < m * n; ++i ) {
+        Anorm = std::max( Anorm, std::abs( A.at( i ) ) );
+    }
+    for ( int i = 0; i < m * nrhs; ++i ) {
+        Bnorm = std::max( Bnorm, std::abs( B.at( i ) ) );
+    }
+
+    return ( info == 0 && Gnorm / ( m * Anorm * Bnorm ) < 1e-14 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*============ TESTS DSGESV =============== */
+
+int test_dsgesv()
+{
+    printf( "%s:\t", __func__ );
+
+    const int size = 150, nrhs = 5;
+
+    // Well conditioned: the single precision factorization must be refined to double accuracy
+    Mat A = MatRandi( size, size, 10 );
+    for ( int i = 0; i < size; ++i ) {
+        A.at( i, i ) += 10. * size;
+    }
+    Mat B = MatRandi( size, nrhs, 100, 42 );
+    Mat LU( A ), X( size, nrhs );
+    int ipiv[size];
+    int iter;
+
+    int info = my_dsgesv( CblasColMajor, size, nrhs, LU.get(), LU.ld(), ipiv, B.get(), B.ld(), X.get(), X.ld(), &iter );
+    if ( info != 0 || iter < 0 || !LU.equals( A ) || solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+
+    // Hilbert matrix: far too ill-conditioned for single precision, the solver must fall back to double
+    const int hsize = 12;
+    Mat       H( hsize, hsize ), HB = MatRandi( hsize, 1, 100, 42 ), HX( hsize, 1 );
+    for ( int j = 0; j < hsize; ++j ) {
+        for ( int i = 0; i < hsize; ++i ) {
+            H.at( i, j ) = 1. / ( i + j + 1 );
+        }
+    }
+    Mat HLU( H );
+
+    info = my_dsgesv( CblasColMajor, hsize, 1, HLU.get(), HLU.ld(), ipiv, HB.get(), HB.ld(), HX.get(), HX.ld(), &iter );
+
+    return ( info == 0 && iter < 0 && solve_residual( H, HX, HB ) < 1e-14 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*============ TESTS DGETRF BATCH =============== */
+
+// Every size class of the batched kernels, and the blocked fallback above 64
+int test_dgetrf_batch()
+{
+    printf( "%s:\t", __func__ );
+
+    const int sizes[] = { 5, 8, 13, 16, 29, 32, 50, 64, 80 };
+    const int batch = 20, nrhs = 3;
+
+    for ( int n : sizes ) {
+        vector<Mat>      A, LU, B, X;
+        vector<double *> pLU( batch ), pX( batch );
+        vector<int>      ipivs( batch * n ), info( batch );
+        vector<int *>    pIpiv( batch );
+
+        for ( int b = 0; b < batch; ++b ) {
+            A.push_back( MatRandi( n, n, 10, b + 1 ) );
+            B.push_back( MatRandi( n, nrhs, 100, b + 42 ) );
+        }
+        LU = A;
+        X  = B;
+        for ( int b = 0; b < batch; ++b ) {
+            pLU[b]   = LU[b].get();
+            pX[b]    = X[b].get();
+            pIpiv[b] = ipivs.data() + b * n;
+        }
+
+        my_dgetrf_batch( CblasColMajor, n, pLU.data(), n, pIpiv.data(), info.data(), batch );
+        my_dgetrs_batch( CblasColMajor, n, nrhs, pLU.data(), n, pIpiv.data(), pX.data(), n, batch );
+
+        for ( int b = 0; b < batch; ++b ) {
+            if ( info[b] != 0 || solve_residual( A[b], X[b], B[b] ) >= 1e-14 ) { return EXIT_FAILURE; }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS DGBTRF =============== */
+
+// The unblocked and blocked factorizations, the latter wide enough for the parallel version to split the updates
+int test_dgbtrf()
+{
+    printf( "%s:\t", __func__ );
+
+    const int bands[][3] = { { 60, 3, 5 }, { 300, 40, 35 }, { 500, 150, 120 } };
+    const int nrhs       = 3;
+
+    for ( const int *band : bands ) {
+        int n = band[0], kl = band[1], ku = band[2], kv = kl + ku, ldab = 2 * kl + ku + 1;
+
+        Mat            A = MatRandi( n, n, 100, n );
+        vector<double> AB( static_cast<size_t>( ldab ) * n, 0. );
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < n; ++i ) {
+                if ( i < j - ku || i > j + kl ) { A.at( i, j ) = 0.; }
+                else {
+                    AB[kv + i - j + static_cast<size_t>( j ) * ldab] = A.at( i, j );
+                }
+            }
+        }
+        Mat B = MatRandi( n, nrhs, 100, 42 );
+        Mat X( B );
+
+        vector<int> ipiv( n );
+        if ( my_dgbtrf( CblasColMajor, n, kl, ku, AB.data(), ldab, ipiv.data() ) != 0 ) { return EXIT_FAILURE; }
+        my_dgbtrs( CblasColMajor, n, kl, ku, nrhs, AB.data(), ldab, ipiv.data(), X.get(), X.ld() );
+
+        if ( solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS SPARSE =============== */
+
+static double max_diff( Mat A, Mat B )
+{
+    double d = 0.;
+    for ( int j = 0; j < A.dimY(); ++j ) {
+        for ( int i = 0; i < A.dimX(); ++i ) {
+            d = std::max( d, std::abs( A.at( i, j ) - B.at( i, j ) ) );
+        }
+    }
+    return d;
+}
+
+// Products of both storages against the dense kernels, large enough for the parallel paths, then a symmetric
+// Matrix Market file read back
+int test_sparse()
+{
+    printf( "%s:\t", __func__ );
+
+    const int m = 400, k = 300, n = 7;
+
+    Mat A = MatRandi( m, k, 10, 3 );
+    for ( int j = 0; j < k; ++j ) {
+        for ( int i = 0; i < m; ++i ) {
+            if ( ( i * 7 + j * 13 ) % 3 != 0 ) { A.at( i, j ) = 0.; }
+        }
+    }
+
+    for ( SparseMat::Format format : { SparseMat::CSR, SparseMat::CSC } ) {
+        SparseMat S = SparseMat::fromDense( m, k, A.get(), A.ld(), format );
+        if ( max_diff( S.toDense(), A ) != 0. ) { return EXIT_FAILURE; }
+
+        for ( CBLAS_TRANSPOSE trans : { CblasNoTrans, CblasTrans } ) {
+            int rows = ( trans == CblasNoTrans ) ? m : k, cols = ( trans == CblasNoTrans ) ? k : m;
+            Mat B = MatRandi( cols, n, 10, 5 ), C = MatRandi( rows, n, 10, 6 ), D( C );
+
+            S.spmm( trans, n, 2., B.get(), B.ld(), -1., C.get(), C.ld() );
+            my_dgemm_seq( CblasColMajor, trans, CblasNoTrans, rows, n, cols, 2., A.get(), A.ld(), B.get(), B.ld(), -1.,
+                          D.get(), D.ld() );
+            if ( max_diff( C, D ) != 0. ) { return EXIT_FAILURE; }
+
+            Mat x = MatRandi( cols, 1, 10, 7 ), y = MatRandi( rows, 1, 10, 8 ), z( y );
+            S.spmv( trans, 3., x.get(), 0., y.get() );
+            my_dgemv_seq( CblasColMajor, trans, m, k, 3., A.get(), A.ld(), x.get(), 1, 0., z.get(), 1 );
+            if ( max_diff( y, z ) != 0. ) { return EXIT_FAILURE; }
+        }
+    }
+
+    const char *path = "test_sparse.mtx";
+    FILE *      f    = fopen( path, "w" );
+    if ( !f ) { return EXIT_FAILURE; }
+    fprintf( f, "%%%%MatrixMarket matrix coordinate real symmetric\n%% lower triangle\n3 3 4\n" );
+    fprintf( f, "1 1 4.0\n2 1 -1.0\n3 2 2.5\n3 3 1.0\n" );
+    fclose( f );
+    SparseMat M = SparseMat::readMatrixMarket( path, SparseMat::CSC );
+    remove( path );
+
+    Mat E = MatZero( 3, 3 );
+    E.at( 0, 0 ) = 4.;
+    E.at( 1, 0 ) = E.at( 0, 1 ) = -1.;
+    E.at( 2, 1 ) = E.at( 1, 2 ) = 2.5;
+    E.at( 2, 2 ) = 1.;
+
+    return ( M.nnz() == 6 && max_diff( M.toDense(), E ) == 0. ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*============ TESTS DGEMM MASKED =============== */
+
+// Products of triangular factors skip about two thirds of the tile products, and must match the dense product
+int test_dgemm_masked()
+{
+    printf( "%s:\t", __func__ );
+
+    const int n = 150;
+
+    Mat L = MatRandLi( n ), U = MatRandUi( n );
+    int tiles = ( n + _LAHPC_BLOCK_SIZE - 1 ) / _LAHPC_BLOCK_SIZE;
+    vector<unsigned char> maskL( tiles * tiles ), maskU( tiles * tiles );
+    my_dtile_mask( n, n, L.get(), L.ld(), maskL.data() );
+    my_dtile_mask( n, n, U.get(), U.ld(), maskU.data() );
+    if ( maskL[tiles - 1] != 1 || maskL[( tiles - 1 ) * tiles] != 0 ) { return EXIT_FAILURE; }
+
+    CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+    for ( CBLAS_TRANSPOSE transA : transs ) {
+        for ( CBLAS_TRANSPOSE transB : transs ) {
+            Mat C = MatRandi( n, n, 10, 4 ), D( C );
+            my_dgemm_masked( CblasColMajor, transA, transB, n, n, n, 2., L.get(), L.ld(), maskL.data(), U.get(), U.ld(),
+                             maskU.data(), -1., C.get(), C.ld() );
+            my_dgemm_seq(
+                CblasColMajor, transA, transB, n, n, n, 2., L.get(), L.ld(), U.get(), U.ld(), -1., D.get(), D.ld() );
+            if ( max_diff( C, D ) != 0. ) { return EXIT_FAILURE; }
+
+            // Masks computed by the product itself, and C not read when beta is 0
+            C = D = MatRandi( n, n, 10, 5 );
+            for ( int i = 0; i < n; ++i ) {
+                C.at( i, i ) = std::numeric_limits<double>::quiet_NaN();
+            }
+            my_dgemm_masked( CblasColMajor, transA, transB, n, n, n, 1., U.get(), U.ld(), nullptr, L.get(), L.ld(),
+                             nullptr, 0., C.get(), C.ld() );
+            my_dgemm_seq(
+                CblasColMajor, transA, transB, n, n, n, 1., U.get(), U.ld(), L.get(), L.ld(), 0., D.get(), D.ld() );
+            if ( max_diff( C, D ) != 0. ) { return EXIT_FAILURE; }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS KRYLOV =============== */
+
+// Five point finite differences of -laplacian + c * d/dx on an s x s grid, symmetric when c is 0
+static SparseMat convection_diffusion( int s, double c, SparseMat::Format format )
+{
+    vector<int>    rows, cols;
+    vector<double> values;
+    for ( int j = 0; j < s; ++j ) {
+        for ( int i = 0; i < s; ++i ) {
+            // West, east, south and north neighbours, -1 outside of the grid
+            int    k         = j * s + i;
+            int    nb[]      = { i > 0 ? k - 1 : -1,
+                                 i < s - 1 ? k + 1 : -1,
+                                 j > 0 ? k - s : -1,
+                                 j < s - 1 ? k + s : -1 };
+            double weights[] = { -1. - c, -1. + c, -1., -1. };
+            rows.push_back( k );
+            cols.push_back( k );
+            values.push_back( 4. );
+            for ( int e = 0; e < 4; ++e ) {
+                if ( nb[e] < 0 ) { continue; }
+                rows.push_back( k );
+                cols.push_back( nb[e] );
+                values.push_back( weights[e] );
+            }
+        }
+    }
+    return SparseMat( s * s, s * s, (int)values.size(), rows.data(), cols.data(), values.data(), format );
+}
+
+// CG and GMRES, on the sparse and dense operators, with and without block-Jacobi preconditioning
+int test_krylov()
+{
+    printf( "%s:\t", __func__ );
+
+    const int    s = 24, n = s * s;
+    const double tol = 1e-12;
+    Mat          b = MatRandi( n, 1, 100, 11 );
+
+    SparseMat    L = convection_diffusion( s, 0., SparseMat::CSR );
+    LinearOperator opL = sparseOperator( L );
+    BlockJacobi  cholesky( L, 2 * s, BlockJacobi::Cholesky );
+    if ( cholesky.info() != 0 ) { return EXIT_FAILURE; }
+
+    Mat          x     = MatZero( n, 1 );
+    KrylovResult plain = conjugateGradient( n, opL, b.get(), x.get(), nullptr, tol );
+    if ( !plain.converged || plain.residual > 10 * tol ) { return EXIT_FAILURE; }
+    x                    = MatZero( n, 1 );
+    KrylovResult precond = conjugateGradient( n, opL, b.get(), x.get(), &cholesky, tol );
+    if ( !precond.converged || precond.residual > 10 * tol || precond.iterations >= plain.iterations ) {
+        return EXIT_FAILURE;
+    }
+
+    // The block size does not divide n, leaving a smaller last block
+    SparseMat   C = convection_diffusion( s, 0.4, SparseMat::CSC );
+    BlockJacobi lu( C, 50, BlockJacobi::LU );
+    if ( lu.info() != 0 ) { return EXIT_FAILURE; }
+
+    x       = MatZero( n, 1 );
+    precond = gmres( n, sparseOperator( C ), b.get(), x.get(), &lu, tol, 1000, 20 );
+    if ( !precond.converged || precond.residual > 10 * tol ) { return EXIT_FAILURE; }
+
+    Mat D = C.toDense();
+    x     = MatZero( n, 1 );
+    plain = gmres( n, denseOperator( n, D.get(), D.ld() ), b.get(), x.get(), nullptr, tol, 2000, 20 );
+    if ( !plain.converged || plain.residual > 10 * tol || precond.iterations >= plain.iterations ) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*============ TESTS RFP =============== */
+
+// Odd and even orders of both triangles, the largest one past the parallel threshold of the conversions
+int test_rfp()
+{
+    printf( "%s:\t", __func__ );
+
+    const int        sizes[] = { 1, 8, 69, 300 };
+    const CBLAS_UPLO uplos[] = { CblasLower, CblasUpper };
+    const int        nrhs = 5, k = 20;
+
+    for ( int n : sizes ) {
+        // A = R * R^t + n * I is symmetric positive definite
+        Mat R = MatRandi( n, n, 10, n );
+        Mat A = MatSqrDiag( n, n );
+        my_dsyrk( CblasColMajor, CblasLower, CblasNoTrans, n, n, 1.0, R.get(), R.ld(), 1.0, A.get(), A.ld() );
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < j; ++i ) {
+                A.at( i, j ) = A.at( j, i );
+            }
+        }
+        Mat C = MatRandi( n, k, 10, 7 );
+
+        for ( CBLAS_UPLO uplo : uplos ) {
+            RFPMat P = RFPMat::fromDense( n, A.get(), A.ld(), uplo );
+            if ( !P.toDense().equals( A ) ) { return EXIT_FAILURE; }
+
+            RFPMat Q = P;
+            Mat    D( A );
+            Q.rankUpdate( CblasNoTrans, k, -0.5, C.get(), C.ld(), 2. );
+            my_dsyrk( CblasColMajor, uplo, CblasNoTrans, n, k, -0.5, C.get(), C.ld(), 2., D.get(), D.ld() );
+            if ( max_diff( Q.toDense(), RFPMat::fromDense( n, D.get(), D.ld(), uplo ).toDense() ) > 1e-12 ) {
+                return EXIT_FAILURE;
+            }
+
+            if ( P.cholesky() != 0 ) { return EXIT_FAILURE; }
+            Mat B = MatRandi( n, nrhs, 100, 42 );
+            Mat X( B );
+            P.solve( nrhs, X.get(), X.ld() );
+            if ( solve_residual( A, X, B ) >= 1e-14 ) { return EXIT_FAILURE; }
+
+            // Triangular solves with the factor, against my_dtrsm on its dense copy
+            Mat                   T        = P.toDense( true );
+            const CBLAS_SIDE      sides[]  = { CblasLeft, CblasRight };
+            const CBLAS_TRANSPOSE transs[] = { CblasNoTrans, CblasTrans };
+            for ( CBLAS_SIDE side : sides ) {
+                for ( CBLAS_TRANSPOSE trans : transs ) {
+                    int m = ( side == CblasLeft ) ? n : nrhs, c = ( side == CblasLeft ) ? nrhs : n;
+                    Mat Y = MatRandi( m, c, 100, 3 ), Z( Y );
+                    P.triangularSolve( side, trans, CblasNonUnit, m, c, 0.5, Y.get(), Y.ld() );
+                    my_dtrsm(
+                        CblasColMajor, side, uplo, trans, CblasNonUnit, m, c, 0.5, T.get(), T.ld(), Z.get(), Z.ld() );
+                    if ( max_diff( Y, Z ) > 1e-12 ) { return EXIT_FAILURE; }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// The RFP storage against the examples of LAPACK's dtrttf for TRANSR = 'N', the entry ij standing for A( i, j ), for
+// an odd and an even order and both triangles. The other triangle of A holds -1, which must never be copied.
+int test_rfp_layout()
+{
+    printf( "%s:\t", __func__ );
+
+    // Rows of the ld-by-( N + 1 ) / 2 rectangles
+    const int lower5[5][3] = { { 0, 33, 43 }, { 10, 11, 44 }, { 20, 21, 22 }, { 30, 31, 32 }, { 40, 41, 42 } };
+    const int upper5[5][3] = { { 2, 3, 4 }, { 12, 13, 14 }, { 22, 23, 24 }, { 0, 33, 34 }, { 1, 11, 44 } };
+    const int lower6[7][3] = { { 33, 43, 53 }, { 0, 44, 54 }, { 10, 11, 55 }, { 20, 21, 22 },
+                               { 30, 31, 32 }, { 40, 41, 42 }, { 50, 51, 52 } };
+    const int upper6[7][3] = { { 3, 4, 5 },   { 13, 14, 15 }, { 23, 24, 25 }, { 33, 34, 35 },
+                               { 0, 44, 45 }, { 1, 11, 55 },  { 2, 12, 22 } };
+
+    struct {
+        int        n;
+        CBLAS_UPLO uplo;
+        const int( *expected )[3];
+    } cases[] = {
+        { 5, CblasLower, lower5 }, { 5, CblasUpper, upper5 }, { 6, CblasLower, lower6 }, { 6, CblasUpper, upper6 } };
+
+    for ( const auto &c : cases ) {
+        int            n = c.n, ld = ( n % 2 == 1 ) ? n : n + 1;
+        vector<double> A( n * n ), ARF( n * ( n + 1 ) / 2, -2. ), B( n * n, -1. );
+        for ( int j = 0; j < n; ++j ) {
+            for ( int i = 0; i < n; ++i ) {
+                bool inside  = ( c.uplo == CblasLower ) ? i >= j : i <= j;
+                A[i + j * n] = inside ? 10 * i + j : -1.;
+            }
+        }
+
+        my_dtrttf( CblasColMajor, c.uplo, n, A.data(), n, ARF.data() );
+        for ( int r = 0; r < ld; ++r ) {
+            for ( int k = 0; k < ( n + 1 ) / 2; ++k ) {
+                if ( ARF[r + k * ld] != c.expected[r][k] ) { return EXIT_FAILURE; }
+            }
+        }
+
+        my_dtfttr( CblasColMajor, c.uplo, n, ARF.data(), B.data(), n );
+        if ( A != B ) { return EXIT_FAILURE; }
+    }
+
+    return EXIT_SUCCESS;
+}
+
 int main( int argc, char **argv )
 {
     printf( "----------- TEST VALID -----------\n" );
@@ -196,8 +1296,36 @@ int main( int argc, char **argv )
     // srand(time(NULL));
 
     print_test_result( test_dgemm_square(), &nb_success, &nb_tests );
-    // print_test_result( test_dgemm_rectangle(), &nb_success, &nb_tests );
+    print_test_result( test_dgemm_rectangle(), &nb_success, &nb_tests );
+    print_test_result( test_dgemm_skinny(), &nb_success, &nb_tests );
+    print_test_result( test_level1(), &nb_success, &nb_tests );
+    print_test_result( test_fused_level1(), &nb_success, &nb_tests );
+#ifdef _OPENMP
+    print_test_result( test_idamax_openmp(), &nb_success, &nb_tests );
+#endif
+    print_test_result( test_dgemv(), &nb_success, &nb_tests );
+    print_test_result( test_dger(), &nb_success, &nb_tests );
+    print_test_result( test_dlaswp(), &nb_success, &nb_tests );
+    print_test_result( test_dlacpy_trans(), &nb_success, &nb_tests );
     print_test_result( test_dgetrf(), &nb_success, &nb_tests );
+    print_test_result( test_dtrsm(), &nb_success, &nb_tests );
+#ifdef _OPENMP
+    print_test_result( test_dtrsm_openmp(), &nb_success, &nb_tests );
+#endif
+    print_test_result( test_dtrtri(), &nb_success, &nb_tests );
+    print_test_result( test_dgesv(), &nb_success, &nb_tests );
+    print_test_result( test_lu_factorization(), &nb_success, &nb_tests );
+    print_test_result( test_lu_update(), &nb_success, &nb_tests );
+    print_test_result( test_dgetrf_batch(), &nb_success, &nb_tests );
+    print_test_result( test_dgbtrf(), &nb_success, &nb_tests );
+    print_test_result( test_dposv(), &nb_success, &nb_tests );
+    print_test_result( test_dgels(), &nb_success, &nb_tests );
+    print_test_result( test_dsgesv(), &nb_success, &nb_tests );
+    print_test_result( test_sparse(), &nb_success, &nb_tests );
+    print_test_result( test_dgemm_masked(), &nb_success, &nb_tests );
+    print_test_result( test_krylov(), &nb_success, &nb_tests );
+    print_test_result( test_rfp_layout(), &nb_success, &nb_tests );
+    print_test_result( test_rfp(), &nb_success, &nb_tests );
 
     print_test_summary( nb_success, nb_tests );
 
@@ -163,4 +163,59 @@ void my_dgemm_tiled_starpu( CBLAS_LAYOUT layout,
 void my_dgetrf_tiled_starpu( CBLAS_LAYOUT layout,
                              int m, int n, int b, double **a );
 
+/**
+ * Tile kernels for the LU factorization with incremental pivoting
+ *
+ * Pivots are stored in LAPACK convention (1-based). In dtstrf/dssssm, a pivot
+ * p <= n refers to the row p of the top tile, and p > n to the row (p - n) of
+ * the bottom tile. L is the ib-by-n workspace holding the unit lower
+ * triangular factors of the top tile produced by dtstrf.
+ */
+int  CORE_dgetrf_incpiv( int m, int n, double *A, int lda, int *IPIV );
+void CORE_dgessm( int m, int n, int k, const int *IPIV,
+                  const double *L, int ldl, double *A, int lda );
+int  CORE_dtstrf( int m, int n, int ib,
+                  double *U, int ldu, double *A, int lda,
+                  double *L, int ldl, int *IPIV );
+void CORE_dssssm( int n, int m2, int k, int ib,
+                  double *A1, int lda1, double *A2, int lda2,
+                  const double *L1, int ldl1, const double *L2, int ldl2,
+                  const int *IPIV );
+
+/**
+ * Workspaces of the incremental pivoting: one ib-by-b L tile and one b
+ * pivots array per tile of A
+ */
+void incpivAlloc( int M, int N, int b, int ib, double ***L, int ***IPIV );
+void incpivFree( int M, int N, int b, double **L, int **IPIV );
+
+void my_dgetrf_incpiv_tiled_openmp( CBLAS_LAYOUT layout,
+                                    int m, int n, int b, int ib,
+                                    double **a, double **l, int **ipiv );
+void my_dgetrs_incpiv_tiled_openmp( CBLAS_LAYOUT layout,
+                                    int n, int nrhs, int b, int ib,
+                                    const double **a, const double **l, const int **ipiv,
+                                    double **x );
+
+void my_dgetrf_incpiv_tiled_starpu( CBLAS_LAYOUT layout,
+                                    int m, int n, int b, int ib,
+                                    double **a, double **l, int **ipiv );
+
+/**
+ * Tiled Cholesky factorization of a symmetric positive definite matrix. Only
+ * the lower tiles are referenced and overwritten by L. Returns 0, or i+1 when
+ * the leading minor of order i+1 is not positive definite.
+ */
+typedef int (*dpotrf_tiled_fct_t)( CBLAS_LAYOUT layout,
+                                   int n, int b, double **a );
+
+int my_dpotrf_tiled_openmp( CBLAS_LAYOUT layout,
+                            int n, int b, double **a );
+void my_dpotrs_tiled_openmp( CBLAS_LAYOUT layout,
+                             int n, int nrhs, int b,
+                             const double **a, double **x );
+
+int my_dpotrf_tiled_starpu( CBLAS_LAYOUT layout,
+                            int n, int b, double **a );
+
 #endif /* _algonum_h_ */
@@ -119,5 +119,23 @@ void insert_dgemm ( CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, int m, int n
                     double alpha, starpu_data_handle_t A, int lda,
                     starpu_data_handle_t B, int ldb,
                     double beta, starpu_data_handle_t C, int ldc );
+void insert_dsyrk ( CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, int n, int k,
+                    double alpha, starpu_data_handle_t A, int lda,
+                    double beta,  starpu_data_handle_t C, int ldc );
+void insert_dpotrf( int n, starpu_data_handle_t A, int lda );
+
+/**
+ * Insert task functions of the LU factorization with incremental pivoting
+ */
+void insert_dgetrf_incpiv( int m, int n, starpu_data_handle_t A, int lda, starpu_data_handle_t IPIV );
+void insert_dgessm( int m, int n, int k, starpu_data_handle_t IPIV,
+                    starpu_data_handle_t L, int ldl, starpu_data_handle_t A, int lda );
+void insert_dtstrf( int m, int n, int ib, starpu_data_handle_t U, int ldu,
+                    starpu_data_handle_t A, int lda,
+                    starpu_data_handle_t L, int ldl, starpu_data_handle_t IPIV );
+void insert_dssssm( int n, int m2, int k, int ib,
+                    starpu_data_handle_t A1, int lda1, starpu_data_handle_t A2, int lda2,
+                    starpu_data_handle_t L1, int ldl1, starpu_data_handle_t L2, int ldl2,
+                    starpu_data_handle_t IPIV );
 
 #endif
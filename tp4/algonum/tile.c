@@ -1,6 +1,25 @@
 #include <assert.h>
+#include <string.h>
 #include "algonum_int.h"
 
+/* Tile columns are contiguous, so a copy is one memcpy per column, and a single
+ * one when neither side has leading dimension padding */
+static inline void
+tile_dlacpy( int M, int N,
+             const double *A, int lda,
+             double *B, int ldb )
+{
+    int n;
+
+    if ( (lda == M) && (ldb == M) ) {
+        memcpy( B, A, (size_t)M * N * sizeof(double) );
+        return;
+    }
+    for( n=0; n<N; n++) {
+        memcpy( B + (size_t)ldb * n, A + (size_t)lda * n, M * sizeof(double) );
+    }
+}
+
 double **
 lapack2tile( int M, int N, int b,
              const double *Alapack, int lda )
@@ -20,11 +39,10 @@ lapack2tile( int M, int N, int b,
             int mm = m == (MT-1) ? M - m * b : b;
             int nn = n == (NT-1) ? N - n * b : b;
 
-            /* Let's use LAPACKE to ease the copy */
             if ( Alapack != NULL ) {
-                LAPACKE_dlacpy_work( LAPACK_COL_MAJOR, 'A', mm, nn,
-                                     Alapack + lda * b * n + b * m, lda,
-                                     tile, b );
+                tile_dlacpy( mm, nn,
+                             Alapack + lda * b * n + b * m, lda,
+                             tile, b );
             }
             Atile[ MT * n + m ] = tile;
         }
@@ -52,10 +70,9 @@ tile2lapack( int M, int N, int b,
             int mm = m == (MT-1) ? M - m * b : b;
             int nn = n == (NT-1) ? N - n * b : b;
 
-            /* Let's use LAPACKE to ease the copy */
-            LAPACKE_dlacpy_work( LAPACK_COL_MAJOR, 'A', mm, nn,
-                                 tile, b,
-                                 Alapack + lda * b * n + b * m, lda );
+            tile_dlacpy( mm, nn,
+                         tile, b,
+                         Alapack + lda * b * n + b * m, lda );
         }
     }
 }
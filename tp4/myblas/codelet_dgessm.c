@@ -0,0 +1,82 @@
+/**
+ *
+ * @file codelet_dgessm.c
+ *
+ * @brief dgessm StarPU codelet
+ *
+ */
+#include "algonum.h"
+#include "codelets.h"
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dgessm_arg_s {
+    int m;
+    int n;
+    int k;
+    int ldl;
+    int lda;
+} cl_dgessm_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dgessm_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dgessm_arg_t args;
+    const int *IPIV;
+    double *L;
+    double *A;
+
+    IPIV = (const int *)STARPU_VECTOR_GET_PTR(descr[0]);
+    L    = tile_interface_get(descr[1]);
+    A    = tile_interface_get(descr[2]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    CORE_dgessm( args.m, args.n, args.k, IPIV, L, args.ldl, A, args.lda );
+}
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dgessm = {
+    .where      = STARPU_CPU,
+    .cpu_func   = cl_dgessm_cpu_func,
+    .cuda_flags = { 0 },
+    .cuda_func  = NULL,
+    .nbuffers   = 3,
+    .name       = "gessm"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dgessm( int                  m,
+               int                  n,
+               int                  k,
+               starpu_data_handle_t IPIV,
+               starpu_data_handle_t L,
+               int                  ldl,
+               starpu_data_handle_t A,
+               int                  lda )
+{
+    cl_dgessm_arg_t args = {
+        .m       = m,
+        .n       = n,
+        .k       = k,
+        .ldl     = ldl,
+        .lda     = lda,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dgessm),
+        STARPU_VALUE, &args, sizeof(cl_dgessm_arg_t),
+        STARPU_R,     IPIV,
+        STARPU_R,     L,
+        STARPU_RW,    A,
+        0);
+}
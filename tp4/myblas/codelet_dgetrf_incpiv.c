@@ -0,0 +1,73 @@
+/**
+ *
+ * @file codelet_dgetrf_incpiv.c
+ *
+ * @brief dgetrf with partial pivoting StarPU codelet, diagonal tile of the
+ * incremental pivoting LU
+ *
+ */
+#include "algonum.h"
+#include "codelets.h"
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dgetrf_incpiv_arg_s {
+    int m;
+    int n;
+    int lda;
+} cl_dgetrf_incpiv_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dgetrf_incpiv_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dgetrf_incpiv_arg_t args;
+    double *A;
+    int    *IPIV;
+
+    A    = tile_interface_get(descr[0]);
+    IPIV = (int *)STARPU_VECTOR_GET_PTR(descr[1]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    CORE_dgetrf_incpiv( args.m, args.n, A, args.lda, IPIV );
+}
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dgetrf_incpiv = {
+    .where      = STARPU_CPU,
+    .cpu_func   = cl_dgetrf_incpiv_cpu_func,
+    .cuda_flags = { 0 },
+    .cuda_func  = NULL,
+    .nbuffers   = 2,
+    .name       = "getrf_incpiv"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dgetrf_incpiv( int                  m,
+                      int                  n,
+                      starpu_data_handle_t A,
+                      int                  lda,
+                      starpu_data_handle_t IPIV )
+{
+    cl_dgetrf_incpiv_arg_t args = {
+        .m       = m,
+        .n       = n,
+        .lda     = lda,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dgetrf_incpiv),
+        STARPU_VALUE, &args, sizeof(cl_dgetrf_incpiv_arg_t),
+        STARPU_RW,    A,
+        STARPU_W,     IPIV,
+        0);
+}
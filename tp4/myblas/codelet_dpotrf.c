@@ -0,0 +1,68 @@
+/**
+ *
+ * @file codelet_dpotrf.c
+ *
+ * @brief dpotrf StarPU codelet, diagonal tile of the Cholesky factorization
+ *
+ */
+#include "codelets.h"
+#include <assert.h>
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dpotrf_arg_s {
+    int n;
+    int lda;
+} cl_dpotrf_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dpotrf_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dpotrf_arg_t args;
+    double *A;
+    int rc;
+
+    A = tile_interface_get(descr[0]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    rc = LAPACKE_dpotrf_work( LAPACK_COL_MAJOR, 'L', args.n, A, args.lda );
+    assert( rc == 0 );
+    (void)rc;
+}
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dpotrf = {
+    .where      = STARPU_CPU,
+    .cpu_func   = cl_dpotrf_cpu_func,
+    .cuda_flags = { 0 },
+    .cuda_func  = NULL,
+    .nbuffers   = 1,
+    .name       = "potrf"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dpotrf( int                  n,
+               starpu_data_handle_t A,
+               int                  lda )
+{
+    cl_dpotrf_arg_t args = {
+        .n       = n,
+        .lda     = lda,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dpotrf),
+        STARPU_VALUE, &args, sizeof(cl_dpotrf_arg_t),
+        STARPU_RW,    A,
+        0);
+}
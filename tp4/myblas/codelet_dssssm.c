@@ -0,0 +1,101 @@
+/**
+ *
+ * @file codelet_dssssm.c
+ *
+ * @brief dssssm StarPU codelet
+ *
+ */
+#include "algonum.h"
+#include "codelets.h"
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dssssm_arg_s {
+    int n;
+    int m2;
+    int k;
+    int ib;
+    int lda1;
+    int lda2;
+    int ldl1;
+    int ldl2;
+} cl_dssssm_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dssssm_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dssssm_arg_t args;
+    double    *A1;
+    double    *A2;
+    double    *L1;
+    double    *L2;
+    const int *IPIV;
+
+    A1   = tile_interface_get(descr[0]);
+    A2   = tile_interface_get(descr[1]);
+    L1   = tile_interface_get(descr[2]);
+    L2   = tile_interface_get(descr[3]);
+    IPIV = (const int *)STARPU_VECTOR_GET_PTR(descr[4]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    CORE_dssssm( args.n, args.m2, args.k, args.ib,
+                 A1, args.lda1, A2, args.lda2,
+                 L1, args.ldl1, L2, args.ldl2, IPIV );
+}
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dssssm = {
+    .where      = STARPU_CPU,
+    .cpu_func   = cl_dssssm_cpu_func,
+    .cuda_flags = { 0 },
+    .cuda_func  = NULL,
+    .nbuffers   = 5,
+    .name       = "ssssm"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dssssm( int                  n,
+               int                  m2,
+               int                  k,
+               int                  ib,
+               starpu_data_handle_t A1,
+               int                  lda1,
+               starpu_data_handle_t A2,
+               int                  lda2,
+               starpu_data_handle_t L1,
+               int                  ldl1,
+               starpu_data_handle_t L2,
+               int                  ldl2,
+               starpu_data_handle_t IPIV )
+{
+    cl_dssssm_arg_t args = {
+        .n       = n,
+        .m2      = m2,
+        .k       = k,
+        .ib      = ib,
+        .lda1    = lda1,
+        .lda2    = lda2,
+        .ldl1    = ldl1,
+        .ldl2    = ldl2,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dssssm),
+        STARPU_VALUE, &args, sizeof(cl_dssssm_arg_t),
+        STARPU_RW,    A1,
+        STARPU_RW,    A2,
+        STARPU_R,     L1,
+        STARPU_R,     L2,
+        STARPU_R,     IPIV,
+        0);
+}
@@ -0,0 +1,128 @@
+/**
+ *
+ * @file codelet_dsyrk.c
+ *
+ * @brief dsyrk StarPU codelet
+ *
+ */
+#include "codelets.h"
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dsyrk_arg_s {
+    CBLAS_UPLO      uplo;
+    CBLAS_TRANSPOSE trans;
+    int             n;
+    int             k;
+    double          alpha;
+    int             lda;
+    double          beta;
+    int             ldc;
+} cl_dsyrk_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dsyrk_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dsyrk_arg_t args;
+    double *A;
+    double *C;
+
+    A = tile_interface_get(descr[0]);
+    C = tile_interface_get(descr[1]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    cblas_dsyrk( CblasColMajor, args.uplo, args.trans, args.n, args.k,
+                 args.alpha, A, args.lda, args.beta, C, args.ldc );
+}
+
+/**
+ * @brief Codelet CUDA function
+ */
+#if defined(ENABLE_CUDA)
+static void cl_dsyrk_cuda_func(void *descr[], void *cl_arg)
+{
+    cublasHandle_t handle = starpu_cublas_get_local_handle();
+    cl_dsyrk_arg_t args;
+    double *A;
+    double *C;
+
+    A = tile_interface_get(descr[0]);
+    C = tile_interface_get(descr[1]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    cublasDsyrk( handle,
+                 get_cublas_uplo( args.uplo ),
+                 get_cublas_trans( args.trans ),
+                 args.n, args.k, &(args.alpha), A, args.lda,
+                 &(args.beta), C, args.ldc );
+
+#if !defined(STARPU_CUDA_ASYNC)
+    cudaStreamSynchronize( stream );
+#endif
+
+    return;
+}
+#else
+static void cl_dsyrk_cuda_func(void *descr[], void *cl_arg)
+{
+    (void)descr;
+    (void)cl_arg;
+    return;
+}
+#endif /* ENABLE_CUDA */
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dsyrk = {
+#if defined(ENABLE_CUDA)
+    .where      = STARPU_CUDA | STARPU_CPU,
+#else
+    .where      = STARPU_CPU,
+#endif
+    .cpu_func   = cl_dsyrk_cpu_func,
+    .cuda_flags = { STARPU_CUDA_ASYNC },
+    .cuda_func  = cl_dsyrk_cuda_func,
+    .nbuffers   = 2,
+    .name       = "syrk"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dsyrk( CBLAS_UPLO           uplo,
+              CBLAS_TRANSPOSE      trans,
+              int                  n,
+              int                  k,
+              double               alpha,
+              starpu_data_handle_t A,
+              int                  lda,
+              double               beta,
+              starpu_data_handle_t C,
+              int                  ldc )
+{
+    cl_dsyrk_arg_t args = {
+        .uplo  = uplo,
+        .trans = trans,
+        .n     = n,
+        .k     = k,
+        .alpha = alpha,
+        .lda   = lda,
+        .beta  = beta,
+        .ldc   = ldc,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dsyrk),
+        STARPU_VALUE, &args, sizeof(cl_dsyrk_arg_t),
+        STARPU_R,     A,
+        STARPU_RW,    C,
+        0);
+}
@@ -0,0 +1,90 @@
+/**
+ *
+ * @file codelet_dtstrf.c
+ *
+ * @brief dtstrf StarPU codelet
+ *
+ */
+#include "algonum.h"
+#include "codelets.h"
+
+/**
+ * @brief Structure to gather static parameters of the kernel
+ */
+typedef struct cl_dtstrf_arg_s {
+    int m;
+    int n;
+    int ib;
+    int ldu;
+    int lda;
+    int ldl;
+} cl_dtstrf_arg_t;
+
+/**
+ * @brief Codelet CPU function
+ */
+static void
+cl_dtstrf_cpu_func( void *descr[], void *cl_arg )
+{
+    cl_dtstrf_arg_t args;
+    double *U;
+    double *A;
+    double *L;
+    int    *IPIV;
+
+    U    = tile_interface_get(descr[0]);
+    A    = tile_interface_get(descr[1]);
+    L    = tile_interface_get(descr[2]);
+    IPIV = (int *)STARPU_VECTOR_GET_PTR(descr[3]);
+
+    starpu_codelet_unpack_args( cl_arg, &args );
+
+    CORE_dtstrf( args.m, args.n, args.ib, U, args.ldu, A, args.lda,
+                 L, args.ldl, IPIV );
+}
+
+/**
+ * @brief Define the StarPU codelet structure
+ */
+struct starpu_codelet cl_dtstrf = {
+    .where      = STARPU_CPU,
+    .cpu_func   = cl_dtstrf_cpu_func,
+    .cuda_flags = { 0 },
+    .cuda_func  = NULL,
+    .nbuffers   = 4,
+    .name       = "tstrf"
+};
+
+/**
+ * @brief Insert task funtion
+ */
+void
+insert_dtstrf( int                  m,
+               int                  n,
+               int                  ib,
+               starpu_data_handle_t U,
+               int                  ldu,
+               starpu_data_handle_t A,
+               int                  lda,
+               starpu_data_handle_t L,
+               int                  ldl,
+               starpu_data_handle_t IPIV )
+{
+    cl_dtstrf_arg_t args = {
+        .m       = m,
+        .n       = n,
+        .ib      = ib,
+        .ldu     = ldu,
+        .lda     = lda,
+        .ldl     = ldl,
+    };
+
+    starpu_insert_task(
+        starpu_mpi_codelet(&cl_dtstrf),
+        STARPU_VALUE, &args, sizeof(cl_dtstrf_arg_t),
+        STARPU_RW,    U,
+        STARPU_RW,    A,
+        STARPU_W,     L,
+        STARPU_W,     IPIV,
+        0);
+}
@@ -0,0 +1,28 @@
+#include "algonum.h"
+
+/**
+ * @brief Apply the row interchanges and the unit lower triangular factor
+ * computed by CORE_dgetrf_incpiv on the diagonal tile to a tile of the same
+ * row: A = L^{-1} P A.
+ */
+void
+CORE_dgessm( int m, int n, int k, const int *IPIV,
+             const double *L, int ldl, double *A, int lda )
+{
+    if ( (m == 0) || (n == 0) || (k == 0) ) {
+        return;
+    }
+
+    LAPACKE_dlaswp_work( LAPACK_COL_MAJOR, n, A, lda, 1, k, IPIV, 1 );
+
+    cblas_dtrsm( CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit,
+                 k, n, 1., L, ldl, A, lda );
+
+    /* Rows below the diagonal block of a tall tile */
+    if ( m > k ) {
+        cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, m - k, n, k,
+                     -1., L + k, ldl,
+                          A,     lda,
+                      1., A + k, lda );
+    }
+}
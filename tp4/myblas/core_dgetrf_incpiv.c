@@ -0,0 +1,16 @@
+#include "algonum.h"
+
+/**
+ * @brief LU factorization with partial pivoting of the diagonal tile.
+ *
+ * The pivots are local to the tile and are later applied to the tiles of the
+ * same row by CORE_dgessm.
+ */
+int
+CORE_dgetrf_incpiv( int m, int n, double *A, int lda, int *IPIV )
+{
+    if ( (m == 0) || (n == 0) ) {
+        return 0;
+    }
+    return LAPACKE_dgetrf_work( LAPACK_COL_MAJOR, m, n, A, lda, IPIV );
+}
@@ -0,0 +1,44 @@
+#include "algonum.h"
+
+/**
+ * @brief Apply the transformations computed by CORE_dtstrf to two tiles of
+ * the same column: A1 belongs to the row of the diagonal tile (only its k
+ * first rows are modified) and A2 to the row that has been coupled to it.
+ *
+ * L1 is the ib-by-k workspace and L2 the m2-by-k multipliers returned by
+ * CORE_dtstrf, IPIV its pivots.
+ */
+void
+CORE_dssssm( int n, int m2, int k, int ib,
+             double *A1, int lda1, double *A2, int lda2,
+             const double *L1, int ldl1, const double *L2, int ldl2,
+             const int *IPIV )
+{
+    int ii, sb, j;
+
+    if ( (n == 0) || (m2 == 0) || (k == 0) ) {
+        return;
+    }
+
+    for( ii=0; ii<k; ii+=ib ) {
+        sb = my_imin( k - ii, ib );
+
+        for( j=0; j<sb; j++ ) {
+            int p = IPIV[ii+j] - 1;
+            if ( p >= k ) {
+                cblas_dswap( n, A1 + ii + j, lda1, A2 + (p-k), lda2 );
+            }
+            else if ( p != ii+j ) {
+                cblas_dswap( n, A1 + ii + j, lda1, A1 + p, lda1 );
+            }
+        }
+
+        cblas_dtrsm( CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit,
+                     sb, n, 1., L1 + ldl1 * ii, ldl1, A1 + ii, lda1 );
+
+        cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, m2, n, sb,
+                     -1., L2 + ldl2 * ii, ldl2,
+                          A1 + ii,        lda1,
+                      1., A2,             lda2 );
+    }
+}
@@ -0,0 +1,114 @@
+#include "algonum.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief LU factorization with partial pivoting of the stacked matrix [ U; A ]
+ * where U is the n-by-n upper triangular factor of the diagonal tile and A an
+ * m-by-n tile below it.
+ *
+ * The pivot of each column is searched among both the diagonal of U and the
+ * rows of A, so the factorization is stable without a pivot search on the
+ * whole panel. The columns are processed by blocks of ib: each block is
+ * factorized in a (ib+m)-by-ib workspace, its unit lower triangular top part
+ * is saved in L (ldl >= ib) because the strict lower part of the diagonal
+ * tile already holds the factor of CORE_dgetrf_incpiv, and the rest of the
+ * columns are updated as CORE_dssssm would do.
+ *
+ * On exit, U holds the updated upper triangular factor, A the multipliers and
+ * IPIV the pivots as described in algonum.h.
+ *
+ * @return 0 on success, i > 0 if the i-th pivot is exactly zero.
+ */
+int
+CORE_dtstrf( int m, int n, int ib,
+             double *U, int ldu, double *A, int lda,
+             double *L, int ldl, int *IPIV )
+{
+    double *W;
+    int    *wpiv;
+    int     ii, sb, i, j, ldw, info = 0;
+
+    if ( (m == 0) || (n == 0) ) {
+        return 0;
+    }
+
+    ldw  = ib + m;
+    W    = malloc( ldw * ib * sizeof(double) );
+    wpiv = malloc( ib * sizeof(int) );
+
+    for( ii=0; ii<n; ii+=ib ) {
+        sb = my_imin( n - ii, ib );
+
+        /* Stack the upper triangular block of U on top of the block of A */
+        for( j=0; j<sb; j++ ) {
+            double *w = W + ldw * j;
+            for( i=0; i<=j; i++ ) {
+                w[i] = U[ ldu * (ii+j) + ii+i ];
+            }
+            for( ; i<sb; i++ ) {
+                w[i] = 0.;
+            }
+            memcpy( w + sb, A + lda * (ii+j), m * sizeof(double) );
+        }
+
+        {
+            int rc = LAPACKE_dgetrf_work( LAPACK_COL_MAJOR, sb + m, sb, W, ldw, wpiv );
+            if ( (rc > 0) && (info == 0) ) {
+                info = ii + rc;
+            }
+        }
+
+        /* Scatter the factors back */
+        for( j=0; j<sb; j++ ) {
+            const double *w = W + ldw * j;
+            for( i=0; i<=j; i++ ) {
+                U[ ldu * (ii+j) + ii+i ] = w[i];
+            }
+            for( i=0; i<j; i++ ) {
+                L[ ldl * (ii+j) + i ] = 0.;
+            }
+            L[ ldl * (ii+j) + j ] = 1.;
+            for( i=j+1; i<sb; i++ ) {
+                L[ ldl * (ii+j) + i ] = w[i];
+            }
+            memcpy( A + lda * (ii+j), w + sb, m * sizeof(double) );
+        }
+
+        /* Convert the workspace pivots to the [ U; A ] numbering */
+        for( j=0; j<sb; j++ ) {
+            int p = wpiv[j];
+            IPIV[ii+j] = ( p <= sb ) ? ii + p : n + p - sb;
+        }
+
+        /* Update the trailing columns of both tiles */
+        if ( ii + sb < n ) {
+            int nn = n - ii - sb;
+            double *U1 = U + ldu * (ii+sb) + ii;
+            double *A2 = A + lda * (ii+sb);
+
+            for( j=0; j<sb; j++ ) {
+                int p = IPIV[ii+j] - 1;
+                if ( p >= n ) {
+                    cblas_dswap( nn, U1 + j, ldu, A2 + (p-n), lda );
+                }
+                else if ( p != ii+j ) {
+                    cblas_dswap( nn, U1 + j, ldu, U1 + (p-ii), ldu );
+                }
+            }
+
+            cblas_dtrsm( CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit,
+                         sb, nn, 1., L + ldl * ii, ldl, U1, ldu );
+
+            cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, m, nn, sb,
+                         -1., A + lda * ii, lda,
+                              U1,           ldu,
+                          1., A2,           lda );
+        }
+    }
+
+    free( W );
+    free( wpiv );
+
+    return info;
+}
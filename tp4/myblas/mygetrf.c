@@ -1,4 +1,5 @@
 #include "algonum.h"
+#include <stdlib.h>
 
 void
 my_dgetrf_seq( CBLAS_LAYOUT layout, int M, int N, double *A, int lda )
@@ -66,5 +67,161 @@ void my_dgetrf_tiled_openmp( CBLAS_LAYOUT layout,
     }
 }
 
+void
+incpivAlloc( int M, int N, int b, int ib, double ***L, int ***IPIV )
+{
+    int MT = my_iceil( M, b );
+    int NT = my_iceil( N, b );
+    int t;
+
+    *L    = malloc( MT * NT * sizeof(double*) );
+    *IPIV = malloc( MT * NT * sizeof(int*) );
+
+    for( t=0; t<MT*NT; t++ ) {
+        (*L)[t]    = malloc( ib * b * sizeof(double) );
+        (*IPIV)[t] = malloc( b * sizeof(int) );
+    }
+}
+
+void
+incpivFree( int M, int N, int b, double **L, int **IPIV )
+{
+    int MT = my_iceil( M, b );
+    int NT = my_iceil( N, b );
+    int t;
+
+    for( t=0; t<MT*NT; t++ ) {
+        free( L[t] );
+        free( IPIV[t] );
+    }
+    free( L );
+    free( IPIV );
+}
+
+/**
+ * Tiled LU factorization with incremental pivoting: the pivot search never
+ * spans more than two tiles, so no task has to wait for a whole panel.
+ *
+ * The dependencies on the diagonal tile are split in two: the tile pointer
+ * protects its upper part (modified by each dtstrf of the column) and the
+ * IPIV pointer its lower part (read by the dgessm of the row), so that both
+ * kinds of tasks can run concurrently.
+ */
+void
+my_dgetrf_incpiv_tiled_openmp( CBLAS_LAYOUT layout,
+                               int M, int N, int b, int ib,
+                               double **A, double **L, int **IPIV )
+{
+    int MT = my_iceil( M, b );
+    int NT = my_iceil( N, b );
+    int KT = my_imin( MT, NT );
+    int m, n, k;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        for( k=0; k<KT; k++) {
+            int mk = k == (MT-1) ? M - k * b : b;
+            int nk = k == (NT-1) ? N - k * b : b;
+
+#pragma omp task firstprivate( k, mk, nk ) depend( inout: A[ MT * k + k ] ) depend( out: IPIV[ MT * k + k ] )
+            CORE_dgetrf_incpiv( mk, nk, A[ MT * k + k ], b, IPIV[ MT * k + k ] );
+
+            for( n=k+1; n<NT; n++) {
+                int nn = n == (NT-1) ? N - n * b : b;
+
+#pragma omp task firstprivate( k, n, mk, nk, nn ) depend( in: IPIV[ MT * k + k ] ) depend( inout: A[ MT * n + k ] )
+                CORE_dgessm( mk, nn, my_imin( mk, nk ), IPIV[ MT * k + k ],
+                             A[ MT * k + k ], b, A[ MT * n + k ], b );
+            }
+
+            for( m=k+1; m<MT; m++) {
+                int mm = m == (MT-1) ? M - m * b : b;
+
+#pragma omp task firstprivate( k, m, mm, nk ) depend( inout: A[ MT * k + k ], A[ MT * k + m ] ) depend( out: L[ MT * k + m ], IPIV[ MT * k + m ] )
+                CORE_dtstrf( mm, nk, ib, A[ MT * k + k ], b, A[ MT * k + m ], b,
+                             L[ MT * k + m ], ib, IPIV[ MT * k + m ] );
+
+                for( n=k+1; n<NT; n++) {
+                    int nn = n == (NT-1) ? N - n * b : b;
+
+#pragma omp task firstprivate( k, m, n, mm, nk, nn ) depend( inout: A[ MT * n + k ], A[ MT * n + m ] ) depend( in: A[ MT * k + m ], L[ MT * k + m ], IPIV[ MT * k + m ] )
+                    CORE_dssssm( nn, mm, nk, ib,
+                                 A[ MT * n + k ], b, A[ MT * n + m ], b,
+                                 L[ MT * k + m ], ib, A[ MT * k + m ], b,
+                                 IPIV[ MT * k + m ] );
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Solve A X = B with the factors of my_dgetrf_incpiv_tiled_openmp. X is a
+ * tiled N-by-NRHS matrix holding B on entry.
+ */
+void
+my_dgetrs_incpiv_tiled_openmp( CBLAS_LAYOUT layout,
+                               int N, int NRHS, int b, int ib,
+                               const double **A, const double **L, const int **IPIV,
+                               double **X )
+{
+    int NT = my_iceil( N, b );
+    int RT = my_iceil( NRHS, b );
+    int m, r, k;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        /* Forward substitution, replaying the factorization on X */
+        for( k=0; k<NT; k++) {
+            int kk = k == (NT-1) ? N - k * b : b;
+
+            for( r=0; r<RT; r++) {
+                int rr = r == (RT-1) ? NRHS - r * b : b;
+
+#pragma omp task firstprivate( k, r, kk, rr ) depend( inout: X[ NT * r + k ] )
+                CORE_dgessm( kk, rr, kk, IPIV[ NT * k + k ],
+                             A[ NT * k + k ], b, X[ NT * r + k ], b );
+            }
+
+            for( m=k+1; m<NT; m++) {
+                int mm = m == (NT-1) ? N - m * b : b;
+
+                for( r=0; r<RT; r++) {
+                    int rr = r == (RT-1) ? NRHS - r * b : b;
+
+#pragma omp task firstprivate( k, m, r, kk, mm, rr ) depend( inout: X[ NT * r + k ], X[ NT * r + m ] )
+                    CORE_dssssm( rr, mm, kk, ib,
+                                 X[ NT * r + k ], b, X[ NT * r + m ], b,
+                                 L[ NT * k + m ], ib, A[ NT * k + m ], b,
+                                 IPIV[ NT * k + m ] );
+                }
+            }
+        }
+
+        /* Backward substitution with the upper triangular tiles */
+        for( k=NT-1; k>=0; k--) {
+            int kk = k == (NT-1) ? N - k * b : b;
+
+            for( r=0; r<RT; r++) {
+                int rr = r == (RT-1) ? NRHS - r * b : b;
+
+#pragma omp task firstprivate( k, r, kk, rr ) depend( inout: X[ NT * r + k ] )
+                cblas_dtrsm( CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit,
+                             kk, rr, 1., A[ NT * k + k ], b, X[ NT * r + k ], b );
+
+                for( m=0; m<k; m++) {
+#pragma omp task firstprivate( k, m, r, kk, rr ) depend( in: X[ NT * r + k ] ) depend( inout: X[ NT * r + m ] )
+                    cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, b, rr, kk,
+                                 -1., A[ NT * k + m ], b,
+                                      X[ NT * r + k ], b,
+                                  1., X[ NT * r + m ], b );
+                }
+            }
+        }
+    }
+}
+
 /* To make sure we use the right prototype */
 static dgetrf_fct_t valig_mygetrf __attribute__ ((unused)) = my_dgetrf_seq;
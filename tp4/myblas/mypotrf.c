@@ -0,0 +1,131 @@
+#include "algonum.h"
+#include <stdlib.h>
+
+/**
+ * Tiled Cholesky factorization A = L L^t of a symmetric positive definite
+ * matrix. Only the lower tiles are referenced, and overwritten by L.
+ *
+ * Each tile kernel is an OpenMP task, the dependencies on the tile pointers
+ * build the DAG: the syrk/gemm updates of step k can run while the panel of
+ * step k+1 is factorized.
+ *
+ * Returns 0, or i+1 when the leading minor of order i+1 is not positive
+ * definite, as LAPACK's dpotrf does.
+ */
+int
+my_dpotrf_tiled_openmp( CBLAS_LAYOUT layout,
+                        int N, int b, double **A )
+{
+    int NT = my_iceil( N, b );
+    int m, n, k;
+    int info = 0;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        for( k=0; k<NT; k++) {
+            int kk = k == (NT-1) ? N - k * b : b;
+
+#pragma omp task firstprivate( k, kk ) shared( info ) depend( inout: A[ NT * k + k ] )
+            {
+                int rc = LAPACKE_dpotrf_work( LAPACK_COL_MAJOR, 'L', kk, A[ NT * k + k ], b );
+
+                /* The diagonal tasks run in order, the first failure is kept */
+                if ( rc != 0 ) {
+#pragma omp critical
+                    if ( info == 0 ) {
+                        info = ( rc > 0 ) ? k * b + rc : rc;
+                    }
+                }
+            }
+
+            for( m=k+1; m<NT; m++) {
+                int mm = m == (NT-1) ? N - m * b : b;
+
+#pragma omp task firstprivate( k, m, kk, mm ) depend( in: A[ NT * k + k ] ) depend( inout: A[ NT * k + m ] )
+                cblas_dtrsm( CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                             mm, kk, 1., A[ NT * k + k ], b, A[ NT * k + m ], b );
+            }
+
+            for( m=k+1; m<NT; m++) {
+                int mm = m == (NT-1) ? N - m * b : b;
+
+#pragma omp task firstprivate( k, m, kk, mm ) depend( in: A[ NT * k + m ] ) depend( inout: A[ NT * m + m ] )
+                cblas_dsyrk( CblasColMajor, CblasLower, CblasNoTrans,
+                             mm, kk, -1., A[ NT * k + m ], b, 1., A[ NT * m + m ], b );
+
+                for( n=k+1; n<m; n++) {
+#pragma omp task firstprivate( k, m, n, kk, mm ) depend( in: A[ NT * k + m ], A[ NT * k + n ] ) depend( inout: A[ NT * n + m ] )
+                    cblas_dgemm( CblasColMajor, CblasNoTrans, CblasTrans, mm, b, kk,
+                                 -1., A[ NT * k + m ], b,
+                                      A[ NT * k + n ], b,
+                                  1., A[ NT * n + m ], b );
+                }
+            }
+        }
+    }
+
+    return info;
+}
+
+/**
+ * Solve A X = B with the factor of my_dpotrf_tiled_openmp. X is a tiled
+ * N-by-NRHS matrix holding B on entry.
+ */
+void
+my_dpotrs_tiled_openmp( CBLAS_LAYOUT layout,
+                        int N, int NRHS, int b,
+                        const double **A, double **X )
+{
+    int NT = my_iceil( N, b );
+    int RT = my_iceil( NRHS, b );
+    int m, r, k;
+
+#pragma omp parallel
+#pragma omp single
+    {
+        /* Forward substitution L Y = B */
+        for( k=0; k<NT; k++) {
+            int kk = k == (NT-1) ? N - k * b : b;
+
+            for( r=0; r<RT; r++) {
+                int rr = r == (RT-1) ? NRHS - r * b : b;
+
+#pragma omp task firstprivate( k, r, kk, rr ) depend( inout: X[ NT * r + k ] )
+                cblas_dtrsm( CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit,
+                             kk, rr, 1., A[ NT * k + k ], b, X[ NT * r + k ], b );
+
+                for( m=k+1; m<NT; m++) {
+                    int mm = m == (NT-1) ? N - m * b : b;
+
+#pragma omp task firstprivate( k, m, r, kk, mm, rr ) depend( in: X[ NT * r + k ] ) depend( inout: X[ NT * r + m ] )
+                    cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, mm, rr, kk,
+                                 -1., A[ NT * k + m ], b,
+                                      X[ NT * r + k ], b,
+                                  1., X[ NT * r + m ], b );
+                }
+            }
+        }
+
+        /* Backward substitution L^t X = Y */
+        for( k=NT-1; k>=0; k--) {
+            int kk = k == (NT-1) ? N - k * b : b;
+
+            for( r=0; r<RT; r++) {
+                int rr = r == (RT-1) ? NRHS - r * b : b;
+
+#pragma omp task firstprivate( k, r, kk, rr ) depend( inout: X[ NT * r + k ] )
+                cblas_dtrsm( CblasColMajor, CblasLeft, CblasLower, CblasTrans, CblasNonUnit,
+                             kk, rr, 1., A[ NT * k + k ], b, X[ NT * r + k ], b );
+
+                for( m=0; m<k; m++) {
+#pragma omp task firstprivate( k, m, r, kk, rr ) depend( in: X[ NT * r + k ] ) depend( inout: X[ NT * r + m ] )
+                    cblas_dgemm( CblasColMajor, CblasTrans, CblasNoTrans, b, rr, kk,
+                                 -1., A[ NT * m + k ], b,
+                                      X[ NT * r + k ], b,
+                                  1., X[ NT * r + m ], b );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include "algonum.h"
+#include "codelets.h"
+
+/**
+ * Register the ib-by-b L workspace of the tile (m, n)
+ */
+static starpu_data_handle_t
+get_starpu_handle_l( int id, starpu_data_handle_t *handles, double **L,
+                     int m, int n, int ib, int b, int MT )
+{
+    starpu_data_handle_t *tile_handle = handles + n * MT + m;
+
+    if ( *tile_handle == NULL ) {
+        starpu_matrix_data_register( tile_handle, STARPU_MAIN_RAM, (uintptr_t) L[ MT * n + m ],
+                                     ib, ib, b, sizeof( double ) );
+        starpu_data_set_coordinates( *tile_handle, 2, m, n );
+#if defined(ENABLE_MPI)
+        {
+            int64_t tag = ((int64_t)id << 32) | ( n * MT + m );
+            starpu_mpi_data_register( *tile_handle, tag, get_starpu_owner( m, n ) );
+        }
+#endif
+    }
+    return *tile_handle;
+}
+
+/**
+ * Register the b pivots of the tile (m, n)
+ */
+static starpu_data_handle_t
+get_starpu_handle_ipiv( int id, starpu_data_handle_t *handles, int **IPIV,
+                        int m, int n, int b, int MT )
+{
+    starpu_data_handle_t *tile_handle = handles + n * MT + m;
+
+    if ( *tile_handle == NULL ) {
+        starpu_vector_data_register( tile_handle, STARPU_MAIN_RAM, (uintptr_t) IPIV[ MT * n + m ],
+                                     b, sizeof( int ) );
+        starpu_data_set_coordinates( *tile_handle, 2, m, n );
+#if defined(ENABLE_MPI)
+        {
+            int64_t tag = ((int64_t)id << 32) | ( n * MT + m );
+            starpu_mpi_data_register( *tile_handle, tag, get_starpu_owner( m, n ) );
+        }
+#endif
+    }
+    return *tile_handle;
+}
+
+void
+my_dgetrf_incpiv_tiled_starpu( CBLAS_LAYOUT layout,
+                               int M, int N, int b, int ib,
+                               double **A, double **L, int **IPIV )
+{
+    starpu_data_handle_t *handlesA;
+    starpu_data_handle_t *handlesL;
+    starpu_data_handle_t *handlesP;
+    starpu_data_handle_t hAkk, hAkn, hAmk, hAmn, hLmk, hPkk, hPmk;
+
+    /* Let's compute the total number of tiles with a *ceil* */
+    int MT = my_iceil( M, b );
+    int NT = my_iceil( N, b );
+    int KT = my_imin( MT, NT );
+    int m, n, k;
+
+    handlesA = calloc( MT * NT, sizeof(starpu_data_handle_t) );
+    handlesL = calloc( MT * NT, sizeof(starpu_data_handle_t) );
+    handlesP = calloc( MT * NT, sizeof(starpu_data_handle_t) );
+
+    for( k=0; k<KT; k++) {
+        int mk = k == (MT-1) ? M - k * b : b;
+        int nk = k == (NT-1) ? N - k * b : b;
+
+        hAkk = get_starpu_handle( 0, handlesA, A, k, k, b, MT );
+        hPkk = get_starpu_handle_ipiv( 2, handlesP, IPIV, k, k, b, MT );
+
+        insert_dgetrf_incpiv( mk, nk, hAkk, b, hPkk );
+
+        for( n=k+1; n<NT; n++) {
+            int nn = n == (NT-1) ? N - n * b : b;
+
+            hAkn = get_starpu_handle( 0, handlesA, A, k, n, b, MT );
+            insert_dgessm( mk, nn, my_imin( mk, nk ), hPkk, hAkk, b, hAkn, b );
+        }
+
+        for( m=k+1; m<MT; m++) {
+            int mm = m == (MT-1) ? M - m * b : b;
+
+            hAmk = get_starpu_handle( 0, handlesA, A, m, k, b, MT );
+            hLmk = get_starpu_handle_l( 1, handlesL, L, m, k, ib, b, MT );
+            hPmk = get_starpu_handle_ipiv( 2, handlesP, IPIV, m, k, b, MT );
+
+            insert_dtstrf( mm, nk, ib, hAkk, b, hAmk, b, hLmk, ib, hPmk );
+
+            for( n=k+1; n<NT; n++) {
+                int nn = n == (NT-1) ? N - n * b : b;
+
+                hAkn = get_starpu_handle( 0, handlesA, A, k, n, b, MT );
+                hAmn = get_starpu_handle( 0, handlesA, A, m, n, b, MT );
+
+                insert_dssssm( nn, mm, nk, ib, hAkn, b, hAmn, b,
+                               hLmk, ib, hAmk, b, hPmk );
+            }
+        }
+    }
+
+    unregister_starpu_handle( MT * NT, handlesA );
+    unregister_starpu_handle( MT * NT, handlesL );
+    unregister_starpu_handle( MT * NT, handlesP );
+
+    /* Let's wait for the end of all the tasks */
+    starpu_task_wait_for_all();
+#if defined(ENABLE_MPI)
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+#endif
+
+    free( handlesA );
+    free( handlesL );
+    free( handlesP );
+}
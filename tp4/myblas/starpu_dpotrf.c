@@ -0,0 +1,60 @@
+#include "algonum.h"
+#include "codelets.h"
+
+int
+my_dpotrf_tiled_starpu( CBLAS_LAYOUT layout,
+                        int N, int b, double **A )
+{
+    starpu_data_handle_t *handlesA;
+    starpu_data_handle_t hAkk, hAmk, hAnk, hAmm, hAmn;
+
+    /* Let's compute the total number of tiles with a *ceil* */
+    int NT = my_iceil( N, b );
+    int m, n, k;
+
+    handlesA = calloc( NT * NT, sizeof(starpu_data_handle_t) );
+
+    for( k=0; k<NT; k++) {
+        int kk = k == (NT-1) ? N - k * b : b;
+
+        hAkk = get_starpu_handle( 0, handlesA, A, k, k, b, NT );
+        insert_dpotrf( kk, hAkk, b );
+
+        for( m=k+1; m<NT; m++) {
+            int mm = m == (NT-1) ? N - m * b : b;
+
+            hAmk = get_starpu_handle( 0, handlesA, A, m, k, b, NT );
+            insert_dtrsm( CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                          mm, kk, 1., hAkk, b, hAmk, b );
+        }
+
+        for( m=k+1; m<NT; m++) {
+            int mm = m == (NT-1) ? N - m * b : b;
+
+            hAmk = get_starpu_handle( 0, handlesA, A, m, k, b, NT );
+            hAmm = get_starpu_handle( 0, handlesA, A, m, m, b, NT );
+            insert_dsyrk( CblasLower, CblasNoTrans, mm, kk,
+                          -1., hAmk, b, 1., hAmm, b );
+
+            for( n=k+1; n<m; n++) {
+                hAnk = get_starpu_handle( 0, handlesA, A, n, k, b, NT );
+                hAmn = get_starpu_handle( 0, handlesA, A, m, n, b, NT );
+                insert_dgemm( CblasNoTrans, CblasTrans, mm, b, kk,
+                              -1., hAmk, b, hAnk, b, 1., hAmn, b );
+            }
+        }
+    }
+
+    unregister_starpu_handle( NT * NT, handlesA );
+
+    /* Let's wait for the end of all the tasks */
+    starpu_task_wait_for_all();
+#if defined(ENABLE_MPI)
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+#endif
+
+    free( handlesA );
+
+    /* The dpotrf codelet asserts that its tile is positive definite */
+    return 0;
+}
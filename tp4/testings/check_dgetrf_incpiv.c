@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <strings.h>
+#include <assert.h>
+#include "algonum.h"
+#if defined(ENABLE_STARPU)
+#include "codelets.h"
+#endif
+
+typedef void (*dgetrf_incpiv_fct_t)( CBLAS_LAYOUT layout,
+                                     int m, int n, int b, int ib,
+                                     double **a, double **l, int **ipiv );
+
+/**
+ * Factorize a general matrix (no diagonal bump, so pivoting is required), and
+ * check the backward error of the solution of A X = B.
+ */
+int
+testone_dgetrf_incpiv( dgetrf_incpiv_fct_t dgetrf, int N, int b, int ib )
+{
+    int      NRHS = 5;
+    int      lda  = ( N > 1 ) ? N : 1;
+    int      seedA = random();
+    int      seedB = random();
+    double  *A, *X, *B;
+    double **Atile, **Xtile, **L;
+    int    **IPIV;
+    double   Anorm, Xnorm, Rnorm, result;
+    double   eps = LAPACKE_dlamch_work('e');
+    int      hres;
+
+    A = malloc( lda * N    * sizeof(double) );
+    X = malloc( lda * NRHS * sizeof(double) );
+    B = malloc( lda * NRHS * sizeof(double) );
+
+    CORE_dplrnt( 0., N, N,    A, lda, N, 0, 0, seedA );
+    CORE_dplrnt( 0., N, NRHS, B, lda, N, 0, 0, seedB );
+
+    Atile = lapack2tile( N, N,    b, A, lda );
+    Xtile = lapack2tile( N, NRHS, b, B, lda );
+    incpivAlloc( N, N, b, ib, &L, &IPIV );
+
+    dgetrf( CblasColMajor, N, N, b, ib, Atile, L, IPIV );
+    my_dgetrs_incpiv_tiled_openmp( CblasColMajor, N, NRHS, b, ib,
+                                   (const double **)Atile, (const double **)L,
+                                   (const int **)IPIV, Xtile );
+
+    tile2lapack( N, NRHS, b, (const double **)Xtile, X, lda );
+
+    Anorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, N,    A, lda, NULL );
+    Xnorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, NRHS, X, lda, NULL );
+
+    /* B = A X - B */
+    cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, N, NRHS, N,
+                 1., A, lda, X, lda, -1., B, lda );
+    Rnorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, NRHS, B, lda, NULL );
+
+    result = Anorm * Xnorm * N * eps;
+    if ( result > 0. ) {
+        result = Rnorm / result;
+    }
+
+    hres = ( isnan(Rnorm) || isinf(Rnorm) || isnan(result) || isinf(result) || (result > 60.0) );
+
+    incpivFree( N, N, b, L, IPIV );
+    tileFree( N, N,    b, Atile );
+    tileFree( N, NRHS, b, Xtile );
+    free( A );
+    free( X );
+    free( B );
+
+    return hres;
+}
+
+int
+testall_dgetrf_incpiv( dgetrf_incpiv_fct_t tested_dgetrf )
+{
+    int all_N[]  = { 0, 5, 8, 17, 57, 64 };
+    int all_b[]  = { 1, 3, 7, 16 };
+    int all_ib[] = { 1, 2, 4 };
+
+    int nb_N  = sizeof( all_N )  / sizeof( int );
+    int nb_b  = sizeof( all_b )  / sizeof( int );
+    int nb_ib = sizeof( all_ib ) / sizeof( int );
+
+    int in, ib, iib;
+    int nbfailed = 0;
+    int nbpassed = 0;
+    int nbtests = nb_N * nb_b * nb_ib;
+
+    for( in = 0; in < nb_N; in ++ ) {
+        for( ib = 0; ib < nb_b; ib ++ ) {
+            for( iib = 0; iib < nb_ib; iib ++ ) {
+                nbfailed += testone_dgetrf_incpiv( tested_dgetrf, all_N[in], all_b[ib],
+                                                   my_imin( all_ib[iib], all_b[ib] ) );
+                nbpassed++;
+                fprintf( stdout, "\r %4d / %4d", nbpassed, nbtests );
+            }
+        }
+    }
+
+    if ( nbfailed > 0 ) {
+        fprintf( stdout, "\n %4d tests failed out of %d\n",
+                 nbfailed, nbtests );
+    }
+    else {
+        fprintf( stdout, "\n Congratulations all %4d tests succeeded\n",
+                 nbtests );
+    }
+    return nbfailed;
+}
+
+#define GETOPT_STRING "hv:"
+static struct option long_options[] =
+{
+    {"help",          no_argument,       0,      'h'},
+    {"v",             required_argument, 0,      'v'},
+    {0, 0, 0, 0}
+};
+
+void
+print_usage()
+{
+    printf( "Options:\n"
+            "  -h --help  Show this help\n"
+            "  -v --v=xxx Select the version to test among: tiled_omp, tiled_starpu\n" );
+    exit(1);
+}
+
+int main( int argc, char **argv )
+{
+    dgetrf_incpiv_fct_t tested_dgetrf = my_dgetrf_incpiv_tiled_openmp;
+    int starpu = 0;
+    int nbfailed;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, GETOPT_STRING, long_options, NULL)) != -1)
+    {
+        switch(opt) {
+        case 'h':
+            print_usage();
+            exit(0);
+
+        case 'v':
+            if ( strcasecmp( optarg, "tiled_omp" ) == 0 ) {
+                printf( "Test tiled OpenMP version\n" );
+                tested_dgetrf = my_dgetrf_incpiv_tiled_openmp;
+            }
+#if defined(ENABLE_STARPU)
+            else if ( strcasecmp( optarg, "tiled_starpu" ) == 0 ) {
+                printf( "Test tiled StarPU version\n" );
+                starpu = 1;
+                tested_dgetrf = my_dgetrf_incpiv_tiled_starpu;
+            }
+#endif
+            else {
+                printf( "Test tiled OpenMP version\n" );
+                tested_dgetrf = my_dgetrf_incpiv_tiled_openmp;
+            }
+            break;
+
+        case '?': /* error from getopt[_long] */
+            exit(1);
+            break;
+
+        default:
+            print_usage();
+            exit(1);
+        }
+    }
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_init();
+    }
+#endif
+
+    nbfailed = testall_dgetrf_incpiv( tested_dgetrf );
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_exit();
+    }
+#endif
+
+    return ( nbfailed > 0 ) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
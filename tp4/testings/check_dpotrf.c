@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <strings.h>
+#include <assert.h>
+#include "algonum.h"
+#if defined(ENABLE_STARPU)
+#include "codelets.h"
+#endif
+
+/**
+ * Generate a symmetric positive definite matrix: the random matrix is made
+ * diagonally dominant by the bump, and its lower part is mirrored.
+ */
+static void
+dplgsy( int N, double *A, int lda, unsigned long long int seed )
+{
+    int i, j;
+
+    CORE_dplrnt( N, N, N, A, lda, N, 0, 0, seed );
+    for( j=0; j<N; j++ ) {
+        for( i=0; i<j; i++ ) {
+            A[ lda * j + i ] = A[ lda * i + j ];
+        }
+    }
+}
+
+/**
+ * Factorize a symmetric positive definite matrix, and check the backward error
+ * of the solution of A X = B.
+ */
+int
+testone_dpotrf( dpotrf_tiled_fct_t dpotrf, int N, int b )
+{
+    int      NRHS = 5;
+    int      lda  = ( N > 1 ) ? N : 1;
+    int      seedA = random();
+    int      seedB = random();
+    double  *A, *X, *B;
+    double **Atile, **Xtile;
+    double   Anorm, Xnorm, Rnorm, result;
+    double   eps = LAPACKE_dlamch_work('e');
+    int      hres, info;
+
+    A = malloc( lda * N    * sizeof(double) );
+    X = malloc( lda * NRHS * sizeof(double) );
+    B = malloc( lda * NRHS * sizeof(double) );
+
+    dplgsy( N, A, lda, seedA );
+    CORE_dplrnt( 0., N, NRHS, B, lda, N, 0, 0, seedB );
+
+    Atile = lapack2tile( N, N,    b, A, lda );
+    Xtile = lapack2tile( N, NRHS, b, B, lda );
+
+    info = dpotrf( CblasColMajor, N, b, Atile );
+    my_dpotrs_tiled_openmp( CblasColMajor, N, NRHS, b,
+                            (const double **)Atile, Xtile );
+
+    tile2lapack( N, NRHS, b, (const double **)Xtile, X, lda );
+
+    Anorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, N,    A, lda, NULL );
+    Xnorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, NRHS, X, lda, NULL );
+
+    /* B = A X - B */
+    cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, N, NRHS, N,
+                 1., A, lda, X, lda, -1., B, lda );
+    Rnorm = LAPACKE_dlange_work( LAPACK_COL_MAJOR, 'I', N, NRHS, B, lda, NULL );
+
+    result = Anorm * Xnorm * N * eps;
+    if ( result > 0. ) {
+        result = Rnorm / result;
+    }
+
+    hres = ( (info != 0) || isnan(Rnorm) || isinf(Rnorm) || isnan(result) || isinf(result) || (result > 60.0) );
+
+    tileFree( N, N,    b, Atile );
+    tileFree( N, NRHS, b, Xtile );
+    free( A );
+    free( X );
+    free( B );
+
+    return hres;
+}
+
+int
+testall_dpotrf( dpotrf_tiled_fct_t tested_dpotrf )
+{
+    int all_N[] = { 0, 5, 8, 17, 57, 64 };
+    int all_b[] = { 1, 3, 7, 16 };
+
+    int nb_N = sizeof( all_N ) / sizeof( int );
+    int nb_b = sizeof( all_b ) / sizeof( int );
+
+    int in, ib;
+    int nbfailed = 0;
+    int nbpassed = 0;
+    int nbtests = nb_N * nb_b;
+
+    for( in = 0; in < nb_N; in ++ ) {
+        for( ib = 0; ib < nb_b; ib ++ ) {
+            nbfailed += testone_dpotrf( tested_dpotrf, all_N[in], all_b[ib] );
+            nbpassed++;
+            fprintf( stdout, "\r %4d / %4d", nbpassed, nbtests );
+        }
+    }
+
+    if ( nbfailed > 0 ) {
+        fprintf( stdout, "\n %4d tests failed out of %d\n",
+                 nbfailed, nbtests );
+    }
+    else {
+        fprintf( stdout, "\n Congratulations all %4d tests succeeded\n",
+                 nbtests );
+    }
+    return nbfailed;
+}
+
+#define GETOPT_STRING "hv:"
+static struct option long_options[] =
+{
+    {"help",          no_argument,       0,      'h'},
+    {"v",             required_argument, 0,      'v'},
+    {0, 0, 0, 0}
+};
+
+void
+print_usage()
+{
+    printf( "Options:\n"
+            "  -h --help  Show this help\n"
+            "  -v --v=xxx Select the version to test among: tiled_omp, tiled_starpu\n" );
+    exit(1);
+}
+
+int main( int argc, char **argv )
+{
+    dpotrf_tiled_fct_t tested_dpotrf = my_dpotrf_tiled_openmp;
+    int starpu = 0;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, GETOPT_STRING, long_options, NULL)) != -1)
+    {
+        switch(opt) {
+        case 'h':
+            print_usage();
+            exit(0);
+
+        case 'v':
+            if ( strcasecmp( optarg, "tiled_omp" ) == 0 ) {
+                printf( "Test tiled OpenMP version\n" );
+                tested_dpotrf = my_dpotrf_tiled_openmp;
+            }
+#if defined(ENABLE_STARPU)
+            else if ( strcasecmp( optarg, "tiled_starpu" ) == 0 ) {
+                printf( "Test tiled StarPU version\n" );
+                starpu = 1;
+                tested_dpotrf = my_dpotrf_tiled_starpu;
+            }
+#endif
+            else {
+                printf( "Test tiled OpenMP version\n" );
+                tested_dpotrf = my_dpotrf_tiled_openmp;
+            }
+            break;
+
+        case '?': /* error from getopt[_long] */
+            exit(1);
+            break;
+
+        default:
+            print_usage();
+            exit(1);
+        }
+    }
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_init();
+    }
+#endif
+
+    testall_dpotrf( tested_dpotrf );
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_exit();
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <strings.h>
+#include <assert.h>
+#include "algonum.h"
+#if defined(ENABLE_STARPU)
+#include "codelets.h"
+#endif
+
+int dpotrf_mkl( CBLAS_LAYOUT layout,
+                int n, int b, double **a )
+{
+    /* The tiles are only a storage here, MKL works on the lapack layout */
+    int     lda = ( n > 1 ) ? n : 1;
+    double *A   = malloc( lda * n * sizeof(double) );
+    int     rc;
+
+    tile2lapack( n, n, b, (const double **)a, A, lda );
+    rc = LAPACKE_dpotrf_work( LAPACK_COL_MAJOR, 'L', n, A, lda );
+    free( A );
+    return rc;
+}
+
+#define GETOPT_STRING "hv:N:R:b:"
+static struct option long_options[] =
+{
+    {"help",          no_argument,       0,      'h'},
+    {"v",             required_argument, 0,      'v'},
+    // Matrix parameters
+    {"N",             required_argument, 0,      'N'},
+    {"nrhs",          required_argument, 0,      'R'},
+    {"nb",            required_argument, 0,      'b'},
+    {0, 0, 0, 0}
+};
+
+void
+print_usage()
+{
+    printf( "Options:\n"
+            "  -h --help  Show this help\n"
+            "  -v --v=xxx Select the version to test among: tiled_omp, tiled_starpu, mkl\n"
+            "  -N x       Set the N value\n"
+            "  -R x       Set the number of right-hand sides of the solve\n"
+            "  -b x       Set the block size b value\n" );
+    exit(1);
+}
+
+int main( int argc, char **argv )
+{
+    dpotrf_tiled_fct_t tested_dpotrf = my_dpotrf_tiled_openmp;
+    int N = 1000;
+    int NRHS = 10;
+    int b = 320;
+    int starpu = 0;
+    int opt;
+    int lda, i, j;
+    double *A;
+    double **Atile, **Xtile;
+    perf_t start, stop;
+
+    while ((opt = getopt_long(argc, argv, GETOPT_STRING, long_options, NULL)) != -1)
+    {
+        switch(opt) {
+        case 'h':
+            print_usage();
+            exit(0);
+
+        case 'v':
+            if ( strcasecmp( optarg, "mkl" ) == 0 ) {
+                printf( "Test MKL version\n" );
+                tested_dpotrf = dpotrf_mkl;
+            }
+#if defined(ENABLE_STARPU)
+            else if ( strcasecmp( optarg, "tiled_starpu" ) == 0 ) {
+                printf( "Test tiled StarPU version\n" );
+                starpu = 1;
+                tested_dpotrf = my_dpotrf_tiled_starpu;
+            }
+#endif
+            else {
+                printf( "Test tiled OpenMP version\n" );
+                tested_dpotrf = my_dpotrf_tiled_openmp;
+            }
+            break;
+
+        case 'N':
+            N = atoi( optarg );
+            break;
+        case 'R':
+            NRHS = atoi( optarg );
+            break;
+        case 'b':
+            b = atoi( optarg );
+            break;
+
+        case '?': /* error from getopt[_long] */
+            exit(1);
+            break;
+
+        default:
+            print_usage();
+            exit(1);
+        }
+    }
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_init();
+    }
+#endif
+
+    /* Symmetric positive definite matrix */
+    lda = ( N > 1 ) ? N : 1;
+    A = malloc( lda * N * sizeof(double) );
+    CORE_dplrnt( N, N, N, A, lda, N, 0, 0, random() );
+    for( j=0; j<N; j++ ) {
+        for( i=0; i<j; i++ ) {
+            A[ lda * j + i ] = A[ lda * i + j ];
+        }
+    }
+    Atile = lapack2tile( N, N, b, A, lda );
+
+    perf( &start );
+    tested_dpotrf( CblasColMajor, N, b, Atile );
+    perf( &stop );
+    perf_diff( &start, &stop );
+    printf( "dpotrf N= %4d : %le GFlop/s\n",
+            N, perf_gflops( &stop, flops_dpotrf( N ) ) );
+
+    if ( tested_dpotrf != dpotrf_mkl ) {
+        Xtile = lapack2tile( N, NRHS, b, NULL, lda );
+        dplrnt_tiled( 0., N, NRHS, b, Xtile, random() );
+
+        perf( &start );
+        my_dpotrs_tiled_openmp( CblasColMajor, N, NRHS, b,
+                                (const double **)Atile, Xtile );
+        perf( &stop );
+        perf_diff( &start, &stop );
+        printf( "dpotrs N= %4d NRHS= %4d : %le GFlop/s\n",
+                N, NRHS, perf_gflops( &stop, flops_dpotrs( N, NRHS ) ) );
+
+        tileFree( N, NRHS, b, Xtile );
+    }
+
+    tileFree( N, N, b, Atile );
+    free( A );
+
+#if defined(ENABLE_STARPU)
+    if ( starpu ) {
+        my_starpu_exit();
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}